@@ -29,7 +29,25 @@ SOURCES                 += src/mcwmain.cpp \
                         src/mcwfileserverconnection.cpp \
                         src/mcwfileserverconnectionworker.cpp \
                         src/mcwfileserverconnectionstream.cpp \
-                        src/mcwarchiveengine.cpp
+                        src/mcwarchiveengine.cpp \
+                        src/mcwstatbatch.cpp \
+                        src/mcwlistfilter.cpp \
+                        src/mcwfilelisting.cpp \
+                        src/mcwdirscanner.cpp \
+                        src/mcwsizecache.cpp \
+                        src/mcwtreewalker.cpp \
+                        src/mcwdirsizeworker.cpp \
+                        src/mcwcontentmatcher.cpp \
+                        src/mcwcontentsearch.cpp \
+                        src/mcwindexwatcher.cpp \
+                        src/mcwtrigramindex.cpp \
+                        src/mcwcontentclassifier.cpp \
+                        src/mcwglobmatcher.cpp \
+                        src/mcwnameindex.cpp \
+                        src/mcwfuzzyfinder.cpp \
+                        src/mcwarchivesearch.cpp \
+                        src/mcwtermautomaton.cpp \
+                        src/mcwignorerules.cpp
 
 # Headera
 HEADERS                 += \
@@ -40,7 +58,31 @@ HEADERS                 += \
                         src/mcwfileserverconnection.h \
                         src/mcwfileserverconnectionworker.h \
                         src/mcwfileserverconnectionstream.h \
-                        src/mcwarchiveengine.h
+                        src/mcwarchiveengine.h \
+                        src/mcwstatbatch.h \
+                        src/mcwlistfilter.h \
+                        src/mcwfilelisting.h \
+                        src/mcwdirscanner.h \
+                        src/mcwsizecache.h \
+                        src/mcwtreewalker.h \
+                        src/mcwdirsizeworker.h \
+                        src/mcwcontentmatcher.h \
+                        src/mcwcontentsearch.h \
+                        src/mcwindexwatcher.h \
+                        src/mcwtrigramindex.h \
+                        src/mcwcontentclassifier.h \
+                        src/mcwglobmatcher.h \
+                        src/mcwnameindex.h \
+                        src/mcwfuzzyfinder.h \
+                        src/mcwarchivesearch.h \
+                        src/mcwtermautomaton.h \
+                        src/mcwignorerules.h
+
+# Optional io_uring Stat Backend - qmake CONFIG+=iouring, Needs liburing
+linux:iouring {
+DEFINES                 += MCW_USE_IO_URING
+LIBS                    += -luring
+}
 
 # Other Files
 OTHER_FILES             += \
@@ -0,0 +1,756 @@
+#include <QFile>
+#include <QVector>
+#include <QDebug>
+
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <signal.h>
+#include <spawn.h>
+#include <string.h>
+#include <errno.h>
+
+#include "mcwarchivesearch.h"
+#include "mcwglobmatcher.h"
+#include "mcwcontentmatcher.h"
+#include "mcwcontentclassifier.h"
+#include "mcwinterface.h"
+#include "mcwconstants.h"
+
+extern char** environ;
+
+
+//==============================================================================
+// Has Suffix - Case Insensitive
+//==============================================================================
+static inline bool asHasSuffix(const QString& aFileName, const char* aSuffix)
+{
+    return aFileName.endsWith(QString(".") + QString(aSuffix), Qt::CaseInsensitive);
+}
+
+//==============================================================================
+// Read Fully - Returns false If The Stream Ends Early
+//==============================================================================
+static bool asReadFully(const int& aFd, char* aData, const qint64& aSize)
+{
+    // Init Stream
+    ContentStream stream(aFd, aSize);
+    // Init Position
+    qint64 pos = 0;
+
+    // Read Up To Size
+    while (pos < aSize) {
+        // Read
+        qint64 bytesRead = stream.read(aData + pos, aSize - pos);
+
+        // Check Bytes Read
+        if (bytesRead <= 0) {
+            return false;
+        }
+
+        // Inc Position
+        pos += bytesRead;
+    }
+
+    return true;
+}
+
+//==============================================================================
+// Skip - Seeks Or Reads Thru aSize Bytes
+//==============================================================================
+static inline bool asSkip(const int& aFd, const qint64& aSize)
+{
+    // Init Stream
+    ContentStream stream(aFd, aSize);
+
+    return stream.skipRest();
+}
+
+//==============================================================================
+// Parse Tar Octal Field - Base 256 If The High Bit Is Set
+//==============================================================================
+static qint64 asTarNumber(const char* aField, const int& aLength)
+{
+    // Init Result
+    qint64 result = 0;
+
+    // Check Base 256 - GNU Extension For Large Sizes
+    if ((uchar)aField[0] & 0x80) {
+        // Go Thru Bytes - First Byte Holds The Marker
+        for (int i=1; i<aLength; ++i) {
+            // Shift In Byte
+            result = (result << 8) | (uchar)aField[i];
+        }
+
+        return result;
+    }
+
+    // Go Thru Digits - Leading Spaces Skipped, Ends At Space Or NUL
+    for (int i=0; i<aLength; ++i) {
+        // Check Digit
+        if (aField[i] >= '0' && aField[i] <= '7') {
+            // Add Digit
+            result = (result << 3) + (aField[i] - '0');
+        } else if (aField[i] != ' ' || result > 0) {
+            break;
+        }
+    }
+
+    return result;
+}
+
+//==============================================================================
+// Check Tar Header Checksum - Checksum Field Counted As Spaces
+//==============================================================================
+static bool asTarChecksumValid(const char* aHeader)
+{
+    // Init Sum
+    qint64 sum = 0;
+
+    // Go Thru Header
+    for (int i=0; i<DEFAULT_ARCHIVE_SEARCH_TAR_BLOCK_SIZE; ++i) {
+        // Add Byte
+        sum += (i >= 148 && i < 156) ? ' ' : (uchar)aHeader[i];
+    }
+
+    return sum == asTarNumber(aHeader + 148, 8);
+}
+
+//==============================================================================
+// Get Tar Field - Up To The First NUL
+//==============================================================================
+static inline QByteArray asTarField(const char* aField, const int& aLength)
+{
+    // Get Field End
+    const char* end = (const char*)memchr(aField, '\0', aLength);
+
+    return QByteArray(aField, end ? end - aField : aLength);
+}
+
+//==============================================================================
+// Get Pax Path - Records Are "length key=value\n"
+//==============================================================================
+static QByteArray asPaxPath(const QByteArray& aData)
+{
+    // Init Position
+    int pos = 0;
+
+    // Go Thru Records
+    while (pos < aData.size()) {
+        // Get Space
+        int space = aData.indexOf(' ', pos);
+
+        // Check Space
+        if (space < 0) {
+            break;
+        }
+
+        // Get Record Length
+        int rLength = aData.mid(pos, space - pos).toInt();
+
+        // Check Record Length
+        if (rLength <= space - pos || pos + rLength > aData.size()) {
+            break;
+        }
+
+        // Get Record - Without The Line Break
+        QByteArray record = aData.mid(space + 1, pos + rLength - space - 2);
+
+        // Check Path Key
+        if (record.startsWith("path=")) {
+            return record.mid(5);
+        }
+
+        // Next Record
+        pos += rLength;
+    }
+
+    return QByteArray();
+}
+
+//==============================================================================
+// Normalize Entry Path - No Leading ./ Or Trailing /
+//==============================================================================
+static inline QByteArray asEntryPath(const QByteArray& aPath)
+{
+    // Init Entry Path
+    QByteArray entryPath = aPath;
+
+    // Strip Leading Dot Slashes
+    while (entryPath.startsWith("./")) {
+        entryPath.remove(0, 2);
+    }
+
+    // Strip Trailing Slashes
+    while (entryPath.endsWith('/')) {
+        entryPath.chop(1);
+    }
+
+    return entryPath;
+}
+
+//==============================================================================
+// Escape Zip Entry - unzip Matches Entry Arguments As Wildcards
+//==============================================================================
+static QByteArray asZipEntryArg(const QByteArray& aEntryPath)
+{
+    // Init Result
+    QByteArray result;
+
+    // Go Thru Bytes
+    for (int i=0; i<aEntryPath.size(); ++i) {
+        // Get Byte
+        char c = aEntryPath[i];
+
+        // Check Wildcard Characters
+        if (c == '[' || c == '*' || c == '?') {
+            // Append Bracketed
+            result.append('[').append(c).append(']');
+        } else {
+            // Append Byte
+            result.append(c);
+        }
+    }
+
+    return result;
+}
+
+//==============================================================================
+// Constructor
+//==============================================================================
+ArchiveProcess::ArchiveProcess()
+    : pid(-1)
+    , readFd(-1)
+{
+}
+
+//==============================================================================
+// Start - aArgs[0] Is Looked Up In PATH, Input fd Becomes stdin If Set
+//==============================================================================
+bool ArchiveProcess::start(const QList<QByteArray>& aArgs, const int& aInputFd)
+{
+    // Check Args
+    if (aArgs.isEmpty() || pid > 0) {
+        return false;
+    }
+
+    // Init Pipe fds
+    int pipeFds[2];
+
+    // Create Pipe - Not Inherited By Other Children
+    if (pipe2(pipeFds, O_CLOEXEC) != 0) {
+        return false;
+    }
+
+    // Init File Actions
+    posix_spawn_file_actions_t actions;
+    posix_spawn_file_actions_init(&actions);
+
+    // Check Input fd
+    if (aInputFd >= 0) {
+        // Set stdin
+        posix_spawn_file_actions_adddup2(&actions, aInputFd, STDIN_FILENO);
+    }
+
+    // Set stdout
+    posix_spawn_file_actions_adddup2(&actions, pipeFds[1], STDOUT_FILENO);
+    // Discard stderr
+    posix_spawn_file_actions_addopen(&actions, STDERR_FILENO, "/dev/null", O_WRONLY, 0);
+
+    // Init Argument Vector
+    QVector<char*> argv;
+
+    // Go Thru Args
+    for (int i=0; i<aArgs.count(); ++i) {
+        // Add Arg
+        argv << const_cast<char*>(aArgs[i].constData());
+    }
+
+    // Terminate Argument Vector
+    argv << (char*)NULL;
+
+    // Spawn
+    int result = posix_spawnp(&pid, argv[0], &actions, NULL, argv.data(), environ);
+
+    // Destroy File Actions
+    posix_spawn_file_actions_destroy(&actions);
+    // Close Write End
+    close(pipeFds[1]);
+
+    // Check Result
+    if (result != 0) {
+        qWarning() << "ArchiveProcess::start - app: " << aArgs[0] << " - result: " << result << " - CAN NOT START!";
+
+        // Close Read End
+        close(pipeFds[0]);
+        // Reset pid
+        pid = -1;
+
+        return false;
+    }
+
+    // Set Output fd
+    readFd = pipeFds[0];
+
+    return true;
+}
+
+//==============================================================================
+// Get Output fd
+//==============================================================================
+int ArchiveProcess::outputFd() const
+{
+    return readFd;
+}
+
+//==============================================================================
+// Stop - Kills The Child If aKill, Reaps It, Returns true If It Exited Cleanly
+//==============================================================================
+bool ArchiveProcess::stop(const bool& aKill)
+{
+    // Check Output fd
+    if (readFd >= 0) {
+        // Close Output fd - A Writing Child Gets SIGPIPE
+        close(readFd);
+        // Reset Output fd
+        readFd = -1;
+    }
+
+    // Check pid
+    if (pid <= 0) {
+        return false;
+    }
+
+    // Check Kill
+    if (aKill) {
+        // Kill Child - Nothing Left To Clean Up, Output Goes To The Pipe
+        kill(pid, SIGKILL);
+    }
+
+    // Init Status
+    int status = 0;
+
+    // Reap Child
+    while (waitpid(pid, &status, 0) < 0 && errno == EINTR) {
+    }
+
+    // Reset pid
+    pid = -1;
+
+    return WIFEXITED(status) && WEXITSTATUS(status) == 0;
+}
+
+//==============================================================================
+// Destructor
+//==============================================================================
+ArchiveProcess::~ArchiveProcess()
+{
+    // Stop
+    stop(true);
+}
+
+//==============================================================================
+// Is Supported - By File Name Suffix
+//==============================================================================
+bool ArchiveSearch::isSupported(const QString& aFileName)
+{
+    return asHasSuffix(aFileName, DEFAULT_EXTENSION_ZIP)   ||
+           asHasSuffix(aFileName, DEFAULT_EXTENSION_TAR)   ||
+           asHasSuffix(aFileName, DEFAULT_EXTENSION_TARGZ) ||
+           asHasSuffix(aFileName, DEFAULT_EXTENSION_TGZ)   ||
+           asHasSuffix(aFileName, DEFAULT_EXTENSION_TARBZ) ||
+           asHasSuffix(aFileName, DEFAULT_EXTENSION_TBZ)   ||
+           asHasSuffix(aFileName, DEFAULT_EXTENSION_TARXZ) ||
+           asHasSuffix(aFileName, DEFAULT_EXTENSION_TXZ);
+}
+
+//==============================================================================
+// Constructor - Content Matcher Is NULL For Name Only Searches
+//==============================================================================
+ArchiveSearch::ArchiveSearch(const GlobMatcher& aNameMatcher,
+                             const ContentMatcher* aContentMatcher,
+                             const bool& aAbort,
+                             fileSearchItemFoundCallback aCallback,
+                             void* aContext)
+    : nameMatcher(aNameMatcher)
+    , contentMatcher(aContentMatcher)
+    , abortFlag(aAbort)
+    , callback(aCallback)
+    , context(aContext)
+{
+}
+
+//==============================================================================
+// Get Decompressor - By Magic Bytes, Empty For Files That Are Not gzip, bzip2 Or xz Streams
+//==============================================================================
+QByteArray ArchiveSearch::decompressorFor(const int& aFd)
+{
+    // Init Magic
+    uchar magic[6];
+    // Init Bytes Read
+    ssize_t bytesRead = -1;
+
+    // Read Magic - File Offset Is Left Alone
+    do {
+        bytesRead = pread(aFd, magic, sizeof(magic), 0);
+    } while (bytesRead < 0 && errno == EINTR);
+
+    // Check gzip - 1F 8B
+    if (bytesRead >= 2 && magic[0] == 0x1F && magic[1] == 0x8B) {
+        return DEFAULT_ARCHIVE_SEARCH_APP_GZIP;
+    }
+
+    // Check bzip2 - BZh
+    if (bytesRead >= 3 && memcmp(magic, "BZh", 3) == 0) {
+        return DEFAULT_ARCHIVE_SEARCH_APP_BZIP2;
+    }
+
+    // Check xz - FD 37 7A 58 5A 00
+    if (bytesRead >= 6 && memcmp(magic, "\xFD" "7zXZ\0", 6) == 0) {
+        return DEFAULT_ARCHIVE_SEARCH_APP_XZ;
+    }
+
+    return QByteArray();
+}
+
+//==============================================================================
+// Search - Reports Entries As Archive Path & Archive Path/Entry Path
+//==============================================================================
+void ArchiveSearch::search(const QString& aArchivePath)
+{
+    // Init Stat
+    struct stat archiveStat;
+
+    // Check Regular File - A FIFO Named Like An Archive Would Block The Reader
+    if (stat(QFile::encodeName(aArchivePath).constData(), &archiveStat) != 0 || !S_ISREG(archiveStat.st_mode)) {
+        return;
+    }
+
+    // Check Suffix
+    if (asHasSuffix(aArchivePath, DEFAULT_EXTENSION_ZIP)) {
+        // Search Zip
+        searchZip(aArchivePath);
+
+    } else if (asHasSuffix(aArchivePath, DEFAULT_EXTENSION_TARGZ) || asHasSuffix(aArchivePath, DEFAULT_EXTENSION_TGZ)) {
+        // Search Tar - gzip
+        searchTar(aArchivePath, DEFAULT_ARCHIVE_SEARCH_APP_GZIP);
+
+    } else if (asHasSuffix(aArchivePath, DEFAULT_EXTENSION_TARBZ) || asHasSuffix(aArchivePath, DEFAULT_EXTENSION_TBZ)) {
+        // Search Tar - bzip2
+        searchTar(aArchivePath, DEFAULT_ARCHIVE_SEARCH_APP_BZIP2);
+
+    } else if (asHasSuffix(aArchivePath, DEFAULT_EXTENSION_TARXZ) || asHasSuffix(aArchivePath, DEFAULT_EXTENSION_TXZ)) {
+        // Search Tar - xz
+        searchTar(aArchivePath, DEFAULT_ARCHIVE_SEARCH_APP_XZ);
+
+    } else if (asHasSuffix(aArchivePath, DEFAULT_EXTENSION_TAR)) {
+        // Search Tar - Read Directly
+        searchTar(aArchivePath, QByteArray());
+    }
+}
+
+//==============================================================================
+// Search Zip - Catalog Listed By unzip, Content Piped Per Entry
+//==============================================================================
+void ArchiveSearch::searchZip(const QString& aArchivePath)
+{
+    // Get Local Archive Path
+    QByteArray localPath = QFile::encodeName(aArchivePath);
+
+    // Init Lister
+    ArchiveProcess lister;
+
+    // Start Lister - Entry Names Only, One Per Line
+    if (!lister.start(QList<QByteArray>() << DEFAULT_ARCHIVE_SEARCH_APP_UNZIP << "-Z1" << localPath)) {
+        return;
+    }
+
+    // Init Catalog
+    QByteArray catalog;
+    // Init Buffer
+    QByteArray buffer(DEFAULT_CONTENT_SEARCH_SKIP_BUFFER_SIZE, '\0');
+    // Init Stream
+    ContentStream catalogStream(lister.outputFd());
+
+    // Read Catalog
+    while (!abortFlag) {
+        // Read
+        qint64 bytesRead = catalogStream.read(buffer.data(), buffer.size());
+
+        // Check Bytes Read
+        if (bytesRead <= 0) {
+            break;
+        }
+
+        // Append To Catalog
+        catalog.append(buffer.constData(), bytesRead);
+    }
+
+    // Stop Lister
+    lister.stop(abortFlag);
+
+    // Get Entries
+    QList<QByteArray> entries = catalog.split('\n');
+
+    // Go Thru Entries
+    for (int i=0; i<entries.count() && !abortFlag; ++i) {
+        // Get Is Dir
+        bool isDir = entries[i].endsWith('/');
+        // Get Entry Path
+        QByteArray entryPath = asEntryPath(entries[i]);
+
+        // Check Entry Path & Name
+        if (entryPath.isEmpty() || !matchName(entryPath)) {
+            continue;
+        }
+
+        // Check Content Matcher
+        if (!contentMatcher) {
+            // Report Entry
+            report(aArchivePath, entryPath, NULL);
+
+            continue;
+        }
+
+        // Check Dir
+        if (isDir) {
+            continue;
+        }
+
+        // Init Reader
+        ArchiveProcess reader;
+
+        // Start Reader - Entry Content To stdout
+        if (!reader.start(QList<QByteArray>() << DEFAULT_ARCHIVE_SEARCH_APP_UNZIP << "-p" << localPath << asZipEntryArg(entries[i]))) {
+            break;
+        }
+
+        // Init Entry Stream
+        ContentStream entryStream(reader.outputFd());
+        // Init Hit
+        ContentHit hit;
+
+        // Match Content
+        bool found = matchContent(entryStream, hit);
+
+        // Stop Reader - Killed If The Rest Is Not Needed
+        reader.stop(true);
+
+        // Check Found
+        if (found) {
+            // Report Entry
+            report(aArchivePath, entryPath, &hit);
+        }
+    }
+}
+
+//==============================================================================
+// Search Tar - Headers Parsed From The Stream, Decompressed Thru A Pipe If Needed
+//==============================================================================
+void ArchiveSearch::searchTar(const QString& aArchivePath, const QByteArray& aDecompressor)
+{
+    // Open Archive
+    int archiveFd = open(QFile::encodeName(aArchivePath).constData(), O_RDONLY | O_CLOEXEC);
+
+    // Check Archive fd
+    if (archiveFd < 0) {
+        return;
+    }
+
+    // Init Decompressor
+    ArchiveProcess decompressor;
+    // Init Tar fd
+    int fd = archiveFd;
+
+    // Check Decompressor
+    if (!aDecompressor.isEmpty()) {
+        // Start Decompressor - Archive As stdin
+        if (!decompressor.start(QList<QByteArray>() << aDecompressor << "-dc", archiveFd)) {
+            // Close Archive fd
+            close(archiveFd);
+
+            return;
+        }
+
+        // Set Tar fd
+        fd = decompressor.outputFd();
+    }
+
+    // Get Block Size
+    const int blockSize = DEFAULT_ARCHIVE_SEARCH_TAR_BLOCK_SIZE;
+
+    // Init Header
+    QByteArray header(blockSize, '\0');
+    // Get Header Data
+    char* h = header.data();
+    // Init Long Path - GNU Long Name Or Pax Path For The Next Entry
+    QByteArray longPath;
+
+    // Go Thru Entries
+    while (!abortFlag && asReadFully(fd, h, blockSize)) {
+        // Check End Of Archive - Zero Block
+        if (header.count('\0') == blockSize) {
+            break;
+        }
+
+        // Check Checksum
+        if (!asTarChecksumValid(h)) {
+            qWarning() << "ArchiveSearch::searchTar - aArchivePath: " << aArchivePath << " - INVALID HEADER!";
+            break;
+        }
+
+        // Get Entry Size
+        qint64 size = asTarNumber(h + 124, 12);
+        // Get Padding
+        qint64 padding = (blockSize - size % blockSize) % blockSize;
+        // Get Type
+        char type = h[156];
+
+        // Check Long Name & Pax Header
+        if (type == 'L' || type == 'x') {
+            // Check Size
+            if (size > DEFAULT_ARCHIVE_SEARCH_MAX_HEADER_SIZE) {
+                break;
+            }
+
+            // Init Data
+            QByteArray data(size, '\0');
+
+            // Read Data
+            if (!asReadFully(fd, data.data(), size) || !asSkip(fd, padding)) {
+                break;
+            }
+
+            // Set Long Path
+            longPath = type == 'L' ? asTarField(data.constData(), data.size()) : asPaxPath(data);
+
+            continue;
+        }
+
+        // Check Other Meta Entries - Global Pax Header, Long Link Name
+        if (type == 'g' || type == 'K') {
+            // Skip Data
+            if (!asSkip(fd, size + padding)) {
+                break;
+            }
+
+            continue;
+        }
+
+        // Init Entry Path
+        QByteArray entryPath = longPath;
+
+        // Check Entry Path
+        if (entryPath.isEmpty()) {
+            // Get Name
+            entryPath = asTarField(h, 100);
+
+            // Check ustar Prefix
+            if (memcmp(h + 257, "ustar", 5) == 0 && h[345] != '\0') {
+                // Prepend Prefix
+                entryPath = asTarField(h + 345, 155) + '/' + entryPath;
+            }
+        }
+
+        // Reset Long Path
+        longPath.clear();
+        // Normalize Entry Path
+        entryPath = asEntryPath(entryPath);
+
+        // Init Data Stream
+        ContentStream dataStream(fd, size);
+
+        // Check Entry Path & Name
+        if (!entryPath.isEmpty() && matchName(entryPath)) {
+            // Check Content Matcher
+            if (!contentMatcher) {
+                // Report Entry
+                report(aArchivePath, entryPath, NULL);
+
+            // Check Regular File
+            } else if (type == '0' || type == '\0' || type == '7') {
+                // Init Hit
+                ContentHit hit;
+
+                // Match Content
+                if (matchContent(dataStream, hit)) {
+                    // Report Entry
+                    report(aArchivePath, entryPath, &hit);
+                }
+            }
+        }
+
+        // Skip Rest Of Entry
+        if (!dataStream.skipRest() || !asSkip(fd, padding)) {
+            break;
+        }
+    }
+
+    // Stop Decompressor - Trailing Blocks Are Not Needed
+    decompressor.stop(true);
+    // Close Archive fd
+    close(archiveFd);
+}
+
+//==============================================================================
+// Match Entry Name
+//==============================================================================
+bool ArchiveSearch::matchName(const QByteArray& aEntryPath) const
+{
+    return nameMatcher.match(QFile::decodeName(aEntryPath.mid(aEntryPath.lastIndexOf('/') + 1)));
+}
+
+//==============================================================================
+// Match Entry Content - Binary Entries Are Skipped
+//==============================================================================
+bool ArchiveSearch::matchContent(ContentStream& aStream, ContentHit& aHit) const
+{
+    // Peek Head
+    const QByteArray& head = aStream.peek(DEFAULT_CONTENT_SNIFF_SIZE);
+
+    // Check Head - Empty Entries Have Nothing To Find
+    if (head.isEmpty()) {
+        return false;
+    }
+
+    // Init Encoding
+    ContentEncoding encoding = ECEUTF8;
+
+    // Sniff Head - No Name Based Fallback, The Entry Can't Be Re-Read
+    if (ContentClassifier::sniff(head.constData(), head.size(), head.size() < DEFAULT_CONTENT_SNIFF_SIZE, &encoding) == ECSRBinary) {
+        return false;
+    }
+
+    // Set Encoding - UTF-16 Entries Are Matched Transcoded
+    aStream.setEncoding(encoding);
+
+    // Init Length
+    int length = 0;
+    // Find Content
+    qint64 offset = contentMatcher->findInStream(aStream, abortFlag, length, &aHit.terms);
+
+    // Check Offset
+    if (offset < 0) {
+        return false;
+    }
+
+    // Set Content Hit Offset & Length - Line & Snippet Need A Second Pass, Not Located
+    aHit.offset = offset;
+    aHit.length = length;
+
+    return true;
+}
+
+//==============================================================================
+// Report Entry
+//==============================================================================
+void ArchiveSearch::report(const QString& aArchivePath, const QByteArray& aEntryPath, const ContentHit* aHit) const
+{
+    // Check Callback
+    if (callback) {
+        // Callback
+        callback(aArchivePath, aArchivePath + QString("/") + QFile::decodeName(aEntryPath), aHit, context);
+    }
+}
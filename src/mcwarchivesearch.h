@@ -0,0 +1,94 @@
+#ifndef ARCHIVESEARCH_H
+#define ARCHIVESEARCH_H
+
+#include <QString>
+#include <QByteArray>
+#include <QList>
+
+#include <sys/types.h>
+
+#include "mcwutility.h"
+
+class GlobMatcher;
+class ContentMatcher;
+class ContentStream;
+
+
+//==============================================================================
+// Archive Process Class - Child Process Read Thru A Pipe, No Shell, No Temp Files
+//==============================================================================
+class ArchiveProcess
+{
+public:
+    // Constructor
+    ArchiveProcess();
+
+    // Start - aArgs[0] Is Looked Up In PATH, Input fd Becomes stdin If Set
+    bool start(const QList<QByteArray>& aArgs, const int& aInputFd = -1);
+
+    // Get Output fd
+    int outputFd() const;
+
+    // Stop - Kills The Child If aKill, Reaps It, Returns true If It Exited Cleanly
+    bool stop(const bool& aKill);
+
+    // Destructor
+    ~ArchiveProcess();
+
+private:
+    // Child pid
+    pid_t       pid;
+    // Output fd - Read End Of The Pipe
+    int         readFd;
+};
+
+//==============================================================================
+// Archive Search Class - Entry Names From The Catalog, Entry Content Streamed Thru The Matcher
+//==============================================================================
+class ArchiveSearch
+{
+public:
+    // Is Supported - By File Name Suffix
+    static bool isSupported(const QString& aFileName);
+
+    // Get Decompressor - By Magic Bytes, Empty For Files That Are Not gzip, bzip2 Or xz Streams
+    static QByteArray decompressorFor(const int& aFd);
+
+    // Constructor - Content Matcher Is NULL For Name Only Searches
+    ArchiveSearch(const GlobMatcher& aNameMatcher,
+                  const ContentMatcher* aContentMatcher,
+                  const bool& aAbort,
+                  fileSearchItemFoundCallback aCallback = NULL,
+                  void* aContext = NULL);
+
+    // Search - Reports Entries As Archive Path & Archive Path/Entry Path
+    void search(const QString& aArchivePath);
+
+private:
+    // Search Zip - Catalog Listed By unzip, Content Piped Per Entry
+    void searchZip(const QString& aArchivePath);
+    // Search Tar - Headers Parsed From The Stream, Decompressed Thru A Pipe If Needed
+    void searchTar(const QString& aArchivePath, const QByteArray& aDecompressor);
+
+    // Match Entry Name
+    bool matchName(const QByteArray& aEntryPath) const;
+    // Match Entry Content - Binary Entries Are Skipped
+    bool matchContent(ContentStream& aStream, ContentHit& aHit) const;
+
+    // Report Entry
+    void report(const QString& aArchivePath, const QByteArray& aEntryPath, const ContentHit* aHit) const;
+
+private:
+    // Name Matcher
+    const GlobMatcher&              nameMatcher;
+    // Content Matcher
+    const ContentMatcher*           contentMatcher;
+    // Abort Flag
+    const bool&                     abortFlag;
+    // Callback
+    fileSearchItemFoundCallback     callback;
+    // Callback Context
+    void*                           context;
+};
+
+#endif // ARCHIVESEARCH_H
@@ -52,6 +52,111 @@
 #define DEFAULT_DIR_LIST_SLEEP_TIIMEOUT_US                          50
 
 
+#define DEFAULT_STAT_BATCH_QUEUE_DEPTH                              32
+#define DEFAULT_STAT_BATCH_MAX_QUEUE_DEPTH                          256
+#define DEFAULT_STAT_BATCH_MIN_ENTRIES                              16
+#define DEFAULT_STAT_BATCH_QUEUE_DEPTH_ENV                          "MCW_STAT_QUEUE_DEPTH"
+
+
+#define DEFAULT_DIR_SCAN_MAX_THREADS                                16
+#define DEFAULT_DIR_SCAN_ROTATIONAL_THREADS                         1
+#define DEFAULT_DIR_SCAN_PROGRESS_INTERVAL_MS                       100
+#define DEFAULT_DIR_SCAN_IDLE_SLEEP_US                              200
+#define DEFAULT_DIR_SCAN_THREADS_ENV                                "MCW_SCAN_THREADS"
+#define DEFAULT_DIR_SIZE_BACKGROUND_THREADS                         2
+
+
+#define DEFAULT_CACHE_DIR_NAME                                      "mcworker"
+
+
+#define DEFAULT_DIR_SIZE_CACHE_FILE_NAME                            "dirsize.cache"
+#define DEFAULT_DIR_SIZE_CACHE_MAGIC                                0x5357434D
+#define DEFAULT_DIR_SIZE_CACHE_VERSION                              1
+#define DEFAULT_DIR_SIZE_CACHE_TTL_SECS                             3600
+#define DEFAULT_DIR_SIZE_CACHE_RACY_SECS                            2
+
+
+#define DEFAULT_DIR_TREE_DEPTH                                      1
+#define DEFAULT_DIR_TREE_BATCH_SIZE                                 256
+
+
+#define DEFAULT_DIR_BREAKDOWN_TOP_COUNT                             16
+#define DEFAULT_DIR_BREAKDOWN_MAX_TYPES                             64
+
+
+#define DEFAULT_TREE_WALKER_MAX_OPEN_FDS                            32
+
+
+#define DEFAULT_CONTENT_SEARCH_CHUNK_SIZE                           (1024 * 1024)
+#define DEFAULT_CONTENT_SEARCH_MAX_THREADS                          8
+#define DEFAULT_CONTENT_SEARCH_QUEUE_SIZE                           256
+#define DEFAULT_CONTENT_SEARCH_WAIT_MS                              50
+#define DEFAULT_CONTENT_SEARCH_LOCATE_BUFFER_SIZE                   65536
+#define DEFAULT_CONTENT_SEARCH_SNIPPET_SIZE                         200
+#define DEFAULT_CONTENT_SEARCH_SKIP_BUFFER_SIZE                     65536
+#define DEFAULT_CONTENT_SEARCH_MAX_TERMS                            64
+#define DEFAULT_CONTENT_SEARCH_MAX_TERM_VARIANTS                    16
+#define DEFAULT_SEARCH_RESULTS_TTL_MS                               (10 * 60 * 1000)
+#define DEFAULT_SEARCH_RESULTS_MAX_ITEMS                            100000
+#define DEFAULT_CONTENT_SNIFF_SIZE                                  4096
+#define DEFAULT_CONTENT_SNIFF_MAX_CONTROL_PERCENT                   10
+#define DEFAULT_CONTENT_SNIFF_MAX_EXTENSIONS                        1024
+
+
+#define DEFAULT_INDEX_WATCH_POLL_MS                                 1000
+#define DEFAULT_INDEX_WATCH_MAX_WATCHES                             8192
+#define DEFAULT_INDEX_WATCH_EVENT_BUFFER_SIZE                       4096
+
+
+#define DEFAULT_TRIGRAM_INDEX_DIR_NAME                              "trigram"
+#define DEFAULT_TRIGRAM_INDEX_FILE_SUFFIX                           ".idx"
+#define DEFAULT_TRIGRAM_INDEX_MAGIC                                 0x5457434D
+#define DEFAULT_TRIGRAM_INDEX_VERSION                               3
+#define DEFAULT_TRIGRAM_INDEX_MAX_FILE_SIZE                         (16 * 1024 * 1024)
+#define DEFAULT_TRIGRAM_INDEX_MAX_FILE_TRIGRAMS                     20000
+#define DEFAULT_TRIGRAM_INDEX_MAX_POSTINGS                          (16 * 1024 * 1024)
+#define DEFAULT_TRIGRAM_INDEX_READ_SIZE                             65536
+#define DEFAULT_TRIGRAM_INDEX_RACY_MS                               2000
+#define DEFAULT_TRIGRAM_INDEX_TTL_SECS                              (24 * 3600)
+#define DEFAULT_TRIGRAM_INDEX_REBUILD_DELAY_MS                      (5 * 60 * 1000)
+
+
+#define DEFAULT_NAME_INDEX_DIR_NAME                                 "names"
+#define DEFAULT_NAME_INDEX_FILE_SUFFIX                              ".db"
+#define DEFAULT_NAME_INDEX_MAGIC                                    0x4E57434D
+#define DEFAULT_NAME_INDEX_VERSION                                  1
+#define DEFAULT_NAME_INDEX_RACY_MS                                  2000
+#define DEFAULT_NAME_INDEX_TTL_SECS                                 3600
+#define DEFAULT_NAME_INDEX_REFRESH_DELAY_MS                         10000
+
+
+#define DEFAULT_FIND_TOP_COUNT                                      20
+#define DEFAULT_FIND_MAX_MATCHES                                    262144
+#define DEFAULT_FIND_CACHE_TTL_MS                                   60000
+#define DEFAULT_FIND_SCORE_MATCH                                    16
+#define DEFAULT_FIND_SCORE_BOUNDARY                                 8
+#define DEFAULT_FIND_SCORE_CONTIGUOUS                               6
+#define DEFAULT_FIND_SCORE_NAME                                     24
+#define DEFAULT_FIND_SCORE_RECENT_HOUR                              24
+#define DEFAULT_FIND_SCORE_RECENT_DAY                               16
+#define DEFAULT_FIND_SCORE_RECENT_WEEK                              8
+#define DEFAULT_FIND_MAX_GAP_PENALTY                                8
+#define DEFAULT_FIND_LENGTH_PENALTY_DIVISOR                         32
+
+
+#define DEFAULT_ARCHIVE_SEARCH_APP_UNZIP                            "unzip"
+#define DEFAULT_ARCHIVE_SEARCH_APP_GZIP                             "gzip"
+#define DEFAULT_ARCHIVE_SEARCH_APP_BZIP2                            "bzip2"
+#define DEFAULT_ARCHIVE_SEARCH_APP_XZ                               "xz"
+#define DEFAULT_ARCHIVE_SEARCH_TAR_BLOCK_SIZE                       512
+#define DEFAULT_ARCHIVE_SEARCH_MAX_HEADER_SIZE                      (1024 * 1024)
+
+
+#define DEFAULT_IGNORE_FILE_GIT                                     ".gitignore"
+#define DEFAULT_IGNORE_FILE_IGNORE                                  ".ignore"
+#define DEFAULT_IGNORE_GIT_DIR_PATTERN                              ".git/"
+
+
 
 #define DEFAULT_APP_RAR                                             "rar"
 #define DEFAULT_APP_UNRAR                                           "unrar"
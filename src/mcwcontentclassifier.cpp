@@ -0,0 +1,248 @@
+#include <QMimeDatabase>
+#include <QMimeType>
+#include <QHash>
+#include <QReadWriteLock>
+#include <QReadLocker>
+#include <QWriteLocker>
+#include <QDebug>
+
+#include <sys/types.h>
+#include <unistd.h>
+#include <errno.h>
+
+#include "mcwcontentclassifier.h"
+#include "mcwutility.h"
+#include "mcwconstants.h"
+
+
+// Extension Verdicts - Shared By All Threads, Ambiguous Files Only
+static QHash<QString, bool> extensionVerdicts;
+// Extension Verdicts Lock
+static QReadWriteLock extensionVerdictsLock;
+
+
+//==============================================================================
+// Get UTF-8 Sequence Length From Lead Byte - 0 If Invalid
+//==============================================================================
+static inline int ccSequenceLength(const uchar& aByte)
+{
+    // Check Lead Byte
+    if (aByte >= 0xC2 && aByte <= 0xDF)
+        return 2;
+    if (aByte >= 0xE0 && aByte <= 0xEF)
+        return 3;
+    if (aByte >= 0xF0 && aByte <= 0xF4)
+        return 4;
+
+    return 0;
+}
+
+//==============================================================================
+// Constructor
+//==============================================================================
+ContentClassifier::ContentClassifier()
+    : mimeDatabase(NULL)
+    , buffer(DEFAULT_CONTENT_SNIFF_SIZE, '\0')
+{
+}
+
+//==============================================================================
+// Sniff - Classifies The First Bytes Of A File, aAtEnd If They Are The Whole File, UTF-16 Text Sets aEncoding
+//==============================================================================
+ContentSniffResult ContentClassifier::sniff(const char* aData, const int& aLength, const bool& aAtEnd, ContentEncoding* aEncoding)
+{
+    // Get Data
+    const uchar* data = reinterpret_cast<const uchar*>(aData);
+
+    // Check Encoding
+    if (aEncoding) {
+        // Reset Encoding
+        *aEncoding = ECEUTF8;
+    }
+
+    // Check UTF-8 BOM
+    if (aLength >= 3 && data[0] == 0xEF && data[1] == 0xBB && data[2] == 0xBF) {
+        return ECSRText;
+    }
+
+    // Check UTF-16 BOMs
+    if (aLength >= 2 && ((data[0] == 0xFF && data[1] == 0xFE) || (data[0] == 0xFE && data[1] == 0xFF))) {
+        // Check Encoding
+        if (aEncoding) {
+            // Set Encoding
+            *aEncoding = data[0] == 0xFF ? ECEUTF16LE : ECEUTF16BE;
+        }
+
+        return ECSRText;
+    }
+
+    // Init Counters
+    int nulCount[2] = { 0, 0 };
+    int controlCount = 0;
+    // Init Valid UTF-8
+    bool validUTF8 = true;
+
+    // Go Thru Bytes
+    for (int i=0; i<aLength; ++i) {
+        // Get Byte
+        uchar byte = data[i];
+
+        // Check ASCII
+        if (byte < 0x80) {
+            // Check NUL
+            if (byte == 0) {
+                // Inc NUL Count By Parity
+                nulCount[i & 1]++;
+
+            // Check Control - Tabs, Line Breaks, Backspace & Escape Are Common In Text
+            } else if (byte < 0x20 && !(byte >= '\b' && byte <= '\r') && byte != 0x1B) {
+                // Inc Control Count
+                controlCount++;
+            }
+
+            continue;
+        }
+
+        // Check UTF-8 Already Invalid
+        if (!validUTF8) {
+            continue;
+        }
+
+        // Get Sequence Length
+        int sLength = ccSequenceLength(byte);
+
+        // Check Sequence Length
+        if (sLength == 0) {
+            // Set Invalid
+            validUTF8 = false;
+            continue;
+        }
+
+        // Check Truncated Sequence - Cut By The Sniff Window Unless At End
+        if (i + sLength > aLength) {
+            // Set Valid
+            validUTF8 = !aAtEnd;
+            break;
+        }
+
+        // Go Thru Continuation Bytes
+        for (int j=1; j<sLength && validUTF8; ++j) {
+            // Check Continuation Byte
+            validUTF8 = (data[i + j] & 0xC0) == 0x80;
+        }
+
+        // Skip Continuation Bytes
+        i += sLength - 1;
+    }
+
+    // Check NULs
+    if (nulCount[0] + nulCount[1] > 0) {
+        // Check UTF-16 Without BOM - ASCII Heavy Text Has NULs On One Parity Only
+        if ((nulCount[0] == 0 || nulCount[1] == 0) && (nulCount[0] + nulCount[1]) * 4 > aLength) {
+            // Check Encoding
+            if (aEncoding) {
+                // Set Encoding - High Bytes Come Second In Little Endian
+                *aEncoding = nulCount[0] == 0 ? ECEUTF16LE : ECEUTF16BE;
+            }
+
+            return ECSRText;
+        }
+
+        return ECSRBinary;
+    }
+
+    // Check Control Bytes
+    if (controlCount * 100 > aLength * DEFAULT_CONTENT_SNIFF_MAX_CONTROL_PERCENT) {
+        return ECSRBinary;
+    }
+
+    // Check Valid UTF-8 - Otherwise Could Be Legacy 8 Bit Text
+    return validUTF8 ? ECSRText : ECSRAmbiguous;
+}
+
+//==============================================================================
+// Is Searchable - Sniffs The File Start, Consults The Mime Database Only When Ambiguous
+//==============================================================================
+bool ContentClassifier::isSearchable(const int& aFd, const QString& aFilePath, ContentEncoding* aEncoding)
+{
+    // Check Encoding
+    if (aEncoding) {
+        // Reset Encoding
+        *aEncoding = ECEUTF8;
+    }
+
+    // Init Bytes Read
+    ssize_t bytesRead = -1;
+
+    // Read File Start - File Offset Is Left Alone
+    do {
+        bytesRead = pread(aFd, buffer.data(), buffer.size(), 0);
+    } while (bytesRead < 0 && errno == EINTR);
+
+    // Check Bytes Read - Empty Files Have Nothing To Find
+    if (bytesRead <= 0) {
+        return false;
+    }
+
+    // Sniff
+    ContentSniffResult result = sniff(buffer.constData(), bytesRead, bytesRead < buffer.size(), aEncoding);
+
+    // Check Result
+    if (result != ECSRAmbiguous) {
+        return result == ECSRText;
+    }
+
+    // Get File Name
+    QString fileName = aFilePath.mid(aFilePath.lastIndexOf("/") + 1);
+    // Get Dot Position
+    int dotPos = fileName.lastIndexOf(".");
+    // Get Extension
+    QString extension = dotPos > 0 ? fileName.mid(dotPos + 1).toLower() : QString("");
+
+    // Check Extension
+    if (!extension.isEmpty()) {
+        // Init Locker
+        QReadLocker locker(&extensionVerdictsLock);
+
+        // Check Extension Verdict
+        if (extensionVerdicts.contains(extension)) {
+            return extensionVerdicts.value(extension);
+        }
+    }
+
+    // Check Mime Database
+    if (!mimeDatabase) {
+        // Create Mime Database
+        mimeDatabase = new QMimeDatabase();
+    }
+
+    // Get Verdict
+    bool searchable = isMimeSupportedByContentSearch(mimeDatabase->mimeTypeForFile(aFilePath).name());
+
+    // Check Extension
+    if (!extension.isEmpty()) {
+        // Init Locker
+        QWriteLocker locker(&extensionVerdictsLock);
+
+        // Check Count - Random Suffixes Don't Grow The Cache Unbounded
+        if (extensionVerdicts.count() < DEFAULT_CONTENT_SNIFF_MAX_EXTENSIONS) {
+            // Set Extension Verdict
+            extensionVerdicts[extension] = searchable;
+        }
+    }
+
+    return searchable;
+}
+
+//==============================================================================
+// Destructor
+//==============================================================================
+ContentClassifier::~ContentClassifier()
+{
+    // Check Mime Database
+    if (mimeDatabase) {
+        // Delete Mime Database
+        delete mimeDatabase;
+        mimeDatabase = NULL;
+    }
+}
@@ -0,0 +1,55 @@
+#ifndef CONTENTCLASSIFIER_H
+#define CONTENTCLASSIFIER_H
+
+#include <QString>
+#include <QByteArray>
+
+class QMimeDatabase;
+
+
+//==============================================================================
+// Content Sniff Result
+//==============================================================================
+enum ContentSniffResult
+{
+    ECSRText            = 0,
+    ECSRBinary,
+    ECSRAmbiguous
+};
+
+//==============================================================================
+// Content Encoding - Text Encodings The Matcher Needs To Know About
+//==============================================================================
+enum ContentEncoding
+{
+    ECEUTF8             = 0,
+    ECEUTF16LE,
+    ECEUTF16BE
+};
+
+//==============================================================================
+// Content Classifier Class - Text/Binary By Sniffing, One Per Thread
+//==============================================================================
+class ContentClassifier
+{
+public:
+    // Constructor
+    ContentClassifier();
+
+    // Sniff - Classifies The First Bytes Of A File, aAtEnd If They Are The Whole File, UTF-16 Text Sets aEncoding
+    static ContentSniffResult sniff(const char* aData, const int& aLength, const bool& aAtEnd, ContentEncoding* aEncoding = NULL);
+
+    // Is Searchable - Sniffs The File Start, Consults The Mime Database Only When Ambiguous
+    bool isSearchable(const int& aFd, const QString& aFilePath, ContentEncoding* aEncoding = NULL);
+
+    // Destructor
+    ~ContentClassifier();
+
+private:
+    // Mime Database - Created On The First Ambiguous File
+    QMimeDatabase*      mimeDatabase;
+    // Sniff Buffer
+    QByteArray          buffer;
+};
+
+#endif // CONTENTCLASSIFIER_H
@@ -0,0 +1,1586 @@
+#include <QStringList>
+#include <QTextCodec>
+#include <QDebug>
+
+#include <sys/types.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <string.h>
+#include <errno.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif // __SSE2__
+
+#include "mcwcontentmatcher.h"
+#include "mcwconstants.h"
+
+
+//==============================================================================
+// Fold ASCII Byte
+//==============================================================================
+static inline uchar cmFold(const uchar& aByte)
+{
+    return (aByte >= 'A' && aByte <= 'Z') ? aByte | 0x20 : aByte;
+}
+
+//==============================================================================
+// Is Word Boundary Byte - ASCII White Space & NUL
+//==============================================================================
+static inline bool cmIsBoundary(const uchar& aByte)
+{
+    return aByte == ' ' || (aByte >= '\t' && aByte <= '\r') || aByte == '\0';
+}
+
+#if defined(__SSE2__)
+
+//==============================================================================
+// Fold ASCII Bytes In Block
+//==============================================================================
+static inline __m128i cmFold16(const __m128i& aBlock)
+{
+    // Get Upper Case Mask - Bytes Above 0x7F Are Negative And Never Match
+    __m128i upper = _mm_and_si128(_mm_cmpgt_epi8(aBlock, _mm_set1_epi8('A' - 1)), _mm_cmplt_epi8(aBlock, _mm_set1_epi8('Z' + 1)));
+
+    return _mm_or_si128(aBlock, _mm_and_si128(upper, _mm_set1_epi8(0x20)));
+}
+
+#endif // __SSE2__
+
+//==============================================================================
+// Fold ASCII Bytes
+//==============================================================================
+static inline QByteArray cmFoldBytes(const QByteArray& aBytes)
+{
+    // Init Result
+    QByteArray result = aBytes;
+
+    // Go Thru Bytes
+    for (int i=0; i<result.size(); ++i) {
+        // Fold Byte
+        result[i] = (char)cmFold((uchar)result[i]);
+    }
+
+    return result;
+}
+
+//==============================================================================
+// Has Non-ASCII Bytes
+//==============================================================================
+static inline bool cmHasNonAscii(const QByteArray& aBytes)
+{
+    // Go Thru Bytes
+    for (int i=0; i<aBytes.size(); ++i) {
+        // Check Byte
+        if ((uchar)aBytes[i] >= 0x80) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+//==============================================================================
+// Get Fold Units - UTF-8 Case Variants Per Character, Longest First, ASCII Folded
+//==============================================================================
+static QVector<QList<QByteArray> > cmFoldUnits(const QByteArray& aPattern)
+{
+    // Init Fold Units
+    QVector<QList<QByteArray> > units;
+
+    // Get Pattern Text
+    QString text = QString::fromUtf8(aPattern);
+    // Get Text Length
+    int tLength = text.length();
+
+    // Go Thru Characters
+    for (int i=0; i<tLength; ++i) {
+        // Get Character Length - Surrogate Pairs Are One Character
+        int cLength = text.at(i).isHighSurrogate() && i + 1 < tLength ? 2 : 1;
+        // Get Character
+        QString character = text.mid(i, cLength);
+
+        // Init Forms
+        QStringList forms;
+        // Add Forms - Mappings May Change The Length, Like Sharp S To SS
+        forms << character << character.toLower() << character.toUpper() << character.toCaseFolded();
+
+        // Init Variants - Longest First
+        QList<QByteArray> variants;
+
+        // Go Thru Forms
+        for (int j=0; j<forms.count(); ++j) {
+            // Get Variant - ASCII Folded Like The Text
+            QByteArray variant = cmFoldBytes(forms[j].toUtf8());
+
+            // Check Variant
+            if (variant.isEmpty() || variants.contains(variant)) {
+                continue;
+            }
+
+            // Init Insert Position
+            int k = 0;
+
+            // Find Insert Position
+            while (k < variants.count() && variants[k].length() >= variant.length()) {
+                k++;
+            }
+
+            // Insert Variant
+            variants.insert(k, variant);
+        }
+
+        // Add Fold Unit
+        units << variants;
+
+        // Skip Low Surrogate
+        i += cLength - 1;
+    }
+
+    return units;
+}
+
+//==============================================================================
+// Get Longest ASCII Run - Non-ASCII Bytes Differ Between Case Variants
+//==============================================================================
+static QByteArray cmLongestAsciiRun(const QByteArray& aBytes)
+{
+    // Init Best Run
+    int bestStart  = 0;
+    int bestLength = 0;
+    // Init Run Start
+    int start = 0;
+
+    // Go Thru Bytes
+    for (int i=0; i<=aBytes.size(); ++i) {
+        // Check Run End
+        if (i == aBytes.size() || (uchar)aBytes[i] >= 0x80) {
+            // Check Run Length
+            if (i - start > bestLength) {
+                // Set Best Run
+                bestStart  = start;
+                bestLength = i - start;
+            }
+
+            // Set Next Run Start
+            start = i + 1;
+        }
+    }
+
+    return aBytes.mid(bestStart, bestLength);
+}
+
+//==============================================================================
+// Get Case Variants - Every Spelling Of A Non-ASCII Term, Folded Term If Too Many
+//==============================================================================
+static QList<QByteArray> cmCaseVariants(const QByteArray& aTerm)
+{
+    // Init Variants
+    QList<QByteArray> variants;
+    // Add Folded Term
+    variants << cmFoldBytes(aTerm);
+
+    // Check Non-ASCII
+    if (!cmHasNonAscii(aTerm)) {
+        return variants;
+    }
+
+    // Get Fold Units
+    QVector<QList<QByteArray> > units = cmFoldUnits(aTerm);
+    // Init Combinations
+    int combinations = 1;
+
+    // Go Thru Units
+    for (int i=0; i<units.count() && combinations <= DEFAULT_CONTENT_SEARCH_MAX_TERM_VARIANTS; ++i) {
+        // Multiply Combinations
+        combinations *= units[i].count();
+    }
+
+    // Check Combinations - Mixed Case Spellings Of Long Terms Are Left Out
+    if (combinations > DEFAULT_CONTENT_SEARCH_MAX_TERM_VARIANTS) {
+        return variants;
+    }
+
+    // Reset Variants
+    variants.clear();
+    // Add Empty Prefix
+    variants << QByteArray();
+
+    // Go Thru Units
+    for (int i=0; i<units.count(); ++i) {
+        // Init Expanded Variants
+        QList<QByteArray> expanded;
+
+        // Go Thru Prefixes
+        for (int j=0; j<variants.count(); ++j) {
+            // Go Thru Unit Variants
+            for (int k=0; k<units[i].count(); ++k) {
+                // Add Expanded Variant
+                expanded << variants[j] + units[i][k];
+            }
+        }
+
+        // Set Variants
+        variants = expanded;
+    }
+
+    return variants;
+}
+
+//==============================================================================
+// Step UTF-8 - Decodes One Character At aPos, Invalid Bytes Decode Alone To U+FFFD, Returns Bytes Used
+//==============================================================================
+static inline int cmStepUtf8(const uchar* aData, const int& aLength, const int& aPos, uint& aCodePoint)
+{
+    // Get Lead Byte
+    uchar lead = aData[aPos];
+
+    // Check ASCII
+    if (lead < 0x80) {
+        // Set Code Point
+        aCodePoint = lead;
+
+        return 1;
+    }
+
+    // Get Sequence Length
+    int sLength = (lead >= 0xC2 && lead <= 0xDF) ? 2 : (lead >= 0xE0 && lead <= 0xEF) ? 3 : (lead >= 0xF0 && lead <= 0xF4) ? 4 : 0;
+
+    // Set Replacement - Until The Sequence Proves Valid
+    aCodePoint = QChar::ReplacementCharacter;
+
+    // Check Sequence Length & Truncated Sequence
+    if (sLength == 0 || aPos + sLength > aLength) {
+        return 1;
+    }
+
+    // Init Code Point
+    uint codePoint = lead & (0x7F >> sLength);
+
+    // Go Thru Continuation Bytes
+    for (int i=1; i<sLength; ++i) {
+        // Get Byte
+        uchar byte = aData[aPos + i];
+
+        // Check Continuation Byte
+        if ((byte & 0xC0) != 0x80) {
+            return 1;
+        }
+
+        // Add Bits
+        codePoint = (codePoint << 6) | (byte & 0x3F);
+    }
+
+    // Check Overlong, Surrogate & Out Of Range Sequences
+    if ((sLength == 3 && (codePoint < 0x800 || (codePoint >= 0xD800 && codePoint <= 0xDFFF))) || (sLength == 4 && (codePoint < 0x10000 || codePoint > 0x10FFFF))) {
+        return 1;
+    }
+
+    // Set Code Point
+    aCodePoint = codePoint;
+
+    return sLength;
+}
+
+//==============================================================================
+// Decode UTF-8 - One Unit Per Invalid Byte, So Text Positions Map Back To Bytes
+//==============================================================================
+static QString cmDecodeUtf8(const char* aData, const int& aLength)
+{
+    // Get Data
+    const uchar* data = reinterpret_cast<const uchar*>(aData);
+
+    // Init Text - Never More Units Than Bytes
+    QString text;
+    // Resize Text
+    text.resize(aLength);
+    // Get Text Data
+    QChar* units = text.data();
+
+    // Init Unit Count
+    int uCount = 0;
+    // Init Code Point
+    uint codePoint = 0;
+
+    // Go Thru Bytes
+    for (int pos=0; pos<aLength; ) {
+        // Step Character
+        pos += cmStepUtf8(data, aLength, pos, codePoint);
+
+        // Check Surrogates
+        if (codePoint >= 0x10000) {
+            // Add Surrogate Pair
+            units[uCount++] = QChar(QChar::highSurrogate(codePoint));
+            units[uCount++] = QChar(QChar::lowSurrogate(codePoint));
+        } else {
+            // Add Unit
+            units[uCount++] = QChar((ushort)codePoint);
+        }
+    }
+
+    // Cut Text
+    text.truncate(uCount);
+
+    return text;
+}
+
+//==============================================================================
+// Get UTF-8 Byte Offset - Position After aUnits Units Decoded From aFrom, Same Rules As cmDecodeUtf8
+//==============================================================================
+static int cmUtf8ByteOffset(const char* aData, const int& aLength, const int& aFrom, const int& aUnits)
+{
+    // Get Data
+    const uchar* data = reinterpret_cast<const uchar*>(aData);
+
+    // Init Position
+    int pos = aFrom;
+    // Init Unit Count
+    int uCount = 0;
+    // Init Code Point
+    uint codePoint = 0;
+
+    // Go Thru Characters
+    while (uCount < aUnits && pos < aLength) {
+        // Step Character
+        pos += cmStepUtf8(data, aLength, pos, codePoint);
+        // Inc Unit Count
+        uCount += codePoint >= 0x10000 ? 2 : 1;
+    }
+
+    return pos;
+}
+
+//==============================================================================
+// Set Snippet - From Bytes Read At aFrom, Cut To Whole Characters & The Hit Line
+//==============================================================================
+static void cmSetSnippet(ContentHit& aHit, const char* aData, const int& aSize, const qint64& aFrom, const qint64& aLineStart, const int& aHitEnd)
+{
+    // Init Snippet Start
+    int start = 0;
+
+    // Skip Continuation Bytes - Snippet Starts On A Character
+    while (aFrom + start > aLineStart && start < aSize && start < 3 && ((uchar)aData[start] & 0xC0) == 0x80) {
+        start++;
+    }
+
+    // Init Snippet End
+    int end = qMin(aSize, aHitEnd);
+
+    // Find Line End After The Hit
+    while (end < aSize && aData[end] != '\n') {
+        end++;
+    }
+
+    // Check Carriage Return
+    if (end > start && aData[end - 1] == '\r') {
+        end--;
+    }
+
+    // Set Snippet
+    aHit.snippet = QString::fromUtf8(aData + start, end - start);
+
+    // Check Cut Character At The End
+    if (!aHit.snippet.isEmpty() && aHit.snippet.at(aHit.snippet.length() - 1) == QChar(QChar::ReplacementCharacter) && end == aSize) {
+        // Chop Cut Character
+        aHit.snippet.chop(1);
+    }
+}
+
+//==============================================================================
+// Constructor
+//==============================================================================
+ContentHit::ContentHit()
+    : offset(-1)
+    , length(0)
+    , line(0)
+{
+}
+
+//==============================================================================
+// Constructor - Negative Limit Reads Up To The End
+//==============================================================================
+ContentStream::ContentStream(const int& aFd, const qint64& aLimit)
+    : streamFd(aFd)
+    , limit(aLimit)
+    , consumed(0)
+    , headPos(0)
+    , decoder(NULL)
+    , decodedPos(0)
+{
+}
+
+//==============================================================================
+// Peek - Reads Up To aSize Bytes Ahead, Returned Again By read()
+//==============================================================================
+const QByteArray& ContentStream::peek(const int& aSize)
+{
+    // Get Head Length
+    int hLength = head.size();
+
+    // Resize Head
+    head.resize(qMax(aSize, hLength));
+
+    // Fill Head
+    while (hLength < head.size()) {
+        // Get Wanted Size
+        qint64 wanted = limit >= 0 ? qMin((qint64)(head.size() - hLength), limit - consumed) : head.size() - hLength;
+
+        // Check Wanted Size
+        if (wanted <= 0) {
+            break;
+        }
+
+        // Read
+        ssize_t bytesRead = ::read(streamFd, head.data() + hLength, wanted);
+
+        // Check Interrupted
+        if (bytesRead < 0 && errno == EINTR) {
+            continue;
+        }
+
+        // Check Bytes Read
+        if (bytesRead <= 0) {
+            break;
+        }
+
+        // Inc Head Length
+        hLength += bytesRead;
+        // Inc Consumed
+        consumed += bytesRead;
+    }
+
+    // Cut Head
+    head.resize(hLength);
+
+    return head;
+}
+
+//==============================================================================
+// Set Encoding - UTF-16 Is Transcoded To UTF-8 By read(), Offsets Are Then In The Transcoded Text
+//==============================================================================
+void ContentStream::setEncoding(const ContentEncoding& aEncoding)
+{
+    // Check Decoder
+    if (decoder) {
+        // Delete Decoder
+        delete decoder;
+        decoder = NULL;
+    }
+
+    // Check Encoding - Matchers Work On UTF-8 Bytes
+    if (aEncoding == ECEUTF8) {
+        return;
+    }
+
+    // Get Codec - Leading BOM Is Dropped By The Decoder
+    QTextCodec* codec = QTextCodec::codecForName(aEncoding == ECEUTF16BE ? "UTF-16BE" : "UTF-16LE");
+
+    // Check Codec
+    if (codec) {
+        // Create Decoder - Keeps Units & Surrogates Split Between Reads
+        decoder = codec->makeDecoder();
+    }
+}
+
+//==============================================================================
+// Read - Returns Bytes Read, 0 At The End, -1 On Error
+//==============================================================================
+qint64 ContentStream::read(char* aData, const qint64& aSize)
+{
+    // Check Decoder
+    if (!decoder) {
+        return readRaw(aData, aSize);
+    }
+
+    // Fill Decoded
+    while (decodedPos >= decoded.size()) {
+        // Check Raw Buffer Size
+        if (rawBuffer.size() < aSize) {
+            // Resize Raw Buffer
+            rawBuffer.resize(aSize);
+        }
+
+        // Read Raw
+        qint64 bytesRead = readRaw(rawBuffer.data(), aSize);
+
+        // Check Bytes Read
+        if (bytesRead <= 0) {
+            return bytesRead;
+        }
+
+        // Decode - May Be Empty While A Unit Is Incomplete
+        decoded = decoder->toUnicode(rawBuffer.constData(), bytesRead).toUtf8();
+        // Reset Decoded Position
+        decodedPos = 0;
+    }
+
+    // Get Size
+    int size = qMin((qint64)(decoded.size() - decodedPos), aSize);
+
+    // Copy From Decoded
+    memcpy(aData, decoded.constData() + decodedPos, size);
+
+    // Inc Decoded Position
+    decodedPos += size;
+
+    return size;
+}
+
+//==============================================================================
+// Read Raw - Peeked Head First, Then The fd
+//==============================================================================
+qint64 ContentStream::readRaw(char* aData, const qint64& aSize)
+{
+    // Check Head
+    if (headPos < head.size()) {
+        // Get Size
+        int size = qMin((qint64)(head.size() - headPos), aSize);
+
+        // Copy From Head
+        memcpy(aData, head.constData() + headPos, size);
+
+        // Inc Head Position
+        headPos += size;
+
+        return size;
+    }
+
+    // Get Wanted Size
+    qint64 wanted = limit >= 0 ? qMin(aSize, limit - consumed) : aSize;
+
+    // Check Wanted Size
+    if (wanted <= 0) {
+        return 0;
+    }
+
+    // Init Bytes Read
+    ssize_t bytesRead = -1;
+
+    // Read
+    do {
+        bytesRead = ::read(streamFd, aData, wanted);
+    } while (bytesRead < 0 && errno == EINTR);
+
+    // Check Bytes Read
+    if (bytesRead > 0) {
+        // Inc Consumed
+        consumed += bytesRead;
+    }
+
+    return bytesRead;
+}
+
+//==============================================================================
+// Skip Rest - Seeks Or Reads Up To The Limit
+//==============================================================================
+bool ContentStream::skipRest()
+{
+    // Check Limit
+    if (limit < 0 || consumed >= limit) {
+        return true;
+    }
+
+    // Try Seeking - Files Only, Pipes Are Read Thru
+    if (lseek(streamFd, limit - consumed, SEEK_CUR) >= 0) {
+        // Set Consumed
+        consumed = limit;
+
+        return true;
+    }
+
+    // Init Buffer
+    QByteArray buffer(DEFAULT_CONTENT_SEARCH_SKIP_BUFFER_SIZE, '\0');
+
+    // Read Up To The Limit
+    while (consumed < limit) {
+        // Init Bytes Read
+        ssize_t bytesRead = -1;
+
+        // Read
+        do {
+            bytesRead = ::read(streamFd, buffer.data(), qMin((qint64)buffer.size(), limit - consumed));
+        } while (bytesRead < 0 && errno == EINTR);
+
+        // Check Bytes Read - Truncated
+        if (bytesRead <= 0) {
+            return false;
+        }
+
+        // Inc Consumed
+        consumed += bytesRead;
+    }
+
+    return true;
+}
+
+//==============================================================================
+// Get Remaining - Bytes Left In The fd Up To The Limit, -1 If Unbounded
+//==============================================================================
+qint64 ContentStream::remaining() const
+{
+    return limit >= 0 ? limit - consumed : -1;
+}
+
+//==============================================================================
+// Destructor
+//==============================================================================
+ContentStream::~ContentStream()
+{
+    // Check Decoder
+    if (decoder) {
+        // Delete Decoder
+        delete decoder;
+        decoder = NULL;
+    }
+}
+
+//==============================================================================
+// Constructor - Pattern Is UTF-8, Compiled Once For Regular Expressions
+//==============================================================================
+ContentMatcher::ContentMatcher(const QByteArray& aPattern, const bool& aCaseSensitive, const bool& aWholeWord, const bool& aRegExp)
+    : pattern(aPattern)
+    , caseSensitive(aCaseSensitive)
+    , wholeWord(aWholeWord)
+    , skipTable(256, qMax(aPattern.length(), 1))
+    , maxHitLength(aPattern.length())
+    , regExpMode(aRegExp)
+    , multiTermMode(false)
+    , allTerms(false)
+{
+    // Check Regular Expression Mode
+    if (regExpMode) {
+        // Get Pattern - Whole Words Are Matched Between Word Boundaries
+        QString regExpPattern = wholeWord ? QString("\\b(?:%1)\\b").arg(QString::fromUtf8(pattern)) : QString::fromUtf8(pattern);
+
+        // Set Pattern
+        regExp.setPattern(regExpPattern);
+        // Set Options - Anchors Match At Line Boundaries
+        regExp.setPatternOptions(caseSensitive ? QRegularExpression::MultilineOption : QRegularExpression::MultilineOption | QRegularExpression::CaseInsensitiveOption);
+        // Compile Once - JIT Where Available, Shared By All Matcher Threads
+        regExp.optimize();
+
+        return;
+    }
+
+    // Get Pattern Length
+    int pLength = pattern.length();
+
+    // Check Case Sensitive
+    if (!caseSensitive) {
+        // Fold Pattern
+        pattern = cmFoldBytes(pattern);
+    }
+
+    // Check Non-ASCII Case Insensitive - Byte Folding Covers ASCII Only, Other Characters Get Their Case Variants
+    if (!caseSensitive && cmHasNonAscii(pattern)) {
+        // Set Fold Units
+        foldUnits = cmFoldUnits(aPattern);
+        // Reset Max Hit Length
+        maxHitLength = 0;
+
+        // Go Thru Fold Units
+        for (int i=0; i<foldUnits.count(); ++i) {
+            // Inc Max Hit Length
+            maxHitLength += foldUnits[i].first().length();
+        }
+    }
+
+    // Go Thru Pattern - Last Byte Excluded
+    for (int i=0; i<pLength - 1; ++i) {
+        // Set Skip
+        skipTable[(uchar)pattern[i]] = pLength - 1 - i;
+    }
+}
+
+//==============================================================================
+// Constructor - Multiple UTF-8 Terms, Matched In One Pass By An Aho-Corasick Automaton
+//==============================================================================
+ContentMatcher::ContentMatcher(const QList<QByteArray>& aTerms, const bool& aCaseSensitive, const bool& aWholeWord, const bool& aAllTerms)
+    : caseSensitive(aCaseSensitive)
+    , wholeWord(aWholeWord)
+    , maxHitLength(0)
+    , regExpMode(false)
+    , multiTermMode(true)
+    , allTerms(aAllTerms)
+{
+    // Check Term Count - Found Terms Are Tracked In A 64 Bit Mask
+    if (aTerms.isEmpty() || aTerms.count() > DEFAULT_CONTENT_SEARCH_MAX_TERMS) {
+        qWarning() << "ContentMatcher::ContentMatcher - INVALID TERM COUNT: " << aTerms.count();
+        return;
+    }
+
+    // Go Thru Terms
+    for (int i=0; i<aTerms.count(); ++i) {
+        // Check Term - Empty Terms Would Never Be Found
+        if (aTerms[i].isEmpty()) {
+            qWarning() << "ContentMatcher::ContentMatcher - EMPTY TERM: " << i;
+            terms.clear();
+            return;
+        }
+
+        // Add Term - Folded If Case Insensitive
+        terms << (caseSensitive ? aTerms[i] : cmFoldBytes(aTerms[i]));
+
+        // Get Variants - Exact Bytes If Case Sensitive
+        QList<QByteArray> variants = caseSensitive ? QList<QByteArray>() << aTerms[i] : cmCaseVariants(aTerms[i]);
+
+        // Go Thru Variants
+        for (int j=0; j<variants.count(); ++j) {
+            // Add Pattern
+            termAutomaton.addPattern(variants[j], i);
+        }
+    }
+
+    // Build Automaton
+    termAutomaton.build(caseSensitive);
+    // Set Max Hit Length
+    maxHitLength = termAutomaton.maxPatternLength();
+}
+
+//==============================================================================
+// Is Valid
+//==============================================================================
+bool ContentMatcher::isValid() const
+{
+    // Check Multi Term Mode
+    if (multiTermMode) {
+        return !terms.isEmpty() && !termAutomaton.isEmpty();
+    }
+
+    return !pattern.isEmpty() && (!regExpMode || regExp.isValid());
+}
+
+//==============================================================================
+// Check Hit At Position - Middle Bytes & Word Boundaries
+//==============================================================================
+bool ContentMatcher::checkHit(const char* aData, const int& aLength, const int& aPos, const bool& aAtEnd) const
+{
+    // Get Pattern Length
+    int pLength = pattern.length();
+    // Get Pattern Data
+    const char* pData = pattern.constData();
+    // Get Text
+    const uchar* text = (const uchar*)aData + aPos;
+
+    // Check Case Sensitive
+    if (caseSensitive) {
+        // Compare Bytes
+        if (memcmp(text, pData, pLength) != 0) {
+            return false;
+        }
+
+    } else {
+        // Go Thru Pattern
+        for (int i=0; i<pLength; ++i) {
+            // Compare Folded Byte
+            if (cmFold(text[i]) != (uchar)pData[i]) {
+                return false;
+            }
+        }
+    }
+
+    // Check Whole Word
+    return !wholeWord || checkWordBoundaries(aData, aLength, aPos, aPos + pLength, aAtEnd);
+}
+
+//==============================================================================
+// Check Word Boundaries Around aPos..aEnd
+//==============================================================================
+bool ContentMatcher::checkWordBoundaries(const char* aData, const int& aLength, const int& aPos, const int& aEnd, const bool& aAtEnd) const
+{
+    // Check Preceding Byte - Chunked Callers Keep One Byte Before The Search Range
+    if (aPos > 0 && !cmIsBoundary((uchar)aData[aPos - 1])) {
+        return false;
+    }
+
+    // Check Trailing Byte
+    if (aEnd < aLength ? !cmIsBoundary((uchar)aData[aEnd]) : !aAtEnd) {
+        return false;
+    }
+
+    return true;
+}
+
+//==============================================================================
+// Find In Buffer - Positions From aFrom Up To aTo, Returns -1 If Not Found
+//==============================================================================
+int ContentMatcher::find(const char* aData, const int& aLength, const int& aFrom, const int& aTo, const bool& aAtEnd, int* aHitLength) const
+{
+    // Check Fold Units
+    if (!foldUnits.isEmpty()) {
+        // Init Hit Length
+        int hitLength = 0;
+        // Find Folded
+        int hit = findFolded(aData, aLength, aFrom, aTo, aAtEnd, hitLength);
+
+        // Check Hit Length
+        if (aHitLength) {
+            // Set Hit Length
+            *aHitLength = hitLength;
+        }
+
+        return hit;
+    }
+
+    // Get Pattern Length
+    int pLength = pattern.length();
+
+    // Check Hit Length
+    if (aHitLength) {
+        // Set Hit Length - Fixed For Byte Patterns
+        *aHitLength = pLength;
+    }
+
+    // Get Last Position - Pattern Must Fit
+    int to = qMin(aTo, aLength - pLength + 1);
+    // Init Position
+    int pos = aFrom;
+
+    // Check Pattern
+    if (pLength <= 0) {
+        return -1;
+    }
+
+#if defined(__SSE2__)
+
+    // Get First Byte
+    const __m128i firstByte = _mm_set1_epi8(pattern[0]);
+    // Get Last Byte
+    const __m128i lastByte  = _mm_set1_epi8(pattern[pLength - 1]);
+
+    // Go Thru Blocks Of 16 Positions - First & Last Byte Filter
+    while (pos + 16 <= to) {
+        // Load Blocks At First And Last Byte Offsets
+        __m128i firstBlock = _mm_loadu_si128((const __m128i*)(aData + pos));
+        __m128i lastBlock  = _mm_loadu_si128((const __m128i*)(aData + pos + pLength - 1));
+
+        // Check Case Sensitive
+        if (!caseSensitive) {
+            // Fold Blocks
+            firstBlock = cmFold16(firstBlock);
+            lastBlock  = cmFold16(lastBlock);
+        }
+
+        // Get Candidate Mask
+        int mask = _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(firstBlock, firstByte), _mm_cmpeq_epi8(lastBlock, lastByte)));
+
+        // Go Thru Candidates
+        while (mask) {
+            // Get Candidate Position
+            int candidate = pos + __builtin_ctz(mask);
+
+            // Check Hit
+            if (checkHit(aData, aLength, candidate, aAtEnd)) {
+                return candidate;
+            }
+
+            // Clear Lowest Bit
+            mask &= mask - 1;
+        }
+
+        // Next Block
+        pos += 16;
+    }
+
+    // Get First Pattern Byte
+    uchar first = (uchar)pattern[0];
+
+    // Go Thru Remaining Positions
+    for (; pos < to; ++pos) {
+        // Get Byte
+        uchar byte = caseSensitive ? (uchar)aData[pos] : cmFold((uchar)aData[pos]);
+
+        // Check Hit
+        if (byte == first && checkHit(aData, aLength, pos, aAtEnd)) {
+            return pos;
+        }
+    }
+
+#else // __SSE2__
+
+    // Get Last Pattern Byte
+    uchar last = (uchar)pattern[pLength - 1];
+
+    // Go Thru Positions - Horspool
+    while (pos < to) {
+        // Get Byte Under The Pattern End
+        uchar byte = caseSensitive ? (uchar)aData[pos + pLength - 1] : cmFold((uchar)aData[pos + pLength - 1]);
+
+        // Check Hit
+        if (byte == last && checkHit(aData, aLength, pos, aAtEnd)) {
+            return pos;
+        }
+
+        // Skip
+        pos += skipTable[byte];
+    }
+
+#endif // __SSE2__
+
+    return -1;
+}
+
+//==============================================================================
+// Find Folded - Case Variants Per Character, Returns Position & Hit Length
+//==============================================================================
+int ContentMatcher::findFolded(const char* aData, const int& aLength, const int& aFrom, const int& aTo, const bool& aAtEnd, int& aHitLength) const
+{
+    // Get Last Position
+    int to = qMin(aTo, aLength);
+    // Init Position
+    int pos = aFrom;
+
+#if defined(__SSE2__)
+
+    // Get First Unit
+    const QList<QByteArray>& firstUnit = foldUnits.first();
+    // Get Lead Byte
+    char lead = firstUnit.first()[0];
+    // Init Common Lead
+    bool commonLead = true;
+
+    // Go Thru First Unit Variants - Case Variants Mostly Share The Lead Byte
+    for (int i=1; i<firstUnit.count() && commonLead; ++i) {
+        // Check Lead Byte
+        commonLead = firstUnit[i][0] == lead;
+    }
+
+    // Check Common Lead
+    if (commonLead) {
+        // Get Lead Byte Block
+        const __m128i leadByte = _mm_set1_epi8(lead);
+
+        // Go Thru Blocks Of 16 Positions - Lead Byte Filter
+        while (pos + 16 <= to) {
+            // Get Candidate Mask
+            int mask = _mm_movemask_epi8(_mm_cmpeq_epi8(cmFold16(_mm_loadu_si128((const __m128i*)(aData + pos))), leadByte));
+
+            // Go Thru Candidates
+            while (mask) {
+                // Get Candidate Position
+                int candidate = pos + __builtin_ctz(mask);
+                // Match Fold Units
+                int hitLength = matchFoldUnits(aData, aLength, candidate);
+
+                // Check Hit
+                if (hitLength > 0 && (!wholeWord || checkWordBoundaries(aData, aLength, candidate, candidate + hitLength, aAtEnd))) {
+                    // Set Hit Length
+                    aHitLength = hitLength;
+
+                    return candidate;
+                }
+
+                // Clear Lowest Bit
+                mask &= mask - 1;
+            }
+
+            // Next Block
+            pos += 16;
+        }
+    }
+
+#endif // __SSE2__
+
+    // Go Thru Remaining Positions
+    for (; pos < to; ++pos) {
+        // Match Fold Units
+        int hitLength = matchFoldUnits(aData, aLength, pos);
+
+        // Check Hit
+        if (hitLength > 0 && (!wholeWord || checkWordBoundaries(aData, aLength, pos, pos + hitLength, aAtEnd))) {
+            // Set Hit Length
+            aHitLength = hitLength;
+
+            return pos;
+        }
+    }
+
+    return -1;
+}
+
+//==============================================================================
+// Match Fold Units At Position - Returns Hit Length Or -1
+//==============================================================================
+int ContentMatcher::matchFoldUnits(const char* aData, const int& aLength, const int& aPos) const
+{
+    // Init Position
+    int pos = aPos;
+
+    // Go Thru Fold Units
+    for (int i=0; i<foldUnits.count(); ++i) {
+        // Get Unit
+        const QList<QByteArray>& unit = foldUnits[i];
+        // Init Matched
+        bool matched = false;
+
+        // Go Thru Variants - Longest First
+        for (int j=0; j<unit.count() && !matched; ++j) {
+            // Get Variant Length
+            int vLength = unit[j].length();
+
+            // Check Room
+            if (pos + vLength > aLength) {
+                continue;
+            }
+
+            // Get Variant Data
+            const char* vData = unit[j].constData();
+            // Init Index
+            int k = 0;
+
+            // Compare Folded Bytes
+            while (k < vLength && cmFold((uchar)aData[pos + k]) == (uchar)vData[k]) {
+                k++;
+            }
+
+            // Check Matched
+            if (k == vLength) {
+                // Set Matched
+                matched = true;
+                // Inc Position
+                pos += vLength;
+            }
+        }
+
+        // Check Matched
+        if (!matched) {
+            return -1;
+        }
+    }
+
+    return pos - aPos;
+}
+
+//==============================================================================
+// Get Index Pattern - Bytes Every Hit Contains Up To ASCII Case, For Trigram Filtering
+//==============================================================================
+QByteArray ContentMatcher::indexPattern() const
+{
+    // Check Regular Expression Mode
+    if (regExpMode) {
+        return QByteArray();
+    }
+
+    // Check Multi Term Mode
+    if (multiTermMode) {
+        // Check All Terms - Any Single Term Is Required Then
+        if (!allTerms) {
+            return QByteArray();
+        }
+
+        // Init Best Pattern
+        QByteArray best;
+
+        // Go Thru Terms
+        for (int i=0; i<terms.count(); ++i) {
+            // Get Term Pattern
+            QByteArray termPattern = cmLongestAsciiRun(terms[i]);
+
+            // Check Length
+            if (termPattern.length() > best.length()) {
+                // Set Best Pattern
+                best = termPattern;
+            }
+        }
+
+        return best;
+    }
+
+    // Check Fold Units
+    if (foldUnits.isEmpty()) {
+        return pattern;
+    }
+
+    return cmLongestAsciiRun(pattern);
+}
+
+//==============================================================================
+// Find In File - Reads In Chunks, Stops At The First Hit, Returns Offset Or -1
+//==============================================================================
+qint64 ContentMatcher::findInFile(const int& aFd, const bool& aAbort, int& aLength, QList<int>* aTerms) const
+{
+    // Check Pattern & fd
+    if (!isValid() || aFd < 0) {
+        return -1;
+    }
+
+#if defined(Q_OS_LINUX)
+    // Read Ahead Aggressively
+    posix_fadvise(aFd, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif // Q_OS_LINUX
+
+    // Init Stream
+    ContentStream stream(aFd);
+
+    return findInStream(stream, aAbort, aLength, aTerms);
+}
+
+//==============================================================================
+// Find In Stream - Same As Find In File For Pipes & Bounded Archive Entries
+//==============================================================================
+qint64 ContentMatcher::findInStream(ContentStream& aStream, const bool& aAbort, int& aLength, QList<int>* aTerms) const
+{
+    // Check Pattern
+    if (!isValid()) {
+        return -1;
+    }
+
+    // Check Multi Term Mode
+    if (multiTermMode) {
+        return findTermsInStream(aStream, aAbort, aLength, aTerms);
+    }
+
+    // Check Regular Expression Mode
+    if (regExpMode) {
+        return findRegExpInStream(aStream, aAbort, aLength);
+    }
+
+    // Get Pattern Length - Longest Hit For Case Variants
+    int pLength = maxHitLength;
+    // Get Shortest Hit Length - Case Variants Are Bounds Checked Per Position
+    int minLength = foldUnits.isEmpty() ? pLength : 1;
+
+    // Init Buffer - One Chunk Plus The Carried Over Tail
+    QByteArray buffer(DEFAULT_CONTENT_SEARCH_CHUNK_SIZE + pLength + 1, '\0');
+    // Get Buffer Data
+    char* data = buffer.data();
+    // Get Buffer Size
+    int bSize = buffer.size();
+
+    // Init Buffer Length
+    int bLength = 0;
+    // Init Search From
+    int searchFrom = 0;
+    // Init Buffer Offset In File
+    qint64 base = 0;
+    // Init End Of File
+    bool eof = false;
+
+    // Read Chunks
+    while (!eof && !aAbort) {
+        // Read Into Free Space
+        qint64 bytesRead = aStream.read(data + bLength, bSize - bLength);
+
+        // Check Bytes Read
+        if (bytesRead < 0) {
+            return -1;
+        }
+
+        // Check End Of File
+        if (bytesRead == 0) {
+            // Set End Of File
+            eof = true;
+        } else {
+            // Inc Buffer Length
+            bLength += bytesRead;
+        }
+
+        // Get Search Limit - Keep The Trailing Byte Available Until The End
+        int limit = eof ? bLength - minLength + 1 : bLength - pLength;
+
+        // Check Limit
+        if (limit > searchFrom) {
+            // Init Hit Length
+            int hitLength = 0;
+            // Find
+            int hit = find(data, bLength, searchFrom, limit, eof, &hitLength);
+
+            // Check Hit
+            if (hit >= 0) {
+                // Set Length
+                aLength = hitLength;
+
+                return base + hit;
+            }
+        }
+
+        // Get Next Unsearched Position
+        int nextPos = qMax(limit, searchFrom);
+        // Get Keep From - One Byte Before For Word Boundaries
+        int keepFrom = nextPos > 0 ? nextPos - 1 : 0;
+
+        // Move Tail To The Front - Patterns Spanning Chunks Are Found Next Round
+        memmove(data, data + keepFrom, bLength - keepFrom);
+
+        // Adjust Buffer
+        bLength    -= keepFrom;
+        base       += keepFrom;
+        searchFrom  = nextPos - keepFrom;
+    }
+
+    return -1;
+}
+
+//==============================================================================
+// Find Terms In Stream - One Automaton Pass, Stops Once Every Term Is Found
+//==============================================================================
+qint64 ContentMatcher::findTermsInStream(ContentStream& aStream, const bool& aAbort, int& aLength, QList<int>* aTerms) const
+{
+    // Get Term Count
+    int tCount = terms.count();
+    // Get All Found Mask
+    quint64 allMask = tCount < 64 ? (Q_UINT64_C(1) << tCount) - 1 : ~Q_UINT64_C(0);
+    // Get Longest Pattern
+    int pLength = maxHitLength;
+
+    // Init Buffer - One Chunk Plus The Carried Over Tail
+    QByteArray buffer(DEFAULT_CONTENT_SEARCH_CHUNK_SIZE + pLength + 1, '\0');
+    // Get Buffer Data
+    char* data = buffer.data();
+    // Get Buffer Size
+    int bSize = buffer.size();
+
+    // Init Buffer Length
+    int bLength = 0;
+    // Init Search From
+    int searchFrom = 0;
+    // Init Buffer Offset In File
+    qint64 base = 0;
+    // Init End Of File
+    bool eof = false;
+    // Init Automaton State - Carried Across Chunks
+    int state = 0;
+
+    // Init Found Mask
+    quint64 found = 0;
+    // Init First Hit
+    qint64 firstOffset = -1;
+    int firstLength = 0;
+
+    // Read Chunks
+    while (!eof && !aAbort && found != allMask) {
+        // Read Into Free Space
+        qint64 bytesRead = aStream.read(data + bLength, bSize - bLength);
+
+        // Check Bytes Read
+        if (bytesRead < 0) {
+            return -1;
+        }
+
+        // Check End Of File
+        if (bytesRead == 0) {
+            // Set End Of File
+            eof = true;
+        } else {
+            // Inc Buffer Length
+            bLength += bytesRead;
+        }
+
+        // Get Search Limit - Keep The Trailing Byte Available Until The End
+        int limit = eof ? bLength : bLength - 1;
+
+        // Go Thru Bytes
+        for (int i=searchFrom; i<limit && found != allMask; ++i) {
+            // Next State
+            state = termAutomaton.next(state, (uchar)data[i]);
+
+            // Get Outputs
+            const QVector<int>& outputs = termAutomaton.outputs(state);
+
+            // Go Thru Outputs - Mostly None
+            for (int j=0; j<outputs.count(); ++j) {
+                // Get Term Bit
+                quint64 termBit = Q_UINT64_C(1) << termAutomaton.patternTerm(outputs[j]);
+
+                // Check Found
+                if (found & termBit) {
+                    continue;
+                }
+
+                // Get Pattern Length
+                int length = termAutomaton.patternLength(outputs[j]);
+                // Get Pattern Start
+                int start = i - length + 1;
+
+                // Check Whole Word
+                if (wholeWord && !checkWordBoundaries(data, bLength, start, i + 1, eof)) {
+                    continue;
+                }
+
+                // Add Term
+                found |= termBit;
+
+                // Check First Hit
+                if (firstOffset < 0) {
+                    // Set First Hit
+                    firstOffset = base + start;
+                    firstLength = length;
+                }
+            }
+        }
+
+        // Get Next Unsearched Position
+        int nextPos = qMax(limit, searchFrom);
+        // Get Keep From - Longest Pattern Plus One Byte Before For Word Boundaries
+        int keepFrom = qMax(nextPos - pLength, 0);
+
+        // Move Tail To The Front
+        memmove(data, data + keepFrom, bLength - keepFrom);
+
+        // Adjust Buffer
+        bLength    -= keepFrom;
+        base       += keepFrom;
+        searchFrom  = nextPos - keepFrom;
+    }
+
+    // Check Found - Every Term Or Any Term
+    if (allTerms ? found != allMask : found == 0) {
+        return -1;
+    }
+
+    // Check Terms
+    if (aTerms) {
+        // Reset Terms
+        aTerms->clear();
+
+        // Go Thru Terms
+        for (int i=0; i<tCount; ++i) {
+            // Check Found
+            if (found & (Q_UINT64_C(1) << i)) {
+                // Add Term
+                *aTerms << i;
+            }
+        }
+    }
+
+    // Set Length
+    aLength = firstLength;
+
+    return firstOffset;
+}
+
+//==============================================================================
+// Find Regular Expression In Stream - Line Aligned Chunks
+//==============================================================================
+qint64 ContentMatcher::findRegExpInStream(ContentStream& aStream, const bool& aAbort, int& aLength) const
+{
+    // Init Buffer
+    QByteArray buffer(DEFAULT_CONTENT_SEARCH_CHUNK_SIZE, '\0');
+    // Get Buffer Data
+    char* data = buffer.data();
+    // Get Buffer Size
+    int bSize = buffer.size();
+
+    // Init Buffer Length
+    int bLength = 0;
+    // Init Buffer Offset In File
+    qint64 base = 0;
+    // Init End Of File
+    bool eof = false;
+
+    // Read Chunks
+    while (!eof && !aAbort) {
+        // Read Into Free Space
+        qint64 bytesRead = aStream.read(data + bLength, bSize - bLength);
+
+        // Check Bytes Read
+        if (bytesRead < 0) {
+            return -1;
+        }
+
+        // Check End Of File
+        if (bytesRead == 0) {
+            // Set End Of File
+            eof = true;
+        } else {
+            // Inc Buffer Length
+            bLength += bytesRead;
+        }
+
+        // Init Lines Length - Everything At The End
+        int lLength = bLength;
+
+        // Check End Of File
+        if (!eof) {
+            // Find Last Line Break
+            while (lLength > 0 && data[lLength - 1] != '\n') {
+                lLength--;
+            }
+
+            // Check Lines Length - No Complete Line Yet
+            if (lLength == 0) {
+                // Check Free Space - Lines Longer Than A Chunk Are Split
+                if (bLength < bSize) {
+                    continue;
+                }
+
+                // Set Lines Length
+                lLength = bLength;
+            }
+        }
+
+        // Decode Complete Lines - Invalid Bytes Stay One Unit Each
+        QString text = cmDecodeUtf8(data, lLength);
+        // Match
+        QRegularExpressionMatch match = regExp.match(text);
+
+        // Check Match
+        if (match.hasMatch()) {
+            // Get Start In Bytes - Mapped Back Thru The Same Decoding
+            int start = cmUtf8ByteOffset(data, lLength, 0, match.capturedStart());
+            // Set Length In Bytes
+            aLength = cmUtf8ByteOffset(data, lLength, start, match.capturedLength()) - start;
+
+            return base + start;
+        }
+
+        // Move Partial Line To The Front
+        memmove(data, data + lLength, bLength - lLength);
+
+        // Adjust Buffer
+        bLength -= lLength;
+        base    += lLength;
+    }
+
+    return -1;
+}
+
+//==============================================================================
+// Locate Hit - Line Number & Snippet, Re-Reads The File Up To The Hit
+//==============================================================================
+void ContentMatcher::locateHit(const int& aFd, ContentHit& aHit)
+{
+    // Init Buffer
+    QByteArray buffer(DEFAULT_CONTENT_SEARCH_LOCATE_BUFFER_SIZE, '\0');
+    // Get Buffer Data
+    char* data = buffer.data();
+
+    // Init Position
+    qint64 pos = 0;
+    // Init Line Start
+    qint64 lineStart = 0;
+    // Init Line Breaks
+    qint64 lineBreaks = 0;
+
+    // Count Line Breaks Before The Hit
+    while (pos < aHit.offset) {
+        // Read
+        ssize_t bytesRead = pread(aFd, data, qMin((qint64)buffer.size(), aHit.offset - pos), pos);
+
+        // Check Interrupted
+        if (bytesRead < 0 && errno == EINTR) {
+            continue;
+        }
+
+        // Check Bytes Read
+        if (bytesRead <= 0) {
+            break;
+        }
+
+        // Go Thru Line Breaks
+        for (const char* lineBreak = (const char*)memchr(data, '\n', bytesRead); lineBreak; lineBreak = (const char*)memchr(lineBreak + 1, '\n', data + bytesRead - lineBreak - 1)) {
+            // Inc Line Breaks
+            lineBreaks++;
+            // Set Line Start
+            lineStart = pos + (lineBreak - data) + 1;
+        }
+
+        // Inc Position
+        pos += bytesRead;
+    }
+
+    // Set Line
+    aHit.line = lineBreaks + 1;
+
+    // Get Snippet Start - Line Start Or Half A Snippet Before The Hit
+    qint64 from = qMax(lineStart, aHit.offset - DEFAULT_CONTENT_SEARCH_SNIPPET_SIZE / 2);
+    // Get Hit End In Snippet - Long Hits Are Cut
+    int hitEnd = aHit.offset - from + qMin(aHit.length, (int)DEFAULT_CONTENT_SEARCH_SNIPPET_SIZE);
+
+    // Init Bytes Read
+    ssize_t bytesRead = -1;
+
+    // Read Snippet
+    do {
+        bytesRead = pread(aFd, data, qMin(hitEnd + DEFAULT_CONTENT_SEARCH_SNIPPET_SIZE / 2, buffer.size()), from);
+    } while (bytesRead < 0 && errno == EINTR);
+
+    // Check Bytes Read
+    if (bytesRead <= 0) {
+        return;
+    }
+
+    // Set Snippet
+    cmSetSnippet(aHit, data, bytesRead, from, lineStart, hitEnd);
+}
+
+//==============================================================================
+// Locate Hit In Stream - Line Number & Snippet, Stream Read From Its Start Up To Past The Hit
+//==============================================================================
+void ContentMatcher::locateHitInStream(ContentStream& aStream, ContentHit& aHit)
+{
+    // Get Context Size - Half A Snippet Each Side
+    const int contextSize = DEFAULT_CONTENT_SEARCH_SNIPPET_SIZE / 2;
+
+    // Init Buffer
+    QByteArray buffer(DEFAULT_CONTENT_SEARCH_LOCATE_BUFFER_SIZE, '\0');
+    // Get Buffer Data
+    char* data = buffer.data();
+
+    // Init Position
+    qint64 pos = 0;
+    // Init Line Start
+    qint64 lineStart = 0;
+    // Init Line Breaks
+    qint64 lineBreaks = 0;
+    // Init Tail - Bytes Just Before The Hit, Streams Can't Be Read Again
+    QByteArray tail;
+
+    // Count Line Breaks Before The Hit
+    while (pos < aHit.offset) {
+        // Read
+        qint64 bytesRead = aStream.read(data, qMin((qint64)buffer.size(), aHit.offset - pos));
+
+        // Check Bytes Read - Truncated
+        if (bytesRead <= 0) {
+            return;
+        }
+
+        // Go Thru Line Breaks
+        for (const char* lineBreak = (const char*)memchr(data, '\n', bytesRead); lineBreak; lineBreak = (const char*)memchr(lineBreak + 1, '\n', data + bytesRead - lineBreak - 1)) {
+            // Inc Line Breaks
+            lineBreaks++;
+            // Set Line Start
+            lineStart = pos + (lineBreak - data) + 1;
+        }
+
+        // Keep Tail
+        tail = bytesRead >= contextSize ? QByteArray(data + bytesRead - contextSize, contextSize) : (tail + QByteArray(data, bytesRead)).right(contextSize);
+
+        // Inc Position
+        pos += bytesRead;
+    }
+
+    // Set Line
+    aHit.line = lineBreaks + 1;
+
+    // Get Snippet Start - Line Start Or Half A Snippet Before The Hit
+    qint64 from = qMax(lineStart, aHit.offset - contextSize);
+    // Get Hit End In Snippet - Long Hits Are Cut
+    int hitEnd = aHit.offset - from + qMin(aHit.length, (int)DEFAULT_CONTENT_SEARCH_SNIPPET_SIZE);
+
+    // Init Snippet Data - Tail From The Snippet Start
+    QByteArray snippetData = tail.right(aHit.offset - from);
+    // Get Snippet Length
+    int sLength = snippetData.size();
+
+    // Resize Snippet Data - Hit Plus Context After It
+    snippetData.resize(hitEnd + contextSize);
+
+    // Read Rest Of The Snippet
+    while (sLength < snippetData.size()) {
+        // Read
+        qint64 bytesRead = aStream.read(snippetData.data() + sLength, snippetData.size() - sLength);
+
+        // Check Bytes Read
+        if (bytesRead <= 0) {
+            break;
+        }
+
+        // Inc Snippet Length
+        sLength += bytesRead;
+    }
+
+    // Set Snippet
+    cmSetSnippet(aHit, snippetData.constData(), sLength, from, lineStart, hitEnd);
+}
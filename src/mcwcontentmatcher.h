@@ -0,0 +1,165 @@
+#ifndef CONTENTMATCHER_H
+#define CONTENTMATCHER_H
+
+#include <QByteArray>
+#include <QString>
+#include <QVector>
+#include <QList>
+#include <QRegularExpression>
+
+#include "mcwtermautomaton.h"
+#include "mcwcontentclassifier.h"
+
+class QTextDecoder;
+
+
+//==============================================================================
+// Content Hit - Location Of The First Match In A File
+//==============================================================================
+class ContentHit
+{
+public:
+    // Constructor
+    ContentHit();
+
+    // Byte Offset
+    qint64      offset;
+    // Length In Bytes
+    int         length;
+    // Line Number - 1 Based
+    qint64      line;
+    // Snippet - Bounded Context Around The Match
+    QString     snippet;
+    // Terms - Indexes Of The Terms Found, Multi Term Searches Only
+    QList<int>  terms;
+};
+
+//==============================================================================
+// Content Stream - Sequential Reader Over An fd, Optionally Bounded, Head Can Be Peeked
+//==============================================================================
+class ContentStream
+{
+public:
+    // Constructor - Negative Limit Reads Up To The End
+    explicit ContentStream(const int& aFd, const qint64& aLimit = -1);
+
+    // Peek - Reads Up To aSize Bytes Ahead, Returned Again By read(), Always Raw Bytes
+    const QByteArray& peek(const int& aSize);
+
+    // Set Encoding - UTF-16 Is Transcoded To UTF-8 By read(), Offsets Are Then In The Transcoded Text
+    void setEncoding(const ContentEncoding& aEncoding);
+
+    // Read - Returns Bytes Read, 0 At The End, -1 On Error
+    qint64 read(char* aData, const qint64& aSize);
+
+    // Skip Rest - Seeks Or Reads Up To The Limit
+    bool skipRest();
+
+    // Get Remaining - Bytes Left In The fd Up To The Limit, -1 If Unbounded
+    qint64 remaining() const;
+
+    // Destructor
+    ~ContentStream();
+
+private:
+    // Read Raw - Peeked Head First, Then The fd
+    qint64 readRaw(char* aData, const qint64& aSize);
+
+private:
+    // fd
+    int                 streamFd;
+    // Limit
+    qint64              limit;
+    // Bytes Read From The fd
+    qint64              consumed;
+    // Peeked Head
+    QByteArray          head;
+    // Head Position
+    int                 headPos;
+    // Decoder - UTF-16 Only, NULL For UTF-8
+    QTextDecoder*       decoder;
+    // Raw Buffer - Undecoded Bytes
+    QByteArray          rawBuffer;
+    // Decoded - UTF-8 Not Yet Returned
+    QByteArray          decoded;
+    // Decoded Position
+    int                 decodedPos;
+};
+
+//==============================================================================
+// Content Matcher Class - Raw Byte Substring, Term Set Or Regular Expression Search
+//==============================================================================
+class ContentMatcher
+{
+public:
+    // Constructor - Pattern Is UTF-8, Compiled Once For Regular Expressions
+    ContentMatcher(const QByteArray& aPattern, const bool& aCaseSensitive, const bool& aWholeWord, const bool& aRegExp = false);
+    // Constructor - Multiple UTF-8 Terms, Matched In One Pass By An Aho-Corasick Automaton
+    ContentMatcher(const QList<QByteArray>& aTerms, const bool& aCaseSensitive, const bool& aWholeWord, const bool& aAllTerms);
+
+    // Is Valid
+    bool isValid() const;
+
+    // Find In Buffer - Positions From aFrom Up To aTo, Returns -1 If Not Found, Literal Only
+    int find(const char* aData, const int& aLength, const int& aFrom, const int& aTo, const bool& aAtEnd, int* aHitLength = NULL) const;
+
+    // Find In File - Reads In Chunks, Stops At The First Hit, Returns Offset Or -1, Found Terms Set In Multi Term Mode
+    qint64 findInFile(const int& aFd, const bool& aAbort, int& aLength, QList<int>* aTerms = NULL) const;
+
+    // Find In Stream - Same As Find In File For Pipes & Bounded Archive Entries
+    qint64 findInStream(ContentStream& aStream, const bool& aAbort, int& aLength, QList<int>* aTerms = NULL) const;
+
+    // Locate Hit - Line Number & Snippet, Re-Reads The File Up To The Hit
+    static void locateHit(const int& aFd, ContentHit& aHit);
+
+    // Locate Hit In Stream - Line Number & Snippet, Stream Read From Its Start Up To Past The Hit
+    static void locateHitInStream(ContentStream& aStream, ContentHit& aHit);
+
+    // Get Index Pattern - Bytes Every Hit Contains Up To ASCII Case, For Trigram Filtering
+    QByteArray indexPattern() const;
+
+private:
+    // Check Hit At Position - Middle Bytes & Word Boundaries
+    bool checkHit(const char* aData, const int& aLength, const int& aPos, const bool& aAtEnd) const;
+    // Check Word Boundaries Around aPos..aEnd
+    bool checkWordBoundaries(const char* aData, const int& aLength, const int& aPos, const int& aEnd, const bool& aAtEnd) const;
+
+    // Find Folded - Case Variants Per Character, Returns Position & Hit Length
+    int findFolded(const char* aData, const int& aLength, const int& aFrom, const int& aTo, const bool& aAtEnd, int& aHitLength) const;
+    // Match Fold Units At Position - Returns Hit Length Or -1
+    int matchFoldUnits(const char* aData, const int& aLength, const int& aPos) const;
+
+    // Find Terms In Stream - One Automaton Pass, Stops Once Every Term Is Found
+    qint64 findTermsInStream(ContentStream& aStream, const bool& aAbort, int& aLength, QList<int>* aTerms) const;
+
+    // Find Regular Expression In Stream - Line Aligned Chunks
+    qint64 findRegExpInStream(ContentStream& aStream, const bool& aAbort, int& aLength) const;
+
+private:
+    // Pattern - Folded If Case Insensitive
+    QByteArray          pattern;
+    // Case Sensitive
+    bool                caseSensitive;
+    // Whole Word
+    bool                wholeWord;
+    // Horspool Skip Table
+    QVector<int>        skipTable;
+    // Fold Units - UTF-8 Case Variants Per Character, Non-ASCII Case Insensitive Patterns Only
+    QVector<QList<QByteArray> > foldUnits;
+    // Max Hit Length - Longest Case Variant Of The Pattern
+    int                 maxHitLength;
+    // Regular Expression Mode
+    bool                regExpMode;
+    // Regular Expression
+    QRegularExpression  regExp;
+    // Multi Term Mode
+    bool                multiTermMode;
+    // All Terms - Every Term Must Be Found, Otherwise Any
+    bool                allTerms;
+    // Terms - Folded If Case Insensitive
+    QList<QByteArray>   terms;
+    // Term Automaton
+    TermAutomaton       termAutomaton;
+};
+
+#endif // CONTENTMATCHER_H
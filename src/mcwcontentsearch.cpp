@@ -0,0 +1,422 @@
+#include <QFile>
+#include <QRunnable>
+#include <QMutexLocker>
+#include <QDebug>
+
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "mcwcontentsearch.h"
+#include "mcwcontentmatcher.h"
+#include "mcwcontentclassifier.h"
+#include "mcwarchivesearch.h"
+#include "mcwdirscanner.h"
+#include "mcwconstants.h"
+
+
+//==============================================================================
+// Constructor
+//==============================================================================
+ContentSearchItem::ContentSearchItem()
+    : seq(0)
+    , hit(false)
+{
+}
+
+//==============================================================================
+// Content Search Task Class - One Per Matcher Thread
+//==============================================================================
+class ContentSearchTask : public QRunnable
+{
+public:
+    // Constructor
+    ContentSearchTask(ContentSearchPool* aPool)
+        : searchPool(aPool)
+    {
+    }
+
+    // Run
+    virtual void run()
+    {
+        // Init Content Classifier - One Per Thread
+        ContentClassifier classifier;
+
+        // Main Loop
+        forever {
+            // Init Item
+            ContentSearchItem item;
+
+            // Lock Mutex
+            searchPool->mutex.lock();
+
+            // Wait For Files
+            while (searchPool->queue.isEmpty() && !searchPool->closed && !searchPool->abortFlag) {
+                // Wait - Timed So Aborts Are Noticed
+                searchPool->notEmpty.wait(&searchPool->mutex, DEFAULT_CONTENT_SEARCH_WAIT_MS);
+            }
+
+            // Check Abort & Queue
+            if (searchPool->abortFlag || searchPool->queue.isEmpty()) {
+                // Unlock Mutex
+                searchPool->mutex.unlock();
+
+                break;
+            }
+
+            // Take Next File
+            item = searchPool->queue.dequeue();
+
+            // Unlock Mutex
+            searchPool->mutex.unlock();
+
+            // Open File - Non Blocking, A FIFO Without A Writer Would Block The Thread Beyond Aborts
+            int fd = open(QFile::encodeName(item.filePath).constData(), O_RDONLY | O_CLOEXEC | O_NONBLOCK);
+
+            // Init Stat
+            struct stat fileStat;
+
+            // Check fd & Regular File - FIFOs, Sockets & Devices Are Never Searched
+            if (fd >= 0 && (fstat(fd, &fileStat) != 0 || !S_ISREG(fileStat.st_mode))) {
+                // Close fd
+                close(fd);
+                // Reset fd
+                fd = -1;
+            }
+
+            // Check fd
+            if (fd >= 0) {
+                // Init Encoding
+                ContentEncoding encoding = ECEUTF8;
+
+                // Check Searchable - Sniffed, Binary Files Are Skipped
+                if (!classifier.isSearchable(fd, item.filePath, &encoding)) {
+                    // Search Compressed - Binary To The Classifier, Text Once Decompressed
+                    searchCompressed(fd, item);
+
+                // Check Encoding
+                } else if (encoding != ECEUTF8) {
+                    // Search Transcoded - UTF-16 Text Matched As UTF-8
+                    searchTranscoded(fd, encoding, item);
+
+                } else {
+                    // Init Length
+                    int length = 0;
+                    // Find Content
+                    qint64 offset = searchPool->matcher.findInFile(fd, searchPool->abortFlag, length, &item.contentHit.terms);
+
+                    // Check Offset
+                    if (offset >= 0) {
+                        // Set Hit
+                        item.hit = true;
+                        // Set Content Hit Offset & Length
+                        item.contentHit.offset = offset;
+                        item.contentHit.length = length;
+                        // Locate Hit - Line & Snippet
+                        ContentMatcher::locateHit(fd, item.contentHit);
+                    }
+                }
+
+                // Close fd
+                close(fd);
+            }
+
+            // Lock Mutex
+            searchPool->mutex.lock();
+
+            // Check Ordered - Misses Are Kept To Advance The Order
+            if (searchPool->ordered || item.hit) {
+                // Store Result
+                searchPool->results.insert(item.seq, item);
+            }
+
+            // Wake Walker
+            searchPool->notFull.wakeOne();
+
+            // Unlock Mutex
+            searchPool->mutex.unlock();
+        }
+    }
+
+    // Search Transcoded - UTF-16 Files Streamed Thru A Decoder, Offsets Are In The UTF-8 Text
+    void searchTranscoded(const int& aFd, const ContentEncoding& aEncoding, ContentSearchItem& aItem)
+    {
+        // Init Stream
+        ContentStream stream(aFd);
+        // Set Encoding
+        stream.setEncoding(aEncoding);
+
+        // Init Length
+        int length = 0;
+        // Find Content
+        qint64 offset = searchPool->matcher.findInStream(stream, searchPool->abortFlag, length, &aItem.contentHit.terms);
+
+        // Check Offset
+        if (offset < 0) {
+            return;
+        }
+
+        // Set Hit
+        aItem.hit = true;
+        // Set Content Hit Offset & Length
+        aItem.contentHit.offset = offset;
+        aItem.contentHit.length = length;
+
+        // Rewind File
+        if (lseek(aFd, 0, SEEK_SET) < 0) {
+            return;
+        }
+
+        // Init Locate Stream
+        ContentStream locateStream(aFd);
+        // Set Encoding
+        locateStream.setEncoding(aEncoding);
+        // Locate Hit - Line & Snippet
+        ContentMatcher::locateHitInStream(locateStream, aItem.contentHit);
+    }
+
+    // Search Compressed - gzip, bzip2 & xz Streamed Thru A Decompressor, Killed At The First Hit
+    void searchCompressed(const int& aFd, ContentSearchItem& aItem)
+    {
+        // Check Archive - Compressed Tars Are Left To The Archive Search
+        if (ArchiveSearch::isSupported(aItem.filePath)) {
+            return;
+        }
+
+        // Get Decompressor - By Magic Bytes
+        QByteArray decompressor = ArchiveSearch::decompressorFor(aFd);
+
+        // Check Decompressor
+        if (decompressor.isEmpty()) {
+            return;
+        }
+
+        // Init Process
+        ArchiveProcess process;
+
+        // Start Decompressor - File As stdin, Nothing Written To Disk
+        if (!process.start(QList<QByteArray>() << decompressor << "-dc", aFd)) {
+            return;
+        }
+
+        // Init Stream
+        ContentStream stream(process.outputFd());
+        // Peek Decompressed Head
+        const QByteArray& head = stream.peek(DEFAULT_CONTENT_SNIFF_SIZE);
+
+        // Init Encoding
+        ContentEncoding encoding = ECEUTF8;
+
+        // Check Head - Compressed Binaries Are Skipped
+        if (head.isEmpty() || ContentClassifier::sniff(head.constData(), head.size(), head.size() < DEFAULT_CONTENT_SNIFF_SIZE, &encoding) == ECSRBinary) {
+            return;
+        }
+
+        // Set Encoding - Compressed UTF-16 Text
+        stream.setEncoding(encoding);
+
+        // Init Length
+        int length = 0;
+        // Find Content
+        qint64 offset = searchPool->matcher.findInStream(stream, searchPool->abortFlag, length, &aItem.contentHit.terms);
+
+        // Stop Decompressor - Killed Unless It Already Finished
+        process.stop(true);
+
+        // Check Offset
+        if (offset < 0) {
+            return;
+        }
+
+        // Set Hit
+        aItem.hit = true;
+        // Set Content Hit Offset & Length
+        aItem.contentHit.offset = offset;
+        aItem.contentHit.length = length;
+
+        // Rewind File - The Decompressor Shared The File Offset
+        if (lseek(aFd, 0, SEEK_SET) < 0) {
+            return;
+        }
+
+        // Init Locate Process
+        ArchiveProcess locateProcess;
+
+        // Start Decompressor Again - Line & Snippet, Decompressed Up To The Hit Only
+        if (locateProcess.start(QList<QByteArray>() << decompressor << "-dc", aFd)) {
+            // Init Locate Stream
+            ContentStream locateStream(locateProcess.outputFd());
+            // Set Encoding
+            locateStream.setEncoding(encoding);
+            // Locate Hit
+            ContentMatcher::locateHitInStream(locateStream, aItem.contentHit);
+        }
+    }
+
+    // Search Pool
+    ContentSearchPool*  searchPool;
+};
+
+//==============================================================================
+// Constructor
+//==============================================================================
+ContentSearchPool::ContentSearchPool(const QString& aDirPath,
+                                     const ContentMatcher& aMatcher,
+                                     const bool& aOrdered,
+                                     const bool& aAbort,
+                                     fileSearchItemFoundCallback aCallback,
+                                     void* aContext)
+    : matcher(aMatcher)
+    , ordered(aOrdered)
+    , abortFlag(aAbort)
+    , callback(aCallback)
+    , context(aContext)
+    , nextSeq(0)
+    , nextReport(0)
+    , closed(false)
+{
+    // Get Thread Count - Same Device Heuristic As The Size Scan
+    int tCount = qMin(DirSizeScanner::threadCount(aDirPath), DEFAULT_CONTENT_SEARCH_MAX_THREADS);
+
+    qDebug() << "ContentSearchPool::ContentSearchPool - aDirPath: " << aDirPath << " - tCount: " << tCount << " - aOrdered: " << aOrdered;
+
+    // Set Max Thread Count
+    pool.setMaxThreadCount(tCount);
+
+    // Start Tasks
+    for (int i=0; i<tCount; ++i) {
+        pool.start(new ContentSearchTask(this));
+    }
+}
+
+//==============================================================================
+// Add File - Blocks While The Queue Is Full, Reports Results Meanwhile
+//==============================================================================
+void ContentSearchPool::add(const QString& aDirPath, const QString& aFilePath)
+{
+    // Report Results
+    reportResults();
+
+    // Lock Mutex
+    mutex.lock();
+
+    // Wait While Full - Unreported Results Count Too, Ordered Mode Holds Them Back
+    while (queue.count() + results.count() >= DEFAULT_CONTENT_SEARCH_QUEUE_SIZE && !abortFlag) {
+        // Wait
+        notFull.wait(&mutex, DEFAULT_CONTENT_SEARCH_WAIT_MS);
+
+        // Unlock Mutex
+        mutex.unlock();
+        // Report Results
+        reportResults();
+        // Lock Mutex
+        mutex.lock();
+    }
+
+    // Init Item
+    ContentSearchItem item;
+
+    // Setup Item
+    item.seq        = nextSeq++;
+    item.dirPath    = aDirPath;
+    item.filePath   = aFilePath;
+
+    // Enqueue Item
+    queue.enqueue(item);
+
+    // Wake A Matcher
+    notEmpty.wakeOne();
+
+    // Unlock Mutex
+    mutex.unlock();
+}
+
+//==============================================================================
+// Finish - Waits For The Matcher Threads, Reports Remaining Results
+//==============================================================================
+void ContentSearchPool::finish()
+{
+    // Lock Mutex
+    mutex.lock();
+    // Set Closed
+    closed = true;
+    // Wake All Matchers
+    notEmpty.wakeAll();
+    // Unlock Mutex
+    mutex.unlock();
+
+    // Wait For Matchers - Report Results Meanwhile
+    while (!pool.waitForDone(DEFAULT_CONTENT_SEARCH_WAIT_MS)) {
+        // Report Results
+        reportResults();
+    }
+
+    // Report Results
+    reportResults();
+}
+
+//==============================================================================
+// Report Results - Caller Thread Only
+//==============================================================================
+void ContentSearchPool::reportResults()
+{
+    // Init Hits
+    QList<ContentSearchItem> hits;
+
+    // Lock Mutex
+    mutex.lock();
+
+    // Check Ordered
+    if (ordered) {
+        // Go Thru Finished Prefix
+        while (!results.isEmpty() && results.firstKey() == nextReport) {
+            // Take Result
+            ContentSearchItem item = results.take(nextReport++);
+
+            // Check Hit
+            if (item.hit) {
+                // Add Hit
+                hits << item;
+            }
+        }
+
+    } else {
+        // Take All Hits
+        hits = results.values();
+        // Clear Results
+        results.clear();
+    }
+
+    // Unlock Mutex
+    mutex.unlock();
+
+    // Check Callback
+    if (!callback) {
+        return;
+    }
+
+    // Go Thru Hits
+    for (int i=0; i<hits.count() && !abortFlag; ++i) {
+        // Callback
+        callback(hits[i].dirPath, hits[i].filePath, &hits[i].contentHit, context);
+    }
+}
+
+//==============================================================================
+// Destructor
+//==============================================================================
+ContentSearchPool::~ContentSearchPool()
+{
+    // Lock Mutex
+    mutex.lock();
+    // Set Closed
+    closed = true;
+    // Wake All Matchers
+    notEmpty.wakeAll();
+    // Unlock Mutex
+    mutex.unlock();
+
+    // Wait For Matchers
+    pool.waitForDone();
+}
@@ -0,0 +1,99 @@
+#ifndef CONTENTSEARCH_H
+#define CONTENTSEARCH_H
+
+#include <QString>
+#include <QQueue>
+#include <QMap>
+#include <QList>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QThreadPool>
+
+#include "mcwutility.h"
+#include "mcwcontentmatcher.h"
+
+class ContentSearchTask;
+
+
+//==============================================================================
+// Content Search Item
+//==============================================================================
+class ContentSearchItem
+{
+public:
+    // Constructor
+    ContentSearchItem();
+
+    // Sequence Number - Discovery Order
+    quint64     seq;
+    // Dir Path
+    QString     dirPath;
+    // File Path
+    QString     filePath;
+    // Hit
+    bool        hit;
+    // Content Hit - Location & Snippet
+    ContentHit  contentHit;
+};
+
+//==============================================================================
+// Content Search Pool Class - Walker Feeds Matcher Threads Thru A Bounded Queue
+//==============================================================================
+class ContentSearchPool
+{
+public:
+    // Constructor
+    ContentSearchPool(const QString& aDirPath,
+                      const ContentMatcher& aMatcher,
+                      const bool& aOrdered,
+                      const bool& aAbort,
+                      fileSearchItemFoundCallback aCallback = NULL,
+                      void* aContext = NULL);
+
+    // Add File - Blocks While The Queue Is Full, Reports Results Meanwhile
+    void add(const QString& aDirPath, const QString& aFilePath);
+
+    // Finish - Waits For The Matcher Threads, Reports Remaining Results
+    void finish();
+
+    // Destructor
+    ~ContentSearchPool();
+
+private:
+    friend class ContentSearchTask;
+
+    // Report Results - Caller Thread Only
+    void reportResults();
+
+private:
+    // Matcher
+    const ContentMatcher&           matcher;
+    // Ordered
+    bool                            ordered;
+    // Abort Flag
+    const bool&                     abortFlag;
+    // Callback
+    fileSearchItemFoundCallback     callback;
+    // Callback Context
+    void*                           context;
+    // Mutex
+    QMutex                          mutex;
+    // Not Empty Condition
+    QWaitCondition                  notEmpty;
+    // Not Full Condition
+    QWaitCondition                  notFull;
+    // Queue
+    QQueue<ContentSearchItem>       queue;
+    // Results - Keyed By Sequence Number
+    QMap<quint64, ContentSearchItem> results;
+    // Next Sequence Number
+    quint64                         nextSeq;
+    // Next Sequence Number To Report - Ordered Only
+    quint64                         nextReport;
+    // Closed - No More Files
+    bool                            closed;
+    // Thread Pool
+    QThreadPool                     pool;
+};
+
+#endif // CONTENTSEARCH_H
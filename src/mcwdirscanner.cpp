@@ -0,0 +1,817 @@
+#include <QFile>
+#include <QFileInfo>
+#include <QDateTime>
+#include <QThread>
+#include <QThreadPool>
+#include <QRunnable>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QtAlgorithms>
+#include <QHash>
+#include <QDebug>
+
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#if defined(Q_OS_LINUX)
+#include <sys/sysmacros.h>
+#endif // Q_OS_LINUX
+
+#include "mcwdirscanner.h"
+#include "mcwstatbatch.h"
+#include "mcwsizecache.h"
+#include "mcwignorerules.h"
+#include "mcwconstants.h"
+
+
+//==============================================================================
+// Dir Scan Node Class - One Per Dir, Lives Until Its Subtree Is Done
+//==============================================================================
+class DirScanNode
+{
+public:
+    // Constructor
+    DirScanNode(DirScanNode* aParent, const QString& aPath, const QByteArray& aName)
+        : parent(aParent)
+        , path(aPath)
+        , name(aName)
+        , depth(aParent ? aParent->depth + 1 : 0)
+        , size(0)
+        , numFiles(0)
+        , numDirs(0)
+        , remaining(1)
+    {
+    }
+
+    // Parent
+    DirScanNode*                parent;
+    // Dir Path
+    QString                     path;
+    // Dir Name
+    QByteArray                  name;
+    // Depth
+    int                         depth;
+    // Subtree Size - Children Add Theirs When Done
+    QAtomicInteger<quint64>     size;
+    // Subtree Num Files
+    QAtomicInteger<quint64>     numFiles;
+    // Subtree Num Dirs
+    QAtomicInteger<quint64>     numDirs;
+    // Remaining - Own Scan Plus Unfinished Children
+    QAtomicInt                  remaining;
+    // Children Mutex
+    QMutex                      mutex;
+    // Finished Children - Only Kept For Breakdown
+    DirSizeBreakdownList        children;
+    // Ignore Rules - Set When The Dir Is Scanned, Read By Its Children
+    QSharedPointer<const IgnoreRules> rules;
+};
+
+//==============================================================================
+// Breakdown Item Greater Than By Size
+//==============================================================================
+static bool breakdownItemGreaterThan(const DirSizeBreakdownItem& a, const DirSizeBreakdownItem& b)
+{
+    return a.size > b.size;
+}
+
+//==============================================================================
+// Dir Scan Task Class - One Per Scanner Thread
+//==============================================================================
+class DirScanTask : public QRunnable
+{
+public:
+    // Constructor
+    DirScanTask(DirSizeScanner* aScanner, const int& aIndex)
+        : scanner(aScanner)
+        , index(aIndex)
+        , numDirs(0)
+        , numFiles(0)
+        , scannedSize(0)
+        , publishedDirs(0)
+        , publishedFiles(0)
+        , publishedSize(0)
+    {
+        // Owned By The Scanner
+        setAutoDelete(false);
+    }
+
+    // Push Dir - Owner End
+    void push(DirScanNode* aNode)
+    {
+        // Init Locker
+        QMutexLocker locker(&mutex);
+        // Append Dir
+        dirs << aNode;
+    }
+
+    // Pop Dir - Owner End, Depth First
+    bool pop(DirScanNode*& aNode)
+    {
+        // Init Locker
+        QMutexLocker locker(&mutex);
+
+        // Check Dirs
+        if (dirs.isEmpty()) {
+            return false;
+        }
+
+        // Take Last
+        aNode = dirs.takeLast();
+
+        return true;
+    }
+
+    // Steal Dir - Thief End, Oldest And Usually Largest Subtree
+    bool stealFrom(DirScanNode*& aNode)
+    {
+        // Init Locker
+        QMutexLocker locker(&mutex);
+
+        // Check Dirs
+        if (dirs.isEmpty()) {
+            return false;
+        }
+
+        // Take First
+        aNode = dirs.takeFirst();
+
+        return true;
+    }
+
+    // Run
+    virtual void run()
+    {
+        // Init Node
+        DirScanNode* node = NULL;
+        // Init Idle Sleep
+        unsigned long idleSleep = 0;
+
+        // Check Background - Pool Threads Die With The Scan
+        if (scanner->background) {
+            // Set Priority
+            QThread::currentThread()->setPriority(QThread::IdlePriority);
+        }
+
+        // Main Loop
+        while (!scanner->abortFlag) {
+            // Get Next Dir - Own Queue First, Then Steal
+            if (!pop(node) && !scanner->steal(index, node)) {
+                // Check Pending - Everything Scanned
+                if (scanner->pending.load() <= 0) {
+                    break;
+                }
+
+                // Back Off A Bit
+                idleSleep = qMin<unsigned long>(idleSleep + DEFAULT_DIR_SCAN_IDLE_SLEEP_US, DEFAULT_DIR_SCAN_IDLE_SLEEP_US * 16);
+                // Sleep
+                QThread::usleep(idleSleep);
+
+                continue;
+            }
+
+            // Reset Idle Sleep
+            idleSleep = 0;
+
+            // Scan Dir
+            scanDir(node);
+
+            // Finish Node - Own Part Done
+            scanner->finishNode(node);
+
+            // Dir Done - Last One Wakes The Scanner
+            if (!scanner->pending.deref()) {
+                // Release Done
+                scanner->done.release();
+            }
+        }
+    }
+
+    // Queue Sub Dir
+    void queueSubDir(DirScanNode* aNode, const QString& aDirPrefix, const QByteArray& aName)
+    {
+        // Inc Num Dirs
+        numDirs++;
+        // Inc Remaining Before Queueing
+        aNode->remaining.ref();
+        // Inc Pending Before Queueing
+        scanner->pending.ref();
+        // Push Sub Dir
+        push(new DirScanNode(aNode, aDirPrefix + QFile::decodeName(aName), aName));
+    }
+
+    // Add File To Histograms - Breakdown Only
+    void addFileStats(const QString& aDirPrefix, const QByteArray& aName, const quint64& aSize)
+    {
+        // Get Suffix Position - Leading Dot Is Not A Suffix
+        int suffixPos = aName.lastIndexOf('.');
+        // Get Type
+        DirSizeBreakdownItem& typeItem = typeStats[suffixPos > 0 ? aName.mid(suffixPos + 1).toLower() : QByteArray()];
+
+        // Add To Type
+        typeItem.numFiles++;
+        typeItem.size += aSize;
+
+        // Check Largest - Path Is Only Built For Candidates
+        if (largest.count() >= scanner->breakdownTopCount && aSize <= largest.last().size) {
+            return;
+        }
+
+        // Init Item
+        DirSizeBreakdownItem item;
+
+        // Setup Item
+        item.name       = aDirPrefix + QFile::decodeName(aName);
+        item.size       = aSize;
+        item.numFiles   = 1;
+
+        // Insert Sorted By Size
+        largest.insert(qLowerBound(largest.begin(), largest.end(), item, breakdownItemGreaterThan), item);
+
+        // Check Count
+        if (largest.count() > scanner->breakdownTopCount) {
+            // Remove Smallest
+            largest.removeLast();
+        }
+    }
+
+    // Scan Single Dir
+    void scanDir(DirScanNode* aNode)
+    {
+        // Init Dir Prefix
+        QString dirPrefix = aNode->path.endsWith("/") ? aNode->path : aNode->path + "/";
+        // Breakdown Needs Every File - Cached Dirs Only Have Totals
+        bool breakdown = scanner->breakdownDepth >= 0;
+
+        // Set Ignore Rules - Ignore Files Of The Dir Are Read By The Task Scanning It
+        aNode->rules = IgnoreRules::forDir(aNode->parent ? aNode->parent->rules : scanner->ignoreRules, aNode->path);
+        // Get Filtered - Cached Totals Include Excluded Entries, Filtered Totals Are Not Cached
+        bool filtered = !aNode->rules.isNull();
+
+        // Init Cache Key
+        DirSizeCacheKey cacheKey;
+        // Init Cache Item
+        DirSizeCacheItem cacheItem;
+
+        // Stat Dir For The Cache
+        bool cacheKeyValid = DirSizeCache::statDir(aNode->path, cacheKey, cacheItem.lastModified);
+
+        // Look Up Cache - Dir Not Modified Since Last Scan
+        if (cacheKeyValid && !breakdown && !filtered && DirSizeCache::instance()->lookup(cacheKey, cacheItem.lastModified, cacheItem)) {
+            // Add Cached Files
+            numFiles += cacheItem.numFiles;
+            // Add Cached Size
+            scannedSize += cacheItem.fileSize;
+
+            // Add Own Files To Node
+            aNode->numFiles.fetchAndAddOrdered(cacheItem.numFiles);
+            aNode->size.fetchAndAddOrdered(cacheItem.fileSize);
+            aNode->numDirs.fetchAndAddOrdered(cacheItem.subDirs.count());
+
+            // Go Thru Sub Dirs - Validated On Their Own
+            for (int i=0; i<cacheItem.subDirs.count(); ++i) {
+                // Queue Sub Dir
+                queueSubDir(aNode, dirPrefix, cacheItem.subDirs[i]);
+            }
+
+            // Publish Counters
+            publishedDirs.store(numDirs);
+            publishedFiles.store(numFiles);
+            publishedSize.store(scannedSize);
+
+            return;
+        }
+
+        // Init Entries
+        StatBatchList entries;
+
+        // Read Dir Entries
+        if (!readDirEntries(aNode->path, entries)) {
+            return;
+        }
+
+        // Stat Entries
+        statBatch(aNode->path, entries, scanner->statDepth, scanner->abortFlag);
+
+        // Get Entries Count
+        int eCount = entries.count();
+
+        // Go Thru Entries
+        for (int i=0; i<eCount && !scanner->abortFlag; ++i) {
+            // Get Entry
+            const StatBatchEntry& entry = entries[i];
+
+            // Check Entry
+            if (!entry.valid) {
+                continue;
+            }
+
+            // Check Excluded - Excluded Subtrees Are Neither Counted Nor Opened
+            if (filtered) {
+                // Get Name
+                QString name = QFile::decodeName(entry.name);
+
+                // Check Rules
+                if (aNode->rules->isExcluded(dirPrefix + name, name, entry.isDir && !entry.isSymLink)) {
+                    continue;
+                }
+            }
+
+            // Check If Is Dir - Links Are Not Followed
+            if (entry.isDir && !entry.isSymLink) {
+                // Queue Sub Dir
+                queueSubDir(aNode, dirPrefix, entry.name);
+                // Add Sub Dir To Cache Item
+                cacheItem.subDirs << entry.name;
+            } else {
+                // Inc Num Files
+                numFiles++;
+                // Add File Size
+                scannedSize += entry.size;
+                // Add File To Cache Item
+                cacheItem.numFiles++;
+                cacheItem.fileSize += entry.size;
+
+                // Check Breakdown
+                if (breakdown) {
+                    // Add File Stats
+                    addFileStats(dirPrefix, entry.name, entry.size);
+                }
+            }
+        }
+
+        // Add Own Files To Node
+        aNode->numFiles.fetchAndAddOrdered(cacheItem.numFiles);
+        aNode->size.fetchAndAddOrdered(cacheItem.fileSize);
+        aNode->numDirs.fetchAndAddOrdered(cacheItem.subDirs.count());
+
+        // Check Cache Key, Filter & Abort - Partial & Filtered Results Are Not Cached
+        if (cacheKeyValid && !filtered && !scanner->abortFlag) {
+            // Set Scan Time
+            cacheItem.scanTime = QDateTime::currentMSecsSinceEpoch() / 1000;
+            // Insert Into Cache
+            DirSizeCache::instance()->insert(cacheKey, cacheItem);
+        }
+
+        // Publish Counters - Single Writer, Read By The Progress Loop
+        publishedDirs.store(numDirs);
+        publishedFiles.store(numFiles);
+        publishedSize.store(scannedSize);
+    }
+
+    // Scanner
+    DirSizeScanner*                             scanner;
+    // Task Index
+    int                                         index;
+    // Mutex
+    QMutex                                      mutex;
+    // Dirs
+    QList<DirScanNode*>                         dirs;
+    // Num Dirs - Owner Only
+    quint64                                     numDirs;
+    // Num Files - Owner Only
+    quint64                                     numFiles;
+    // Scanned Size - Owner Only
+    quint64                                     scannedSize;
+    // Published Num Dirs
+    QAtomicInteger<quint64>                     publishedDirs;
+    // Published Num Files
+    QAtomicInteger<quint64>                     publishedFiles;
+    // Published Scanned Size
+    QAtomicInteger<quint64>                     publishedSize;
+    // File Type Stats - Owner Only, Merged After The Scan
+    QHash<QByteArray, DirSizeBreakdownItem>     typeStats;
+    // Largest Files - Owner Only, Merged After The Scan
+    DirSizeBreakdownList                        largest;
+};
+
+//==============================================================================
+// Constructor
+//==============================================================================
+DirSizeScanner::DirSizeScanner(const bool& aAbort, dirSizeScanProgressCallback aCallback, void* aContext)
+    : abortFlag(aAbort)
+    , callback(aCallback)
+    , context(aContext)
+    , pending(0)
+    , statDepth(1)
+    , background(false)
+    , breakdownDepth(-1)
+    , breakdownTopCount(DEFAULT_DIR_BREAKDOWN_TOP_COUNT)
+    , breakdownCallback(NULL)
+    , rootDone(false)
+{
+}
+
+//==============================================================================
+// Set Background - Fewer Idle Priority Threads, Cache Is Saved By The Caller
+//==============================================================================
+void DirSizeScanner::setBackground(const bool& aBackground)
+{
+    // Set Background
+    background = aBackground;
+}
+
+//==============================================================================
+// Set Ignore Rules - Excluded Entries Are Not Counted, Excluded Dirs Not Opened, Cache Bypassed
+//==============================================================================
+void DirSizeScanner::setIgnoreRules(const QSharedPointer<const IgnoreRules>& aIgnoreRules)
+{
+    // Set Ignore Rules
+    ignoreRules = aIgnoreRules;
+}
+
+//==============================================================================
+// Set Breakdown - Subtrees Down To Depth Are Reported As They Complete
+//==============================================================================
+void DirSizeScanner::setBreakdown(const int& aDepth, const int& aTopCount, dirSizeBreakdownCallback aCallback)
+{
+    // Set Breakdown Depth
+    breakdownDepth      = aCallback ? aDepth : -1;
+    // Set Breakdown Top Count
+    breakdownTopCount   = aTopCount > 0 ? aTopCount : DEFAULT_DIR_BREAKDOWN_TOP_COUNT;
+    // Set Breakdown Callback
+    breakdownCallback   = aCallback;
+}
+
+//==============================================================================
+// Scan Dir Size
+//==============================================================================
+quint64 DirSizeScanner::scan(const QString& aDirPath, quint64& aNumDirs, quint64& aNumFiles)
+{
+    // Init Rotating
+    bool rotating = false;
+    // Get Thread Count
+    int tCount = threadCount(aDirPath, &rotating);
+
+    // Check Background
+    if (background) {
+        // Bound Thread Count
+        tCount = qMin(tCount, DEFAULT_DIR_SIZE_BACKGROUND_THREADS);
+    }
+
+    // Set Stat Depth - Rotating Disks Get One Stat At A Time, Threads Already Keep Enough Syscalls In Flight Without io_uring
+    statDepth = (!rotating && (tCount <= 1 || statBatchUringAvailable())) ? statBatchQueueDepth() : 1;
+
+    qDebug() << "DirSizeScanner::scan - aDirPath: " << aDirPath << " - tCount: " << tCount << " - statDepth: " << statDepth << " - breakdownDepth: " << breakdownDepth;
+
+    // Create Tasks
+    for (int i=0; i<tCount; ++i) {
+        tasks << new DirScanTask(this, i);
+    }
+
+    // Queue Root Dir
+    pending.store(1);
+    tasks[0]->push(new DirScanNode(NULL, aDirPath, QFile::encodeName(aDirPath)));
+
+    // Init Thread Pool
+    QThreadPool pool;
+    // Set Max Thread Count
+    pool.setMaxThreadCount(tCount);
+
+    // Start Tasks
+    for (int i=0; i<tCount; ++i) {
+        pool.start(tasks[i]);
+    }
+
+    // Init Counters
+    quint64 numDirs  = 0;
+    quint64 numFiles = 0;
+    quint64 result   = 0;
+
+    // Wait For Done - Report Progress Periodically
+    while (!done.tryAcquire(1, DEFAULT_DIR_SCAN_PROGRESS_INTERVAL_MS)) {
+        // Check Abort
+        if (abortFlag) {
+            break;
+        }
+
+        // Check Callback
+        if (callback) {
+            // Reset Counters
+            numDirs = numFiles = result = 0;
+
+            // Merge Published Counters
+            for (int i=0; i<tCount; ++i) {
+                numDirs  += tasks[i]->publishedDirs.load();
+                numFiles += tasks[i]->publishedFiles.load();
+                result   += tasks[i]->publishedSize.load();
+            }
+
+            // Callback
+            callback(aDirPath, aNumDirs + numDirs, aNumFiles + numFiles, result, context);
+        }
+
+        // Flush Completed Breakdowns
+        flushBreakdowns();
+    }
+
+    // Wait For Tasks
+    pool.waitForDone();
+
+    // Go Thru Tasks - Release Dirs Left Behind By An Abort
+    for (int i=0; i<tCount; ++i) {
+        // Init Node
+        DirScanNode* node = NULL;
+
+        // Go Thru Remaining Dirs
+        while (tasks[i]->pop(node)) {
+            // Finish Node
+            finishNode(node);
+        }
+    }
+
+    // Check Background - Owner Saves Once For All Its Scans
+    if (!background) {
+        // Save Dir Size Cache
+        DirSizeCache::instance()->save();
+    }
+
+    // Flush Completed Breakdowns
+    flushBreakdowns();
+
+    // Check Root Breakdown
+    if (breakdownCallback && rootDone && !abortFlag) {
+        // Init Type Stats
+        QHash<QByteArray, DirSizeBreakdownItem> typeStats;
+
+        // Go Thru Tasks
+        for (int i=0; i<tCount; ++i) {
+            // Go Thru Task Type Stats
+            for (QHash<QByteArray, DirSizeBreakdownItem>::const_iterator it = tasks[i]->typeStats.constBegin(); it != tasks[i]->typeStats.constEnd(); ++it) {
+                // Get Type Item
+                DirSizeBreakdownItem& typeItem = typeStats[it.key()];
+                // Merge
+                typeItem.numFiles += it.value().numFiles;
+                typeItem.size += it.value().size;
+            }
+
+            // Merge Largest Files
+            rootBreakdown.largest << tasks[i]->largest;
+        }
+
+        // Go Thru Type Stats
+        for (QHash<QByteArray, DirSizeBreakdownItem>::iterator it = typeStats.begin(); it != typeStats.end(); ++it) {
+            // Set Name
+            it.value().name = QFile::decodeName(it.key());
+            // Add Type
+            rootBreakdown.types << it.value();
+        }
+
+        // Sort Types
+        qSort(rootBreakdown.types.begin(), rootBreakdown.types.end(), breakdownItemGreaterThan);
+        // Sort Largest Files
+        qSort(rootBreakdown.largest.begin(), rootBreakdown.largest.end(), breakdownItemGreaterThan);
+
+        // Trim Types
+        rootBreakdown.types = rootBreakdown.types.mid(0, DEFAULT_DIR_BREAKDOWN_MAX_TYPES);
+        // Trim Largest Files
+        rootBreakdown.largest = rootBreakdown.largest.mid(0, breakdownTopCount);
+
+        // Callback
+        breakdownCallback(rootBreakdown, context);
+    }
+
+    // Reset Counters
+    numDirs = numFiles = result = 0;
+
+    // Merge Final Counters
+    for (int i=0; i<tCount; ++i) {
+        numDirs  += tasks[i]->numDirs;
+        numFiles += tasks[i]->numFiles;
+        result   += tasks[i]->scannedSize;
+    }
+
+    // Update Counters
+    aNumDirs  += numDirs;
+    aNumFiles += numFiles;
+
+    return result;
+}
+
+//==============================================================================
+// Steal Dir From Other Tasks
+//==============================================================================
+bool DirSizeScanner::steal(const int& aThiefIndex, DirScanNode*& aNode)
+{
+    // Get Tasks Count
+    int tCount = tasks.count();
+
+    // Go Thru Other Tasks
+    for (int i=1; i<tCount; ++i) {
+        // Try To Steal
+        if (tasks[(aThiefIndex + i) % tCount]->stealFrom(aNode)) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+//==============================================================================
+// Finish Node - Rolls Completed Subtrees Up To Their Parents
+//==============================================================================
+void DirSizeScanner::finishNode(DirScanNode* aNode)
+{
+    // Init Node
+    DirScanNode* node = aNode;
+
+    // Go Up While Subtrees Complete - Last Finisher Does The Roll Up
+    while (node && !node->remaining.deref()) {
+        // Get Parent
+        DirScanNode* parent = node->parent;
+
+        // Check Breakdown Depth - Aborted Subtrees Are Incomplete
+        if (node->depth <= breakdownDepth && !abortFlag) {
+            // Init Breakdown
+            DirSizeBreakdown breakdown;
+
+            // Setup Breakdown
+            breakdown.path      = node->path;
+            breakdown.depth     = node->depth;
+            breakdown.size      = node->size.load();
+            breakdown.numFiles  = node->numFiles.load();
+            breakdown.numDirs   = node->numDirs.load();
+
+            // Sort Children - All Finished By Now
+            qSort(node->children.begin(), node->children.end(), breakdownItemGreaterThan);
+
+            // Go Thru Children
+            for (int i=0; i<node->children.count(); ++i) {
+                // Check Top Count
+                if (i < breakdownTopCount) {
+                    // Add Child
+                    breakdown.children << node->children[i];
+                } else {
+                    // Add To Rest
+                    breakdown.rest.size     += node->children[i].size;
+                    breakdown.rest.numFiles += node->children[i].numFiles;
+                    breakdown.rest.numDirs  += node->children[i].numDirs + 1;
+                }
+            }
+
+            // Init Locker
+            QMutexLocker locker(&breakdownMutex);
+
+            // Check Parent - Root Is Reported Last
+            if (parent) {
+                // Add Breakdown
+                breakdowns << breakdown;
+            } else {
+                // Set Root Breakdown
+                rootBreakdown = breakdown;
+            }
+        }
+
+        // Check Parent
+        if (!parent) {
+            // Set Root Done
+            rootDone = true;
+            // Delete Root
+            delete node;
+
+            return;
+        }
+
+        // Roll Up Into Parent
+        parent->size.fetchAndAddOrdered(node->size.load());
+        parent->numFiles.fetchAndAddOrdered(node->numFiles.load());
+        parent->numDirs.fetchAndAddOrdered(node->numDirs.load());
+
+        // Check Parent Depth - Children Are Kept For Every Reported Dir, Including The Deepest Level
+        if (parent->depth <= breakdownDepth) {
+            // Init Item
+            DirSizeBreakdownItem item;
+
+            // Setup Item
+            item.name       = QFile::decodeName(node->name);
+            item.size       = node->size.load();
+            item.numFiles   = node->numFiles.load();
+            item.numDirs    = node->numDirs.load();
+
+            // Init Locker
+            QMutexLocker locker(&parent->mutex);
+            // Add Child
+            parent->children << item;
+        }
+
+        // Delete Node
+        delete node;
+
+        // Go Up
+        node = parent;
+    }
+}
+
+//==============================================================================
+// Flush Completed Breakdowns - Scanner Thread Only
+//==============================================================================
+void DirSizeScanner::flushBreakdowns()
+{
+    // Check Breakdown Callback
+    if (!breakdownCallback) {
+        return;
+    }
+
+    // Init Completed
+    QList<DirSizeBreakdown> completed;
+
+    // Take Completed Breakdowns
+    breakdownMutex.lock();
+    completed.swap(breakdowns);
+    breakdownMutex.unlock();
+
+    // Go Thru Completed Breakdowns
+    for (int i=0; i<completed.count(); ++i) {
+        // Callback
+        breakdownCallback(completed[i], context);
+    }
+}
+
+//==============================================================================
+// Is Rotating Disk
+//==============================================================================
+static bool isRotatingDisk(const QString& aDirPath)
+{
+#if defined(Q_OS_LINUX)
+
+    // Init Stat
+    struct stat dirStat;
+
+    // Stat Dir
+    if (stat(QFile::encodeName(aDirPath).constData(), &dirStat) != 0) {
+        return false;
+    }
+
+    // Get Block Device Sys Path - Partitions Live Under Their Disk
+    QString sysPath = QFileInfo(QString("/sys/dev/block/%1:%2").arg(major(dirStat.st_dev)).arg(minor(dirStat.st_dev))).canonicalFilePath();
+
+    // Check Sys Path - Network And Virtual File Systems Have None
+    if (sysPath.isEmpty()) {
+        return false;
+    }
+
+    // Init Rotational File
+    QFile rotationalFile(sysPath + "/queue/rotational");
+
+    // Check Rotational File
+    if (!rotationalFile.exists()) {
+        // Set Parent Disk Rotational File
+        rotationalFile.setFileName(sysPath + "/../queue/rotational");
+    }
+
+    // Open Rotational File
+    if (!rotationalFile.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    return rotationalFile.readAll().trimmed() == "1";
+
+#else // Q_OS_LINUX
+
+    Q_UNUSED(aDirPath);
+
+    return false;
+
+#endif // Q_OS_LINUX
+}
+
+//==============================================================================
+// Get Thread Count For Path - Adapts To The Device Type, Optionally Reports Rotating Disks
+//==============================================================================
+int DirSizeScanner::threadCount(const QString& aDirPath, bool* aRotating)
+{
+    // Check Rotating Disk
+    bool rotating = isRotatingDisk(aDirPath);
+
+    // Check Rotating
+    if (aRotating) {
+        // Set Rotating
+        *aRotating = rotating;
+    }
+
+    // Get Thread Count From Environment
+    int tCount = qgetenv(DEFAULT_DIR_SCAN_THREADS_ENV).toInt();
+
+    // Check Thread Count
+    if (tCount > 0) {
+        return qMin(tCount, DEFAULT_DIR_SCAN_MAX_THREADS);
+    }
+
+    // Check Rotating Disk - Parallel Seeks Only Thrash The Heads
+    if (rotating) {
+        return DEFAULT_DIR_SCAN_ROTATIONAL_THREADS;
+    }
+
+    return qBound(1, QThread::idealThreadCount() * 2, DEFAULT_DIR_SCAN_MAX_THREADS);
+}
+
+//==============================================================================
+// Destructor
+//==============================================================================
+DirSizeScanner::~DirSizeScanner()
+{
+    // Delete Tasks
+    qDeleteAll(tasks);
+    // Clear Tasks
+    tasks.clear();
+}
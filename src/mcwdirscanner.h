@@ -0,0 +1,154 @@
+#ifndef DIRSCANNER_H
+#define DIRSCANNER_H
+
+#include <QString>
+#include <QList>
+#include <QAtomicInt>
+#include <QSemaphore>
+#include <QMutex>
+#include <QSharedPointer>
+
+#include "mcwutility.h"
+
+class DirScanTask;
+class DirScanNode;
+class IgnoreRules;
+
+
+//==============================================================================
+// Dir Size Breakdown Item - Child Subtree, File Type Or Large File
+//==============================================================================
+struct DirSizeBreakdownItem
+{
+    // Constructor
+    DirSizeBreakdownItem()
+        : size(0)
+        , numFiles(0)
+        , numDirs(0)
+    {
+    }
+
+    // Name - Child Dir Name, File Extension Or File Path
+    QString     name;
+    // Size
+    quint64     size;
+    // Num Files
+    quint64     numFiles;
+    // Num Dirs
+    quint64     numDirs;
+};
+
+typedef QList<DirSizeBreakdownItem> DirSizeBreakdownList;
+
+//==============================================================================
+// Dir Size Breakdown - Completed Subtree
+//==============================================================================
+struct DirSizeBreakdown
+{
+    // Constructor
+    DirSizeBreakdown()
+        : depth(0)
+        , size(0)
+        , numFiles(0)
+        , numDirs(0)
+    {
+    }
+
+    // Dir Path
+    QString                 path;
+    // Depth Below The Scanned Dir
+    int                     depth;
+    // Subtree Size
+    quint64                 size;
+    // Subtree Num Files
+    quint64                 numFiles;
+    // Subtree Num Dirs
+    quint64                 numDirs;
+    // Largest Children
+    DirSizeBreakdownList    children;
+    // Remaining Children Aggregated
+    DirSizeBreakdownItem    rest;
+    // File Type Histogram - Scanned Dir Only
+    DirSizeBreakdownList    types;
+    // Largest Files - Scanned Dir Only
+    DirSizeBreakdownList    largest;
+};
+
+// Dir Size Breakdown Callback Type
+typedef void (*dirSizeBreakdownCallback)(const DirSizeBreakdown&, void*);
+
+
+//==============================================================================
+// Dir Size Scanner Class - Work Stealing Parallel Scan
+//==============================================================================
+class DirSizeScanner
+{
+public:
+    // Constructor
+    DirSizeScanner(const bool& aAbort, dirSizeScanProgressCallback aCallback = NULL, void* aContext = NULL);
+
+    // Scan Dir Size
+    quint64 scan(const QString& aDirPath, quint64& aNumDirs, quint64& aNumFiles);
+
+    // Set Breakdown - Subtrees Down To Depth Are Reported As They Complete
+    void setBreakdown(const int& aDepth, const int& aTopCount, dirSizeBreakdownCallback aCallback);
+
+    // Set Background - Fewer Idle Priority Threads, Cache Is Saved By The Caller
+    void setBackground(const bool& aBackground);
+
+    // Set Ignore Rules - Excluded Entries Are Not Counted, Excluded Dirs Not Opened, Cache Bypassed
+    void setIgnoreRules(const QSharedPointer<const IgnoreRules>& aIgnoreRules);
+
+    // Get Thread Count For Path - Adapts To The Device Type, Optionally Reports Rotating Disks
+    static int threadCount(const QString& aDirPath, bool* aRotating = NULL);
+
+    // Destructor
+    ~DirSizeScanner();
+
+private:
+    friend class DirScanTask;
+
+    // Steal Dir From Other Tasks
+    bool steal(const int& aThiefIndex, DirScanNode*& aNode);
+    // Finish Node - Rolls Completed Subtrees Up To Their Parents
+    void finishNode(DirScanNode* aNode);
+    // Flush Completed Breakdowns - Scanner Thread Only
+    void flushBreakdowns();
+
+private:
+    // Abort Flag
+    const bool&                 abortFlag;
+    // Progress Callback
+    dirSizeScanProgressCallback callback;
+    // Callback Context
+    void*                       context;
+    // Tasks
+    QList<DirScanTask*>         tasks;
+    // Pending Dirs - Queued Or Being Scanned
+    QAtomicInt                  pending;
+    // Done Semaphore
+    QSemaphore                  done;
+    // Stat Queue Depth Per Task
+    int                         statDepth;
+    // Background
+    bool                        background;
+    // Ignore Rules - Root Rules, NULL If Nothing Is Excluded
+    QSharedPointer<const IgnoreRules> ignoreRules;
+
+    // Breakdown Depth - Negative If Disabled
+    int                         breakdownDepth;
+    // Breakdown Top Count
+    int                         breakdownTopCount;
+    // Breakdown Callback
+    dirSizeBreakdownCallback    breakdownCallback;
+    // Breakdown Mutex
+    QMutex                      breakdownMutex;
+    // Completed Breakdowns - Waiting To Be Reported
+    QList<DirSizeBreakdown>     breakdowns;
+    // Root Breakdown - Reported Last With The Histograms
+    DirSizeBreakdown            rootBreakdown;
+    // Root Done
+    bool                        rootDone;
+};
+
+#endif // DIRSCANNER_H
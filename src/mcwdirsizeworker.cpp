@@ -0,0 +1,109 @@
+#include <QDebug>
+
+#include "mcwdirsizeworker.h"
+#include "mcwdirscanner.h"
+#include "mcwsizecache.h"
+
+
+//==============================================================================
+// Constructor
+//==============================================================================
+DirSizeWorker::DirSizeWorker(dirSizeUpdateCallback aCallback, void* aContext, QObject* aParent)
+    : QThread(aParent)
+    , abortFlag(false)
+    , callback(aCallback)
+    , context(aContext)
+{
+}
+
+//==============================================================================
+// Start Sizes - Cancels Any Previous Run
+//==============================================================================
+void DirSizeWorker::startSizes(const QString& aDirPath, const QStringList& aSubDirs)
+{
+    // Cancel
+    cancel();
+    // Wait For Previous Run
+    wait();
+
+    qDebug() << "DirSizeWorker::startSizes - aDirPath: " << aDirPath << " - count: " << aSubDirs.count();
+
+    // Set Dir Path
+    sizeDirPath = aDirPath;
+    // Set Sub Dirs
+    subDirs = aSubDirs;
+    // Reset Abort Flag
+    abortFlag = false;
+
+    // Check Sub Dirs
+    if (!subDirs.isEmpty()) {
+        // Start Thread - Never Competes With The Listing
+        start(QThread::IdlePriority);
+    }
+}
+
+//==============================================================================
+// Cancel - Doesn't Wait For The Thread
+//==============================================================================
+void DirSizeWorker::cancel()
+{
+    // Set Abort Flag
+    abortFlag = true;
+}
+
+//==============================================================================
+// Get Dir Path
+//==============================================================================
+QString DirSizeWorker::dirPath() const
+{
+    return sizeDirPath;
+}
+
+//==============================================================================
+// Thread Execution Method
+//==============================================================================
+void DirSizeWorker::run()
+{
+    // Init Dir Prefix
+    QString dirPrefix = sizeDirPath.endsWith("/") ? sizeDirPath : sizeDirPath + "/";
+
+    // Go Thru Sub Dirs - In Listing Order So Visible Entries Come First
+    for (int i=0; i<subDirs.count() && !abortFlag; ++i) {
+        // Init Counters
+        quint64 numDirs  = 0;
+        quint64 numFiles = 0;
+
+        // Init Scanner - Unchanged Dirs Come From The Size Cache
+        DirSizeScanner scanner(abortFlag);
+        // Set Background
+        scanner.setBackground(true);
+
+        // Scan Dir Size
+        quint64 dirSize = scanner.scan(dirPrefix + subDirs[i], numDirs, numFiles);
+
+        // Check Abort Flag - Partial Sizes Are Not Reported
+        if (abortFlag) {
+            break;
+        }
+
+        // Check Callback
+        if (callback) {
+            // Callback
+            callback(sizeDirPath, subDirs[i], numDirs, numFiles, dirSize, context);
+        }
+    }
+
+    // Save Dir Size Cache
+    DirSizeCache::instance()->save();
+}
+
+//==============================================================================
+// Destructor
+//==============================================================================
+DirSizeWorker::~DirSizeWorker()
+{
+    // Cancel
+    cancel();
+    // Wait
+    wait();
+}
@@ -0,0 +1,51 @@
+#ifndef DIRSIZEWORKER_H
+#define DIRSIZEWORKER_H
+
+#include <QThread>
+#include <QString>
+#include <QStringList>
+
+
+// Dir Size Update Callback Type
+typedef void (*dirSizeUpdateCallback)(const QString&, const QString&, const quint64&, const quint64&, const quint64&, void*);
+
+//==============================================================================
+// Dir Size Worker Class - Background Sizes Of Listed Sub Dirs
+//==============================================================================
+class DirSizeWorker : public QThread
+{
+public:
+    // Constructor
+    explicit DirSizeWorker(dirSizeUpdateCallback aCallback, void* aContext, QObject* aParent = NULL);
+
+    // Start Sizes - Cancels Any Previous Run
+    void startSizes(const QString& aDirPath, const QStringList& aSubDirs);
+
+    // Cancel - Doesn't Wait For The Thread
+    void cancel();
+
+    // Get Dir Path
+    QString dirPath() const;
+
+    // Destructor
+    virtual ~DirSizeWorker();
+
+protected: // From QThread
+
+    // Thread Execution Method
+    virtual void run();
+
+private:
+    // Abort Flag
+    bool                    abortFlag;
+    // Dir Path
+    QString                 sizeDirPath;
+    // Sub Dirs
+    QStringList             subDirs;
+    // Callback
+    dirSizeUpdateCallback   callback;
+    // Callback Context
+    void*                   context;
+};
+
+#endif // DIRSIZEWORKER_H
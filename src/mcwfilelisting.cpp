@@ -0,0 +1,852 @@
+#include <QFile>
+#include <QHash>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QFileDevice>
+#include <QDebug>
+
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <dirent.h>
+#include <unistd.h>
+#include <pwd.h>
+
+#include "mcwfilelisting.h"
+#include "mcwstatbatch.h"
+#include "mcwlistfilter.h"
+#include "mcwutility.h"
+#include "mcwconstants.h"
+
+
+//==============================================================================
+// Constructor
+//==============================================================================
+FileListing::FileListing()
+    : listingDirPath("")
+{
+}
+
+//==============================================================================
+// Clear
+//==============================================================================
+void FileListing::clear()
+{
+    // Clear Arrays
+    nameArena.clear();
+    nameOffsets.clear();
+    nameLengths.clear();
+    suffixPositions.clear();
+    sizes.clear();
+    dates.clear();
+    modes.clear();
+    uids.clear();
+    entryFlags.clear();
+    order.clear();
+}
+
+//==============================================================================
+// Reserve
+//==============================================================================
+void FileListing::reserve(const int& aCount)
+{
+    // Reserve Arena - Rough Average Name Length
+    nameArena.reserve(aCount * 16);
+    // Reserve Arrays
+    nameOffsets.reserve(aCount);
+    nameLengths.reserve(aCount);
+    suffixPositions.reserve(aCount);
+    sizes.reserve(aCount);
+    dates.reserve(aCount);
+    modes.reserve(aCount);
+    uids.reserve(aCount);
+    entryFlags.reserve(aCount);
+    order.reserve(aCount);
+}
+
+//==============================================================================
+// Squeeze - Release Unused Capacity
+//==============================================================================
+void FileListing::squeeze()
+{
+    // Squeeze Arrays
+    nameArena.squeeze();
+    nameOffsets.squeeze();
+    nameLengths.squeeze();
+    suffixPositions.squeeze();
+    sizes.squeeze();
+    dates.squeeze();
+    modes.squeeze();
+    uids.squeeze();
+    entryFlags.squeeze();
+    order.squeeze();
+}
+
+//==============================================================================
+// Get Count
+//==============================================================================
+int FileListing::count() const
+{
+    return nameOffsets.count();
+}
+
+//==============================================================================
+// Is Empty
+//==============================================================================
+bool FileListing::isEmpty() const
+{
+    return nameOffsets.isEmpty();
+}
+
+//==============================================================================
+// Get Dir Path
+//==============================================================================
+QString FileListing::dirPath() const
+{
+    return listingDirPath;
+}
+
+//==============================================================================
+// Set Dir Path
+//==============================================================================
+void FileListing::setDirPath(const QString& aDirPath)
+{
+    listingDirPath = aDirPath;
+}
+
+//==============================================================================
+// Append Entry
+//==============================================================================
+int FileListing::append(const QString& aFileName, const qint64& aSize, const qint64& aLastModified, const quint32& aMode, const quint32& aUID, const quint8& aFlags)
+{
+    // Get New Index
+    int newIndex = nameOffsets.count();
+
+    // Get File Name Length
+    int fnLength = aFileName.length();
+
+    // Get Last Dot Pos
+    int lastDotPos = aFileName.lastIndexOf(QChar('.'));
+    // Init Suffix Pos
+    int sfxPos = fnLength;
+
+    // Check Last Dot Pos - Same Rules As getSplited
+    if (lastDotPos > 0 && lastDotPos < fnLength - 1) {
+        // Init Tar Extension
+        QString tarExt = QString(".%1").arg(DEFAULT_EXTENSION_TAR);
+        // Get Tar Extension Pos
+        int tarExtensionPos = aFileName.left(lastDotPos).endsWith(tarExt) ? aFileName.indexOf(tarExt) : -1;
+        // Set Suffix Pos
+        sfxPos = tarExtensionPos >= 0 ? tarExtensionPos + 1 : lastDotPos + 1;
+    }
+
+    // Add Name Offset
+    nameOffsets << nameArena.length();
+    // Add Name Length
+    nameLengths << (quint16)fnLength;
+    // Add Suffix Pos
+    suffixPositions << (quint16)sfxPos;
+    // Append Name To Arena
+    nameArena.append(aFileName);
+
+    // Add Attributes
+    sizes << aSize;
+    dates << aLastModified;
+    modes << aMode;
+    uids << aUID;
+    entryFlags << aFlags;
+
+    // Add To Order
+    order << newIndex;
+
+    return newIndex;
+}
+
+//==============================================================================
+// Get File Name
+//==============================================================================
+QString FileListing::fileName(const int& aIndex) const
+{
+    return QString(nameArena.constData() + nameOffsets[aIndex], nameLengths[aIndex]);
+}
+
+//==============================================================================
+// Get File Name Data
+//==============================================================================
+const QChar* FileListing::fileNameData(const int& aIndex) const
+{
+    return nameArena.constData() + nameOffsets[aIndex];
+}
+
+//==============================================================================
+// Get File Name Length
+//==============================================================================
+int FileListing::fileNameLength(const int& aIndex) const
+{
+    return nameLengths[aIndex];
+}
+
+//==============================================================================
+// Get Suffix Position In File Name
+//==============================================================================
+int FileListing::suffixPos(const int& aIndex) const
+{
+    return suffixPositions[aIndex];
+}
+
+//==============================================================================
+// Get Size
+//==============================================================================
+qint64 FileListing::size(const int& aIndex) const
+{
+    return sizes[aIndex];
+}
+
+//==============================================================================
+// Get Last Modified
+//==============================================================================
+qint64 FileListing::lastModified(const int& aIndex) const
+{
+    return dates[aIndex];
+}
+
+//==============================================================================
+// Get Mode
+//==============================================================================
+quint32 FileListing::mode(const int& aIndex) const
+{
+    return modes[aIndex];
+}
+
+//==============================================================================
+// Get Owner User ID
+//==============================================================================
+quint32 FileListing::ownerID(const int& aIndex) const
+{
+    return uids[aIndex];
+}
+
+//==============================================================================
+// Get Owner Name
+//==============================================================================
+QString FileListing::owner(const int& aIndex) const
+{
+    return ownerName(uids[aIndex]);
+}
+
+//==============================================================================
+// Get Permissions
+//==============================================================================
+int FileListing::permissions(const int& aIndex) const
+{
+    return modeToPermissions(modes[aIndex], uids[aIndex]);
+}
+
+//==============================================================================
+// Get Flags
+//==============================================================================
+quint8 FileListing::flags(const int& aIndex) const
+{
+    return entryFlags[aIndex];
+}
+
+//==============================================================================
+// Is Dir
+//==============================================================================
+bool FileListing::isDir(const int& aIndex) const
+{
+    return entryFlags[aIndex] & EFLFDir;
+}
+
+//==============================================================================
+// Is Link
+//==============================================================================
+bool FileListing::isSymLink(const int& aIndex) const
+{
+    return entryFlags[aIndex] & EFLFSymLink;
+}
+
+//==============================================================================
+// Is Double Dot
+//==============================================================================
+bool FileListing::isDotDot(const int& aIndex) const
+{
+    // Get Name Data
+    const QChar* name = fileNameData(aIndex);
+
+    return nameLengths[aIndex] == 2 && name[0] == QChar('.') && name[1] == QChar('.');
+}
+
+//==============================================================================
+// Get Entry Index At Sorted Position
+//==============================================================================
+int FileListing::indexAt(const int& aPos) const
+{
+    return order[aPos];
+}
+
+//==============================================================================
+// Get Raw Name - No Copy
+//==============================================================================
+static inline QString rawName(const FileListing& aListing, const int& aIndex)
+{
+    return QString::fromRawData(aListing.fileNameData(aIndex), aListing.fileNameLength(aIndex));
+}
+
+// Listing Compare Method Type
+typedef int (*ListingCompareFuncType)(const FileListing&, const int&, const int&, const bool&, const bool&, const bool&);
+
+//==============================================================================
+// Dir First Compare
+//==============================================================================
+static int listingDirFirstCompare(const FileListing& l, const int& a, const int& b)
+{
+    // Get Dir Or Link Flags
+    bool aDir = l.flags(a) & (EFLFDir | EFLFSymLink);
+    bool bDir = l.flags(b) & (EFLFDir | EFLFSymLink);
+
+    // Check If Any File Is Dir
+    if (aDir && !bDir)
+        return -1;
+
+    // Check If Any File Is Dir
+    if (!aDir && bDir)
+        return 1;
+
+    return 0;
+}
+
+//==============================================================================
+// Name Sort Compare
+//==============================================================================
+static int listingNameCompare(const FileListing& l, const int& a, const int& b, const bool& r, const bool& df, const bool& cs)
+{
+    // Check Dir First
+    if (df) {
+        // Apply Dir First Filter
+        int dfr = listingDirFirstCompare(l, a, b);
+
+        // Check Dir First Result
+        if (dfr)
+            return dfr;
+    }
+
+    // Check Double Dot
+    bool aDotDot = l.isDotDot(a);
+    bool bDotDot = l.isDotDot(b);
+
+    // Check File Name
+    if (aDotDot && !bDotDot)
+        return -1;
+
+    // Check File Name
+    if (!aDotDot && bDotDot)
+        return 1;
+
+    // Get Names
+    const QChar* aName = l.fileNameData(a);
+    const QChar* bName = l.fileNameData(b);
+
+    // Compare Items
+    int result = cs ? fnstrcmp(aName, l.fileNameLength(a), bName, l.fileNameLength(b)) : fnstricmp(aName, l.fileNameLength(a), bName, l.fileNameLength(b));
+
+    return r ? -result : result;
+}
+
+//==============================================================================
+// Extension Sort Compare
+//==============================================================================
+static int listingExtCompare(const FileListing& l, const int& a, const int& b, const bool& r, const bool& df, const bool& cs)
+{
+    // Check Dir First
+    if (df) {
+        // Apply Dir First Filter
+        int dfr = listingDirFirstCompare(l, a, b);
+
+        // Check Dir First Result
+        if (dfr)
+            return dfr;
+    }
+
+    // Check If Both File Is a Dir Or Link
+    if ((l.flags(a) & (EFLFDir | EFLFSymLink)) && (l.flags(b) & (EFLFDir | EFLFSymLink)))
+        // Return Name Sort
+        return listingNameCompare(l, a, b, r, df, cs);
+
+    // Get Suffix Positions
+    int aSfxPos = l.suffixPos(a);
+    int bSfxPos = l.suffixPos(b);
+
+    // Get Suffixes
+    const QChar* aSfx = l.fileNameData(a) + aSfxPos;
+    const QChar* bSfx = l.fileNameData(b) + bSfxPos;
+
+    // Get Suffix Lengths
+    int aSfxLength = l.fileNameLength(a) - aSfxPos;
+    int bSfxLength = l.fileNameLength(b) - bSfxPos;
+
+    // Compare Items
+    int result = cs ? fnstrcmp(aSfx, aSfxLength, bSfx, bSfxLength) : fnstricmp(aSfx, aSfxLength, bSfx, bSfxLength);
+
+    // Check Result
+    if (result)
+        return r ? -result : result;
+
+    // Return Name Sort Result
+    return listingNameCompare(l, a, b, r, df, cs);
+}
+
+//==============================================================================
+// Type Sort Compare
+//==============================================================================
+static int listingTypeCompare(const FileListing& l, const int& a, const int& b, const bool& r, const bool& df, const bool& cs)
+{
+    Q_UNUSED(cs);
+
+    // Check Dir First
+    if (df) {
+        // Apply Dir First Filter
+        int dfr = listingDirFirstCompare(l, a, b);
+
+        // Check Dir First Result
+        if (dfr)
+            return dfr;
+    }
+
+    // Compare Items
+    int result = fnstrcmp(l.fileNameData(a), l.fileNameLength(a), l.fileNameData(b), l.fileNameLength(b));
+
+    return r ? -result : result;
+}
+
+//==============================================================================
+// Size Sort Compare
+//==============================================================================
+static int listingSizeCompare(const FileListing& l, const int& a, const int& b, const bool& r, const bool& df, const bool& cs)
+{
+    // Check Dir First
+    if (df) {
+        // Apply Dir First Filter
+        int dfr = listingDirFirstCompare(l, a, b);
+
+        // Check Dir First Result
+        if (dfr)
+            return dfr;
+    }
+
+    // Check If Both File Is a Dir Or Link
+    if ((l.isDir(a) && l.isDir(b)) || (l.isSymLink(a) && l.isSymLink(b)))
+        // Return Name Sort
+        return listingNameCompare(l, a, b, r, df, cs);
+
+    // Check File Size
+    if (l.size(a) > l.size(b))
+        return r ? -1 : 1;
+
+    // Check File Size
+    if (l.size(a) < l.size(b))
+        return r ? 1 : -1;
+
+    // Return Name Sort Result
+    return listingNameCompare(l, a, b, r, df, cs);
+}
+
+//==============================================================================
+// Date Sort Compare
+//==============================================================================
+static int listingDateCompare(const FileListing& l, const int& a, const int& b, const bool& r, const bool& df, const bool& cs)
+{
+    // Check Dir First
+    if (df) {
+        // Apply Dir First Filter
+        int dfr = listingDirFirstCompare(l, a, b);
+
+        // Check Dir First Result
+        if (dfr)
+            return dfr;
+    }
+
+    // Check Double Dot
+    bool aDotDot = l.isDotDot(a);
+    bool bDotDot = l.isDotDot(b);
+
+    // Check File Name
+    if (aDotDot && !bDotDot)
+        return -1;
+
+    // Check File Name
+    if (!aDotDot && bDotDot)
+        return 1;
+
+    // Check File Date
+    if (l.lastModified(a) < l.lastModified(b))
+        return r ? -1 : 1;
+
+    // Check File Date
+    if (l.lastModified(a) > l.lastModified(b))
+        return r ? 1 : -1;
+
+    // Return Name Sort Result
+    return listingNameCompare(l, a, b, r, df, cs);
+}
+
+//==============================================================================
+// Owners Sort Compare
+//==============================================================================
+static int listingOwnerCompare(const FileListing& l, const int& a, const int& b, const bool& r, const bool& df, const bool& cs)
+{
+    // Check Dir First
+    if (df) {
+        // Apply Dir First Filter
+        int dfr = listingDirFirstCompare(l, a, b);
+
+        // Check Dir First Result
+        if (dfr)
+            return dfr;
+    }
+
+    // Init Result
+    int result = l.ownerID(a) == l.ownerID(b) ? 0 : (cs ? fnstrcmp(l.owner(a), l.owner(b)) : fnstricmp(l.owner(a), l.owner(b)));
+
+    // Check REsult
+    if (result)
+        // Return Result
+        return r ? -result : result;
+
+    // Return Name Sort Result
+    return listingNameCompare(l, a, b, r, df, cs);
+}
+
+//==============================================================================
+// Permission Sort Compare
+//==============================================================================
+static int listingPermCompare(const FileListing& l, const int& a, const int& b, const bool& r, const bool& df, const bool& cs)
+{
+    // Check Dir First
+    if (df) {
+        // Apply Dir First Filter
+        int dfr = listingDirFirstCompare(l, a, b);
+
+        // Check Dir First Result
+        if (dfr)
+            return dfr;
+    }
+
+    // Get Permissions
+    int aPerms = l.permissions(a);
+    int bPerms = l.permissions(b);
+
+    // Check File Permissions
+    if (aPerms < bPerms)
+        return r ? -1 : 1;
+
+    // Check File Permissions
+    if (aPerms > bPerms)
+        return r ? 1 : -1;
+
+    // Return Name Sort Result
+    return listingNameCompare(l, a, b, r, df, cs);
+}
+
+//==============================================================================
+// Attributes Sort Compare
+//==============================================================================
+static int listingAttrCompare(const FileListing& l, const int& a, const int& b, const bool& r, const bool& df, const bool& cs)
+{
+    // Check Dir First
+    if (df) {
+        // Apply Dir First Filter
+        int dfr = listingDirFirstCompare(l, a, b);
+
+        // Check Dir First Result
+        if (dfr)
+            return dfr;
+    }
+
+    // Init Dir Prefix
+    QString dirPrefix = l.dirPath().endsWith("/") ? l.dirPath() : l.dirPath() + "/";
+
+    // Get Attributes
+    int aAttrs = getAttributes(dirPrefix + rawName(l, a));
+    int bAttrs = getAttributes(dirPrefix + rawName(l, b));
+
+    // Check File Attributes
+    if (aAttrs < bAttrs)
+        return r ? -1 : 1;
+
+    // Check File Attributes
+    if (aAttrs > bAttrs)
+        return r ? 1 : -1;
+
+    // Return Name Sort Result
+    return listingNameCompare(l, a, b, r, df, cs);
+}
+
+// Check Abort Macro
+#define __LQS_CHECK_ABORT       if (aAbort) { qDebug() << "#### LQSABORT!"; return; }
+
+//==============================================================================
+// Listing Index Quick Sort
+//==============================================================================
+static void listingQuickSort(const FileListing& aListing, int* aOrder, int aLeft, int aRight, ListingCompareFuncType aSort, const bool& aReverse, const bool& aDirFirst, const bool& aCase, const bool& aAbort)
+{
+    __LQS_CHECK_ABORT;
+
+    // Check Indexes
+    if (aLeft < 0 || aRight < 0 || aLeft >= aRight)
+        return;
+
+    // Init First And Last Indexes
+    int i = aLeft, j = aRight;
+
+    // Init Pivot
+    int pivot = aOrder[(aLeft + aRight) / 2];
+
+    // Partition
+    while (i <= j) {
+        while ((aSort(aListing, aOrder[i], pivot, aReverse, aDirFirst, aCase) < 0))
+            i++;
+
+        __LQS_CHECK_ABORT;
+
+        while ((aSort(aListing, aOrder[j], pivot, aReverse, aDirFirst, aCase) > 0))
+            j--;
+
+        __LQS_CHECK_ABORT;
+
+        if (i <= j) {
+            qSwap(aOrder[i], aOrder[j]);
+            i++;
+            j--;
+        }
+    }
+
+    // Recursion
+    if (aLeft < j) {
+        listingQuickSort(aListing, aOrder, aLeft, j, aSort, aReverse, aDirFirst, aCase, aAbort);
+
+        __LQS_CHECK_ABORT;
+    }
+
+    // Recursion
+    if (i < aRight) {
+        listingQuickSort(aListing, aOrder, i, aRight, aSort, aReverse, aDirFirst, aCase, aAbort);
+
+        __LQS_CHECK_ABORT;
+    }
+}
+
+//==============================================================================
+// Sort - Sorts The Index Only, Entries Stay In Place
+//==============================================================================
+void FileListing::sort(const FileSortType& aSortType, const bool& aReverse, const bool& aDirFirst, const bool& aCase, const bool& aAbort)
+{
+    // Init Compare Method
+    ListingCompareFuncType compareFunc = listingNameCompare;
+
+    // Switch Sorting Method
+    switch (aSortType) {
+        default:
+        case EFSTName:          compareFunc = listingNameCompare;   break;
+        case EFSTExtension:     compareFunc = listingExtCompare;    break;
+        case EFSTType:          compareFunc = listingTypeCompare;   break;
+        case EFSTSize:          compareFunc = listingSizeCompare;   break;
+        case EFSTDate:          compareFunc = listingDateCompare;   break;
+        case EFSTOwnership:     compareFunc = listingOwnerCompare;  break;
+        case EFSTPermission:    compareFunc = listingPermCompare;   break;
+        case EFSTAttributes:    compareFunc = listingAttrCompare;   break;
+    }
+
+    // Sort Order
+    listingQuickSort(*this, order.data(), 0, order.count() - 1, compareFunc, aReverse, aDirFirst, aCase, aAbort);
+}
+
+//==============================================================================
+// Read Dir Listing
+//==============================================================================
+bool readDirListing(const QString& aDirPath, FileListing& aListing, const bool& aShowHidden, const DirListFilter* aFilter, const bool& aAbort)
+{
+    // Clear Listing
+    aListing.clear();
+    // Set Dir Path
+    aListing.setDirPath(aDirPath);
+
+    // Init Entries
+    StatBatchList entries;
+
+    // Read Dir Entries
+    if (!readDirEntries(aDirPath, entries, aShowHidden, true)) {
+        return false;
+    }
+
+    // Check Abort
+    if (aAbort) {
+        return false;
+    }
+
+    // Check Filter
+    bool useFilter = aFilter && !aFilter->isEmpty();
+
+    // Check Name Filter - Drop Entries Before Stat If The Type Is Known
+    if (useFilter && aFilter->hasNameFilter()) {
+        // Get Entries Count
+        int eCount = entries.count();
+        // Init Kept Count
+        int keptCount = 0;
+
+        // Go Thru Entries
+        for (int i=0; i<eCount; ++i) {
+            // Get Dir Entry Type
+            quint8 dirType = entries[i].dirType;
+
+            // Check Dir Entry Type - Links And Unknown Types Are Checked After Stat
+            if ((dirType == DT_REG || dirType == DT_DIR) && !aFilter->matchName(QFile::decodeName(entries[i].name), dirType == DT_DIR)) {
+                continue;
+            }
+
+            // Keep Entry
+            if (keptCount != i) {
+                entries[keptCount] = entries[i];
+            }
+
+            keptCount++;
+        }
+
+        // Drop Filtered Entries
+        entries.resize(keptCount);
+    }
+
+    // Stat Entries In Batches
+    statBatch(aDirPath, entries, statBatchQueueDepth(), aAbort);
+
+    // Check Abort
+    if (aAbort) {
+        return false;
+    }
+
+    // Get Entries Count
+    int eCount = entries.count();
+
+    // Reserve
+    aListing.reserve(eCount);
+
+    // Go Thru Entries
+    for (int i=0; i<eCount; ++i) {
+        // Get Entry
+        const StatBatchEntry& entry = entries[i];
+
+        // Check Entry
+        if (!entry.valid) {
+            continue;
+        }
+
+        // Get File Name
+        QString fileName = QFile::decodeName(entry.name);
+
+        // Init Flags
+        quint8 flags = 0;
+
+        // Set Flags
+        if (entry.isDir)
+            flags |= EFLFDir;
+        if (entry.isSymLink)
+            flags |= EFLFSymLink;
+        if (fileName.startsWith(QChar('.')) && fileName != QString(".."))
+            flags |= EFLFHidden;
+
+        // Check Filter
+        if (useFilter && fileName != QString("..")) {
+            // Match Name
+            if (!aFilter->matchName(fileName, entry.isDir)) {
+                continue;
+            }
+
+            // Match Attributes
+            if (!aFilter->matchAttributes(entry.size, entry.lastModified, modeToPermissions(entry.mode, entry.uid), entry.isDir, entry.isSymLink)) {
+                continue;
+            }
+        }
+
+        // Append Entry
+        aListing.append(fileName, entry.size, entry.lastModified, entry.mode, entry.uid, flags);
+    }
+
+    // Squeeze Listing
+    aListing.squeeze();
+
+    return true;
+}
+
+// Owner Name Cache Mutex
+static QMutex                   ownerNameCacheMutex;
+// Owner Name Cache
+static QHash<quint32, QString>  ownerNameCache;
+
+//==============================================================================
+// Get Owner Name For User ID - Cached
+//==============================================================================
+QString ownerName(const quint32& aUID)
+{
+    // Init Locker
+    QMutexLocker locker(&ownerNameCacheMutex);
+
+    // Find Cached Name
+    QHash<quint32, QString>::const_iterator it = ownerNameCache.constFind(aUID);
+
+    // Check Cached Name
+    if (it != ownerNameCache.constEnd()) {
+        return it.value();
+    }
+
+    // Init Password Entry
+    struct passwd pwEntry;
+    struct passwd* pwResult = NULL;
+    // Init Buffer
+    char pwBuffer[1024];
+
+    // Init Name
+    QString name = QString::number(aUID);
+
+    // Get Password Entry
+    if (getpwuid_r((uid_t)aUID, &pwEntry, pwBuffer, sizeof(pwBuffer), &pwResult) == 0 && pwResult) {
+        // Set Name
+        name = QFile::decodeName(pwResult->pw_name);
+    }
+
+    // Add To Cache
+    ownerNameCache[aUID] = name;
+
+    return name;
+}
+
+//==============================================================================
+// Mode To Permissions - User Bits Approximated From Owner And Other Bits
+//==============================================================================
+int modeToPermissions(const quint32& aMode, const quint32& aUID)
+{
+    // Init Permissions
+    int perms = 0;
+
+    // Owner
+    if (aMode & S_IRUSR) perms |= QFileDevice::ReadOwner;
+    if (aMode & S_IWUSR) perms |= QFileDevice::WriteOwner;
+    if (aMode & S_IXUSR) perms |= QFileDevice::ExeOwner;
+    // Group
+    if (aMode & S_IRGRP) perms |= QFileDevice::ReadGroup;
+    if (aMode & S_IWGRP) perms |= QFileDevice::WriteGroup;
+    if (aMode & S_IXGRP) perms |= QFileDevice::ExeGroup;
+    // Other
+    if (aMode & S_IROTH) perms |= QFileDevice::ReadOther;
+    if (aMode & S_IWOTH) perms |= QFileDevice::WriteOther;
+    if (aMode & S_IXOTH) perms |= QFileDevice::ExeOther;
+
+    // Check Owner
+    if (aUID == (quint32)geteuid()) {
+        // Current User Is Owner
+        perms |= (perms & (QFileDevice::ReadOwner | QFileDevice::WriteOwner | QFileDevice::ExeOwner)) >> 4;
+    } else {
+        // Current User Is Other
+        perms |= (perms & (QFileDevice::ReadOther | QFileDevice::WriteOther | QFileDevice::ExeOther)) << 8;
+    }
+
+    return perms;
+}
@@ -0,0 +1,138 @@
+#ifndef FILELISTING_H
+#define FILELISTING_H
+
+#include <QString>
+#include <QVector>
+
+#include "mcwinterface.h"
+
+class DirListFilter;
+
+
+//==============================================================================
+// FileSortType File Sort Type Enum
+//==============================================================================
+enum FileSortType
+{
+    EFSTName        = DEFAULT_SORT_NAME,
+    EFSTExtension   = DEFAULT_SORT_EXT,
+    EFSTType        = DEFAULT_SORT_TYPE,
+    EFSTSize        = DEFAULT_SORT_SIZE,
+    EFSTDate        = DEFAULT_SORT_DATE,
+    EFSTOwnership   = DEFAULT_SORT_OWNER,
+    EFSTPermission  = DEFAULT_SORT_PERMS,
+    EFSTAttributes  = DEFAULT_SORT_ATTRS
+};
+
+//==============================================================================
+// File Listing Entry Flags
+//==============================================================================
+enum FileListingFlags
+{
+    EFLFDir         = 0x01,
+    EFLFSymLink     = 0x02,
+    EFLFHidden      = 0x04
+};
+
+//==============================================================================
+// File Listing Class - Struct Of Arrays, Names Kept In One String Arena
+//==============================================================================
+class FileListing
+{
+public:
+    // Constructor
+    FileListing();
+
+    // Clear
+    void clear();
+    // Reserve
+    void reserve(const int& aCount);
+    // Squeeze - Release Unused Capacity
+    void squeeze();
+
+    // Get Count
+    int count() const;
+    // Is Empty
+    bool isEmpty() const;
+
+    // Get Dir Path
+    QString dirPath() const;
+    // Set Dir Path
+    void setDirPath(const QString& aDirPath);
+
+    // Append Entry
+    int append(const QString& aFileName, const qint64& aSize, const qint64& aLastModified, const quint32& aMode, const quint32& aUID, const quint8& aFlags);
+
+    // Get File Name
+    QString fileName(const int& aIndex) const;
+    // Get File Name Data - Points Into The Arena, Not Null Terminated
+    const QChar* fileNameData(const int& aIndex) const;
+    // Get File Name Length
+    int fileNameLength(const int& aIndex) const;
+    // Get Suffix Position In File Name - Equals Length If No Suffix
+    int suffixPos(const int& aIndex) const;
+
+    // Get Size
+    qint64 size(const int& aIndex) const;
+    // Get Last Modified - Msecs Since Epoch
+    qint64 lastModified(const int& aIndex) const;
+    // Get Mode
+    quint32 mode(const int& aIndex) const;
+    // Get Owner User ID
+    quint32 ownerID(const int& aIndex) const;
+    // Get Owner Name
+    QString owner(const int& aIndex) const;
+    // Get Permissions - QFileDevice::Permissions
+    int permissions(const int& aIndex) const;
+    // Get Flags
+    quint8 flags(const int& aIndex) const;
+    // Is Dir
+    bool isDir(const int& aIndex) const;
+    // Is Link
+    bool isSymLink(const int& aIndex) const;
+    // Is Double Dot
+    bool isDotDot(const int& aIndex) const;
+
+    // Get Entry Index At Sorted Position
+    int indexAt(const int& aPos) const;
+
+    // Sort - Sorts The Index Only, Entries Stay In Place
+    void sort(const FileSortType& aSortType, const bool& aReverse, const bool& aDirFirst, const bool& aCase, const bool& aAbort);
+
+private:
+
+    // Dir Path
+    QString             listingDirPath;
+    // Name Arena
+    QString             nameArena;
+    // Name Offsets
+    QVector<int>        nameOffsets;
+    // Name Lengths
+    QVector<quint16>    nameLengths;
+    // Suffix Positions
+    QVector<quint16>    suffixPositions;
+    // Sizes
+    QVector<qint64>     sizes;
+    // Last Modified Dates
+    QVector<qint64>     dates;
+    // Modes
+    QVector<quint32>    modes;
+    // Owner User IDs
+    QVector<quint32>    uids;
+    // Flags
+    QVector<quint8>     entryFlags;
+    // Sorted Order
+    QVector<int>        order;
+};
+
+
+// Read Dir Listing - Filter Is Evaluated Before Sorting, Names Before Stat When Possible
+bool readDirListing(const QString& aDirPath, FileListing& aListing, const bool& aShowHidden, const DirListFilter* aFilter, const bool& aAbort);
+
+// Get Owner Name For User ID - Cached
+QString ownerName(const quint32& aUID);
+
+// Mode To Permissions - QFileDevice::Permissions
+int modeToPermissions(const quint32& aMode, const quint32& aUID);
+
+#endif // FILELISTING_H
@@ -6,6 +6,8 @@
 
 #include "mcwfileserver.h"
 #include "mcwfileserverconnection.h"
+#include "mcwtrigramindex.h"
+#include "mcwnameindex.h"
 #include "mcwconstants.h"
 
 //==============================================================================
@@ -34,6 +36,11 @@ void FileServer::init()
 {
     qDebug() << "FileServer::init";
 
+    // Init Trigram Indexer - Existing Indexes Are Loaded & Refreshed By The Index Watcher
+    TrigramIndexer::instance();
+    // Init Name Indexer - Shares The Index Watcher's Watches & Thread
+    NameIndexer::instance();
+
     // ...
 }
 
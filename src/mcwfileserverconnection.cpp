@@ -71,6 +71,7 @@ void FileServerConnection::init()
 
     // Set Up Operation Map
     operationMap[DEFAULT_OPERATION_LIST_DIR]        = EFSCWOTListDir;
+    operationMap[DEFAULT_OPERATION_RESORT_DIR]      = EFSCWOTResortDir;
     operationMap[DEFAULT_OPERATION_SCAN_DIR]        = EFSCWOTScanDir;
     operationMap[DEFAULT_OPERATION_TREE_DIR]        = EFSCWOTTreeDir;
     operationMap[DEFAULT_OPERATION_MAKE_DIR]        = EFSCWOTMakeDir;
@@ -88,6 +89,8 @@ void FileServerConnection::init()
     operationMap[DEFAULT_OPERATION_RESUME]          = EFSCWOTResume;
     operationMap[DEFAULT_OPERATION_ACKNOWLEDGE]     = EFSCWOTAcknowledge;
     operationMap[DEFAULT_OPERATION_CLEAR]           = EFSCWOTClearOpt;
+    operationMap[DEFAULT_OPERATION_INDEX_DIR]       = EFSCWOTIndexDir;
+    operationMap[DEFAULT_OPERATION_FIND_FILE]       = EFSCWOTFindFile;
 
     operationMap[DEFAULT_OPERATION_TEST]            = EFSCWOTTest;
 
@@ -2,12 +2,21 @@
 #include <QMutexLocker>
 #include <QDialogButtonBox>
 #include <QStorageInfo>
+#include <QScopedPointer>
 #include <QDebug>
 
 #include "mcwfileserverconnection.h"
 #include "mcwfileserverconnectionworker.h"
 #include "mcwarchiveengine.h"
 #include "mcwutility.h"
+#include "mcwlistfilter.h"
+#include "mcwtreewalker.h"
+#include "mcwdirsizeworker.h"
+#include "mcwtrigramindex.h"
+#include "mcwcontentmatcher.h"
+#include "mcwignorerules.h"
+#include "mcwnameindex.h"
+#include "mcwglobmatcher.h"
 #include "mcwconstants.h"
 
 // Check Paused Macro
@@ -49,6 +58,9 @@ FileServerConnectionWorker::FileServerConnectionWorker(FileServerConnection* aCo
     , response(0)
     , filters(0)
     , sortFlags(0)
+    , depth(DEFAULT_DIR_TREE_DEPTH)
+    , breakdownDepth(-1)
+    , topCount(DEFAULT_DIR_BREAKDOWN_TOP_COUNT)
     , supressMergeConfirm(false)
     , path("")
     , filePath("")
@@ -56,13 +68,22 @@ FileServerConnectionWorker::FileServerConnectionWorker(FileServerConnection* aCo
     , target("")
     , searchTerm("")
     , contentTerm("")
+    , excludeTerm("")
+    , lastDirListPath("")
+    , lastDirListFilters(0)
+    , searchResultsID(0)
+    , lastSearchResultsID(0)
+    , searchResultsTime(0)
+    , collectSearchResults(false)
     , archiveMode(false)
     , archiveEngine(NULL)
+    , dirSizeWorker(NULL)
 
 {
     qDebug() << "FileServerConnectionWorker::FileServerConnectionWorker";
 
-    // ...
+    // Create Background Dir Size Worker
+    dirSizeWorker = new DirSizeWorker(dirSizeUpdateCB, this);
 
 }
 
@@ -166,6 +187,9 @@ void FileServerConnectionWorker::abort()
         // Set Status
         setStatus(EFSCWSAborting);
 
+        // Cancel Background Dir Sizes
+        cancelDirSizes();
+
         // Wake All Wait Conditions
         waitCondition.wakeAll();
 
@@ -416,8 +440,16 @@ void FileServerConnectionWorker::parseQueueItem(const QVariantMap& aDataMap)
     options     |= lastOperationDataMap[DEFAULT_KEY_OPTIONS].toInt();
     // Get Filters
     filters     = lastOperationDataMap[DEFAULT_KEY_FILTERS].toInt();
+    // Get Filter Expression
+    filterExpr  = lastOperationDataMap[DEFAULT_KEY_FILTEREXPR].toMap();
     // Get Sort Flags
     sortFlags   = lastOperationDataMap[DEFAULT_KEY_FLAGS].toInt();
+    // Get Dir Tree Depth
+    depth       = lastOperationDataMap.value(DEFAULT_KEY_DEPTH, DEFAULT_DIR_TREE_DEPTH).toInt();
+    // Get Dir Size Breakdown Depth
+    breakdownDepth = lastOperationDataMap.value(DEFAULT_KEY_BREAKDOWN, -1).toInt();
+    // Get Top Count
+    topCount    = lastOperationDataMap.value(DEFAULT_KEY_TOPCOUNT, DEFAULT_DIR_BREAKDOWN_TOP_COUNT).toInt();
     // Get Singla Path
     path        = lastOperationDataMap[DEFAULT_KEY_PATH].toString();
     // Get Current File
@@ -430,6 +462,16 @@ void FileServerConnectionWorker::parseQueueItem(const QVariantMap& aDataMap)
     searchTerm  = lastOperationDataMap[DEFAULT_KEY_SEARCHTERM].toString();
     // Get Content for Search
     contentTerm = lastOperationDataMap[DEFAULT_KEY_CONTENTTERM].toString();
+    // Get Exclude Patterns - gitignore Syntax, Pruned From Searches & Scans
+    excludeTerm = lastOperationDataMap[DEFAULT_KEY_EXCLUDE].toString();
+    // Get Content Terms - Several Terms Matched Together, The Single Content Term Otherwise
+    contentTerms = lastOperationDataMap[DEFAULT_KEY_CONTENTTERMS].toStringList();
+
+    // Check Content Terms
+    if (contentTerms.isEmpty() && !contentTerm.isEmpty()) {
+        // Add Content Term
+        contentTerms << contentTerm;
+    }
 
     qDebug() << "FileServerConnectionWorker::parseQueueItem - cID: " << cID << " - operation: " << operation << " - path: " << path;
 
@@ -442,14 +484,17 @@ void FileServerConnectionWorker::parseQueueItem(const QVariantMap& aDataMap)
     // Switch Operation ID
     switch (opID) {
         case EFSCWOTTest:           testRun();                                          break;
-        case EFSCWOTListDir:        getDirList(path, filters, sortFlags);               break;
-        case EFSCWOTScanDir:        scanDirSize(path);                                  break;
+        case EFSCWOTListDir:        getDirList(path, filters, filterExpr, sortFlags);   break;
+        case EFSCWOTResortDir:      resortDirList(path, filters, filterExpr, sortFlags); break;
+        case EFSCWOTScanDir:        scanDirSize(path, breakdownDepth, topCount, excludeTerm, options); break;
         case EFSCWOTMakeDir:        createDir(path);                                    break;
         case EFSCWOTMakeLink:       createLink(source, target);                         break;
         case EFSCWOTListArchive:    listArchive(filePath, path, filters, sortFlags);    break;
         case EFSCWOTDeleteFile:     deleteOperation(path);                              break;
-        case EFSCWOTTreeDir:        scanDirTree(path);                                  break;
-        case EFSCWOTSearchFile:     searchFile(searchTerm, path, contentTerm, options); break;
+        case EFSCWOTTreeDir:        scanDirTree(path, filters, depth);                  break;
+        case EFSCWOTIndexDir:       indexDir(path, lastOperationDataMap[DEFAULT_KEY_FLAGS].toInt()); break;
+        case EFSCWOTSearchFile:     searchFile(searchTerm, path, contentTerms, excludeTerm, options, lastOperationDataMap.value(DEFAULT_KEY_RESULTS, 0).toUInt()); break;
+        case EFSCWOTFindFile:       findFile(searchTerm, path, lastOperationDataMap.value(DEFAULT_KEY_TOPCOUNT, DEFAULT_FIND_TOP_COUNT).toInt()); break;
         case EFSCWOTCopyFile:       copyOperation(source, target);                      break;
         case EFSCWOTMoveFile:       moveOperation(source, target);                      break;
         case EFSCWOTExtractFile:    extractArchive(source, target);                     break;
@@ -643,6 +688,95 @@ void FileServerConnectionWorker::sendDirSizeScanProgress(const QString& aPath, c
     emit dataAvailable(newDataMap);
 }
 
+//==============================================================================
+// Breakdown List To Variant List
+//==============================================================================
+static QVariantList breakdownListToVariant(const DirSizeBreakdownList& aList, const char* aNameKey)
+{
+    // Init Variant List
+    QVariantList result;
+
+    // Go Thru List
+    for (int i=0; i<aList.count(); ++i) {
+        // Init Item
+        QVariantMap item;
+
+        // Setup Item
+        item[aNameKey]              = aList[i].name;
+        item[DEFAULT_KEY_DIRSIZE]   = aList[i].size;
+        item[DEFAULT_KEY_NUMFILES]  = aList[i].numFiles;
+        item[DEFAULT_KEY_NUMDIRS]   = aList[i].numDirs;
+
+        // Add Item
+        result << item;
+    }
+
+    return result;
+}
+
+//==============================================================================
+// Send Dir Size - Background Size Of A Listed Sub Dir
+//==============================================================================
+void FileServerConnectionWorker::sendDirSize(const QString& aDirPath, const QString& aFileName, const quint64& aNumDirs, const quint64& aNumFiles, const quint64& aSize)
+{
+    // Init New Data Map
+    QVariantMap newDataMap;
+
+    // Setup New Data Map
+    newDataMap[DEFAULT_KEY_CID]         = cID;
+    newDataMap[DEFAULT_KEY_OPERATION]   = QString(DEFAULT_OPERATION_LIST_DIR);
+    newDataMap[DEFAULT_KEY_PATH]        = aDirPath;
+    newDataMap[DEFAULT_KEY_FILENAME]    = aFileName;
+    newDataMap[DEFAULT_KEY_NUMFILES]    = aNumFiles;
+    newDataMap[DEFAULT_KEY_NUMDIRS]     = aNumDirs;
+    newDataMap[DEFAULT_KEY_DIRSIZE]     = aSize;
+    newDataMap[DEFAULT_KEY_RESPONSE]    = QString(DEFAULT_RESPONSE_DIRSIZE);
+
+    // Emit Data Available Signal - Queued, Safe From The Background Thread
+    emit dataAvailable(newDataMap);
+}
+
+//==============================================================================
+// Send Dir Size Breakdown
+//==============================================================================
+void FileServerConnectionWorker::sendDirSizeBreakdown(const DirSizeBreakdown& aBreakdown)
+{
+    // Init Rest
+    QVariantMap rest;
+
+    // Setup Rest
+    rest[DEFAULT_KEY_DIRSIZE]           = aBreakdown.rest.size;
+    rest[DEFAULT_KEY_NUMFILES]          = aBreakdown.rest.numFiles;
+    rest[DEFAULT_KEY_NUMDIRS]           = aBreakdown.rest.numDirs;
+
+    // Init New Data Map
+    QVariantMap newDataMap;
+
+    // Setup New Data Map
+    newDataMap[DEFAULT_KEY_CID]         = cID;
+    newDataMap[DEFAULT_KEY_OPERATION]   = operation;
+    newDataMap[DEFAULT_KEY_PATH]        = aBreakdown.path;
+    newDataMap[DEFAULT_KEY_DEPTH]       = aBreakdown.depth;
+    newDataMap[DEFAULT_KEY_DIRSIZE]     = aBreakdown.size;
+    newDataMap[DEFAULT_KEY_NUMFILES]    = aBreakdown.numFiles;
+    newDataMap[DEFAULT_KEY_NUMDIRS]     = aBreakdown.numDirs;
+    newDataMap[DEFAULT_KEY_CHILDREN]    = breakdownListToVariant(aBreakdown.children, DEFAULT_KEY_FILENAME);
+    newDataMap[DEFAULT_KEY_REST]        = rest;
+
+    // Check Depth - Histograms Come With The Scanned Dir Only
+    if (aBreakdown.depth == 0) {
+        // Set Types
+        newDataMap[DEFAULT_KEY_TYPES]   = breakdownListToVariant(aBreakdown.types, DEFAULT_KEY_FILENAME);
+        // Set Largest Files
+        newDataMap[DEFAULT_KEY_LARGEST] = breakdownListToVariant(aBreakdown.largest, DEFAULT_KEY_PATH);
+    }
+
+    newDataMap[DEFAULT_KEY_RESPONSE]    = QString(DEFAULT_RESPONSE_DIRBREAKDOWN);
+
+    // Emit Data Available Signal
+    emit dataAvailable(newDataMap);
+}
+
 //==============================================================================
 // Send Archive List Item Found
 //==============================================================================
@@ -666,10 +800,29 @@ void FileServerConnectionWorker::sendArchiveListItemFound(const QString& aArchiv
     emit dataAvailable(newDataMap);
 }
 
+//==============================================================================
+// Send Dir Tree Items - Batched
+//==============================================================================
+void FileServerConnectionWorker::sendDirTreeItems(const QString& aPath, const QVariantList& aItems)
+{
+    // Init New Data Map
+    QVariantMap newDataMap;
+
+    // Setup New Data Map
+    newDataMap[DEFAULT_KEY_CID]         = cID;
+    newDataMap[DEFAULT_KEY_OPERATION]   = operation;
+    newDataMap[DEFAULT_KEY_PATH]        = aPath;
+    newDataMap[DEFAULT_KEY_ITEMS]       = aItems;
+    newDataMap[DEFAULT_KEY_RESPONSE]    = QString(DEFAULT_RESPONSE_DIRTREE);
+
+    // Emit Data Available Signal
+    emit dataAvailable(newDataMap);
+}
+
 //==============================================================================
 // Send Search File Item Found
 //==============================================================================
-void FileServerConnectionWorker::sendSearchFileItemFound(const QString& aPath, const QString& aFileName)
+void FileServerConnectionWorker::sendSearchFileItemFound(const QString& aPath, const QString& aFileName, const ContentHit* aHit)
 {
     // Init New Data Map
     QVariantMap newDataMap;
@@ -681,6 +834,90 @@ void FileServerConnectionWorker::sendSearchFileItemFound(const QString& aPath, c
     newDataMap[DEFAULT_KEY_FILENAME]    = aFileName;
     newDataMap[DEFAULT_KEY_RESPONSE]    = QString(DEFAULT_RESPONSE_SEARCH);
 
+    // Check Content Hit
+    if (aHit && aHit->offset >= 0) {
+        // Set Hit Location
+        newDataMap[DEFAULT_KEY_LINE]    = aHit->line;
+        newDataMap[DEFAULT_KEY_OFFSET]  = aHit->offset;
+        newDataMap[DEFAULT_KEY_SNIPPET] = aHit->snippet;
+
+        // Check Terms - Multi Term Searches Only
+        if (!aHit->terms.isEmpty()) {
+            // Init Terms
+            QVariantList terms;
+
+            // Go Thru Terms
+            for (int i=0; i<aHit->terms.count(); ++i) {
+                // Add Term Index
+                terms << aHit->terms[i];
+            }
+
+            // Set Terms Found
+            newDataMap[DEFAULT_KEY_TERMS] = terms;
+        }
+    }
+
+    // Emit Data Available Signal
+    emit dataAvailable(newDataMap);
+}
+
+//==============================================================================
+// Send Search Index State - Build Time & Pending Changes Of The Index Used
+//==============================================================================
+void FileServerConnectionWorker::sendSearchIndexState(const qint64& aBuildTime, const bool& aStale)
+{
+    // Init New Data Map
+    QVariantMap newDataMap;
+
+    // Setup New Data Map
+    newDataMap[DEFAULT_KEY_CID]         = cID;
+    newDataMap[DEFAULT_KEY_OPERATION]   = operation;
+    newDataMap[DEFAULT_KEY_PATH]        = path;
+    newDataMap[DEFAULT_KEY_INDEXTIME]   = aBuildTime;
+    newDataMap[DEFAULT_KEY_STALE]       = aStale;
+    newDataMap[DEFAULT_KEY_RESPONSE]    = QString(DEFAULT_RESPONSE_SEARCHINDEX);
+
+    // Emit Data Available Signal
+    emit dataAvailable(newDataMap);
+}
+
+//==============================================================================
+// Send Search Results - ID Of The Results Kept For Refining
+//==============================================================================
+void FileServerConnectionWorker::sendSearchResults(const quint32& aResultsID, const int& aCount)
+{
+    // Init New Data Map
+    QVariantMap newDataMap;
+
+    // Setup New Data Map
+    newDataMap[DEFAULT_KEY_CID]         = cID;
+    newDataMap[DEFAULT_KEY_OPERATION]   = operation;
+    newDataMap[DEFAULT_KEY_PATH]        = path;
+    newDataMap[DEFAULT_KEY_RESULTS]     = aResultsID;
+    newDataMap[DEFAULT_KEY_COUNT]       = aCount;
+    newDataMap[DEFAULT_KEY_RESPONSE]    = QString(DEFAULT_RESPONSE_SEARCHRESULTS);
+
+    // Emit Data Available Signal
+    emit dataAvailable(newDataMap);
+}
+
+//==============================================================================
+// Send Find File Item - Score & Rank Of A Fuzzy Match
+//==============================================================================
+void FileServerConnectionWorker::sendFindFileItem(const QString& aPath, const QString& aFilePath, const int& aScore, const int& aRank)
+{
+    // Init New Data Map
+    QVariantMap newDataMap;
+
+    // Setup New Data Map
+    newDataMap[DEFAULT_KEY_CID]         = cID;
+    newDataMap[DEFAULT_KEY_OPERATION]   = operation;
+    newDataMap[DEFAULT_KEY_PATH]        = aPath;
+    newDataMap[DEFAULT_KEY_FILENAME]    = aFilePath;
+    newDataMap[DEFAULT_KEY_SCORE]       = aScore;
+    newDataMap[DEFAULT_KEY_RANK]        = aRank;
+    newDataMap[DEFAULT_KEY_RESPONSE]    = QString(DEFAULT_RESPONSE_FIND);
+
     // Emit Data Available Signal
     emit dataAvailable(newDataMap);
 }
@@ -708,8 +945,11 @@ void FileServerConnectionWorker::sendFinished(const QString& aOperation, const Q
 //==============================================================================
 // Get Dir List
 //==============================================================================
-void FileServerConnectionWorker::getDirList(const QString& aDirPath, const int& aFilters, const int& aSortFlags)
+void FileServerConnectionWorker::getDirList(const QString& aDirPath, const int& aFilters, const QVariantMap& aFilterExpr, const int& aSortFlags)
 {
+    // Cancel Background Dir Sizes - Client Navigated Away
+    cancelDirSizes();
+
     // Reset Archive Mode
     archiveMode = false;
 
@@ -737,12 +977,92 @@ void FileServerConnectionWorker::getDirList(const QString& aDirPath, const int&
     // Check Abort Flag
     __CHECK_OP_ABORTING;
 
-    // Get File Info List
-    QFileInfoList fiList = getDirFileInfoList(localPath, aFilters & DEFAULT_FILTER_SHOW_HIDDEN);
+    // Init Filter - Evaluated During Enumeration
+    DirListFilter listFilter(aFilterExpr);
+
+    // Reset Last Dir List Path
+    lastDirListPath     = "";
+    // Set Last Dir List Modification Time - Before Reading, So Changes During The Read Invalidate It
+    lastDirListModified = QFileInfo(localPath).lastModified();
+
+    // Read Dir Listing
+    if (!readDirListing(localPath, lastDirList, aFilters & DEFAULT_FILTER_SHOW_HIDDEN, &listFilter, abortFlag)) {
+        // Clear Last Dir List
+        lastDirList.clear();
+
+        // Check Abort Flag
+        __CHECK_OP_ABORTING;
+
+        // Send Operation Finished Data - Unreadable Dir Lists Empty
+        sendFinished();
+
+        return;
+    }
+
+    // Check Abort Flag
+    __CHECK_OP_ABORTING;
+
+    // Set Last Dir List Path
+    lastDirListPath     = localPath;
+    // Set Last Dir List Filters
+    lastDirListFilters  = aFilters;
+    // Set Last Dir List Filter Expression
+    lastDirListFilterExpr = aFilterExpr;
+
+    // Sort & Send Dir List
+    sendDirList(localPath, lastDirList, aSortFlags);
 
     // Check Abort Flag
     __CHECK_OP_ABORTING;
 
+    // Check Filters
+    if (aFilters & DEFAULT_FILTER_DIR_SIZES) {
+        // Start Background Dir Sizes
+        startDirSizes(localPath, lastDirList);
+    }
+}
+
+//==============================================================================
+// Resort Last Dir List - Reuse Cached Dir List Without Reading The Dir Again
+//==============================================================================
+void FileServerConnectionWorker::resortDirList(const QString& aDirPath, const int& aFilters, const QVariantMap& aFilterExpr, const int& aSortFlags)
+{
+    // Check Last Dir List
+    if (archiveMode || lastDirListPath != aDirPath || lastDirListFilters != aFilters || lastDirListFilterExpr != aFilterExpr || lastDirList.isEmpty() || QFileInfo(aDirPath).lastModified() != lastDirListModified) {
+        qDebug() << "FileServerConnectionWorker::resortDirList - cID: " << cID << " - aDirPath: " << aDirPath << " - NOT CACHED";
+
+        // Get Dir List
+        getDirList(aDirPath, aFilters, aFilterExpr, aSortFlags);
+
+        return;
+    }
+
+    // Send Operation Started Data
+    sendStarted();
+
+    // Check Abort Flag
+    __CHECK_OP_ABORTING;
+
+    // Sort & Send Dir List
+    sendDirList(lastDirListPath, lastDirList, aSortFlags);
+}
+
+//==============================================================================
+// Invalidate Last Dir List - Mutating Operations Make It Stale
+//==============================================================================
+void FileServerConnectionWorker::invalidateDirList()
+{
+    // Reset Last Dir List Path
+    lastDirListPath     = "";
+    // Clear Last Dir List
+    lastDirList.clear();
+}
+
+//==============================================================================
+// Sort & Send Dir List
+//==============================================================================
+void FileServerConnectionWorker::sendDirList(const QString& aDirPath, FileListing& aListing, const int& aSortFlags)
+{
     // Get Dir First
     bool dirFirst           = aSortFlags & DEFAULT_SORT_DIRFIRST;
     // Get Reverse
@@ -754,26 +1074,26 @@ void FileServerConnectionWorker::getDirList(const QString& aDirPath, const int&
     FileSortType sortType   = (FileSortType)(aSortFlags & 0x000F);
 
     // Sort
-    sortFileList(fiList, sortType, reverse, dirFirst, caseSensitive, abortFlag);
+    aListing.sort(sortType, reverse, dirFirst, caseSensitive, abortFlag);
 
     // Check Abort Flag
     __CHECK_OP_ABORTING;
 
-    // Get File Info List Count
-    int filCount = fiList.count();
+    // Get Listing Count
+    int lCount = aListing.count();
 
-    qDebug() << "FileServerConnectionWorker::getDirList - cID: " << cID << " - aDirPath: " << aDirPath << " - eilCount: " << filCount << " - st: " << sortType << " - df: " << dirFirst << " - r: " << reverse << " - cs: " << caseSensitive;
+    qDebug() << "FileServerConnectionWorker::sendDirList - cID: " << cID << " - aDirPath: " << aDirPath << " - lCount: " << lCount << " - st: " << sortType << " - df: " << dirFirst << " - r: " << reverse << " - cs: " << caseSensitive;
 
     // Go Thru List
-    for (int i = 0; i < filCount; ++i) {
+    for (int i = 0; i < lCount; ++i) {
         // Check Abort Flag
         __CHECK_OP_ABORTING;
 
-        // Get File Name
-        QString fileName = fiList[i].fileName();
+        // Get Entry Index
+        int index = aListing.indexAt(i);
 
         // Check Local Path
-        if (localPath == QString("/") && fileName == "..") {
+        if (aDirPath == QString("/") && aListing.isDotDot(index)) {
             // Skip Double Dot In Root
             continue;
         }
@@ -782,7 +1102,7 @@ void FileServerConnectionWorker::getDirList(const QString& aDirPath, const int&
         __CHECK_OP_ABORTING;
 
         // Send Dir List Item Found
-        sendDirListItemFound(fileName);
+        sendDirListItemFound(aListing.fileName(index));
 
         // Sleep a Bit
         usleep(DEFAULT_DIR_LIST_SLEEP_TIIMEOUT_US);
@@ -795,6 +1115,45 @@ void FileServerConnectionWorker::getDirList(const QString& aDirPath, const int&
     sendFinished();
 }
 
+//==============================================================================
+// Start Background Dir Sizes Of Listed Sub Dirs
+//==============================================================================
+void FileServerConnectionWorker::startDirSizes(const QString& aDirPath, const FileListing& aListing)
+{
+    // Init Sub Dirs
+    QStringList subDirs;
+
+    // Get Listing Count
+    int lCount = aListing.count();
+
+    // Go Thru Listing - Sorted Order
+    for (int i=0; i<lCount; ++i) {
+        // Get Entry Index
+        int index = aListing.indexAt(i);
+
+        // Check Entry - Links Are Not Followed
+        if (aListing.isDir(index) && !aListing.isSymLink(index) && !aListing.isDotDot(index)) {
+            // Add Sub Dir
+            subDirs << aListing.fileName(index);
+        }
+    }
+
+    // Start Sizes
+    dirSizeWorker->startSizes(aDirPath, subDirs);
+}
+
+//==============================================================================
+// Cancel Background Dir Sizes
+//==============================================================================
+void FileServerConnectionWorker::cancelDirSizes()
+{
+    // Check Background Dir Size Worker
+    if (dirSizeWorker) {
+        // Cancel
+        dirSizeWorker->cancel();
+    }
+}
+
 //==============================================================================
 // Create Directory
 //==============================================================================
@@ -803,6 +1162,9 @@ void FileServerConnectionWorker::createDir(const QString& aDirPath)
     // Init Local Path
     QString localPath = aDirPath;
 
+    // Invalidate Last Dir List
+    invalidateDirList();
+
     // Send Started
     sendStarted();
 
@@ -857,6 +1219,9 @@ void FileServerConnectionWorker::createLink(const QString& aLinkPath, const QStr
     // Init Local Path
     QString localPath = aLinkPath;
 
+    // Invalidate Last Dir List
+    invalidateDirList();
+
     // Send Started
     sendStarted();
 
@@ -908,6 +1273,9 @@ void FileServerConnectionWorker::createLink(const QString& aLinkPath, const QStr
 //==============================================================================
 void FileServerConnectionWorker::listArchive(const QString& aFilePath, const QString& aDirPath, const int& aFilters, const int& aSortFlags)
 {
+    // Cancel Background Dir Sizes - Client Navigated Away
+    cancelDirSizes();
+
     // Init Local Path
     QString localPath = aFilePath;
 
@@ -1029,6 +1397,9 @@ void FileServerConnectionWorker::deleteOperation(const QString& aFilePath)
     // Init Local Path
     QString localPath = aFilePath;
 
+    // Invalidate Last Dir List
+    invalidateDirList();
+
     // Send Started
     sendStarted();
 
@@ -1126,11 +1497,31 @@ void FileServerConnectionWorker::deleteDirectory(const QString& aDirPath)
     // Check Abort Flag
     __CHECK_OP_ABORTING;
 
-    // Init Dir
-    QDir dir(localPath);
+    // Check Sym Link - The Walker Enters A Symlinked Root, Never Delete Through A Link
+    if (QFileInfo(localPath).isSymLink()) {
+        qWarning() << "FileServerConnectionWorker::deleteDirectory - localPath: " << localPath << " - SYMLINK, NOT WALKING!";
 
-    // Get File List
-    QStringList fileList = dir.entryList(QDir::AllEntries | QDir::Hidden | QDir::System | QDir::NoDotAndDotDot);
+        return;
+    }
+
+    // Init Walker - Single Level, Sub Dirs Are Queued Back By The Client
+    DirTreeWalker walker(localPath, EDTWFShowHidden, abortFlag);
+    // Set Max Depth
+    walker.setMaxDepth(1);
+
+    // Init File List
+    QStringList fileList;
+    // Init Entry
+    DirTreeWalkerEntry entry;
+
+    // Go Thru Entries
+    while (walker.next(entry)) {
+        // Check Type
+        if (entry.type != EDTWTError && entry.type != EDTWTLoop) {
+            // Add File Name
+            fileList << entry.fileName();
+        }
+    }
 
     // Check Abort Flag
     __CHECK_OP_ABORTING;
@@ -1219,6 +1610,9 @@ void FileServerConnectionWorker::deleteDirectory(const QString& aDirPath)
 
         qDebug() << "FileServerConnectionWorker::deleteDirectory - cID: " << cID << " - localPath: " << localPath;
 
+        // Init Dir
+        QDir dir(localPath);
+
         // Init Result
         bool result = true;
 
@@ -1290,7 +1684,7 @@ void FileServerConnectionWorker::setFileDateTime(const QString& aFilePath, const
 //==============================================================================
 // Scan Directory Size
 //==============================================================================
-void FileServerConnectionWorker::scanDirSize(const QString& aDirPath)
+void FileServerConnectionWorker::scanDirSize(const QString& aDirPath, const int& aBreakdownDepth, const int& aTopCount, const QString& aExclude, const int& aOptions)
 {
 
     // Init Local Path
@@ -1305,7 +1699,7 @@ void FileServerConnectionWorker::scanDirSize(const QString& aDirPath)
         return;
     }
 
-    qDebug() << "FileServerConnectionWorker::scanDirSize - cID: " << cID << " - localPath: " << localPath;
+    qDebug() << "FileServerConnectionWorker::scanDirSize - cID: " << cID << " - localPath: " << localPath << " - aBreakdownDepth: " << aBreakdownDepth << " - aExclude: " << aExclude;
 
     // Check Abort Flag
     __CHECK_OP_ABORTING;
@@ -1317,8 +1711,28 @@ void FileServerConnectionWorker::scanDirSize(const QString& aDirPath)
     // Init Dir Size
     quint64 dirSize = 0;
 
-    // Scan Dir Size
-    dirSize = scanDirectorySize(localPath, numDirs, numFiles, abortFlag, dirSizeScanProgressCB, this);
+    // Init Ignore Rules - NULL If Nothing Is Excluded
+    QSharedPointer<const IgnoreRules> ignoreRules = IgnoreRules::create(localPath, aExclude, aOptions & DEFAULT_SCAN_OPTION_IGNORE_FILES);
+
+    // Check Breakdown Depth & Ignore Rules
+    if (aBreakdownDepth >= 0 || !ignoreRules.isNull()) {
+        // Init Scanner
+        DirSizeScanner scanner(abortFlag, dirSizeScanProgressCB, this);
+
+        // Check Breakdown Depth
+        if (aBreakdownDepth >= 0) {
+            // Set Breakdown - Subtrees Are Sent As They Complete
+            scanner.setBreakdown(aBreakdownDepth, aTopCount, dirSizeBreakdownCB);
+        }
+
+        // Set Ignore Rules - Excluded Subtrees Are Not Opened
+        scanner.setIgnoreRules(ignoreRules);
+        // Scan Dir Size
+        dirSize = scanner.scan(localPath, numDirs, numFiles);
+    } else {
+        // Scan Dir Size
+        dirSize = scanDirectorySize(localPath, numDirs, numFiles, abortFlag, dirSizeScanProgressCB, this);
+    }
 
     // Send Dir Size Progress
     sendDirSizeScanProgress(localPath, numDirs, numFiles, dirSize);
@@ -1333,7 +1747,7 @@ void FileServerConnectionWorker::scanDirSize(const QString& aDirPath)
 //==============================================================================
 // Scan Directory Tree
 //==============================================================================
-void FileServerConnectionWorker::scanDirTree(const QString& aDirPath)
+void FileServerConnectionWorker::scanDirTree(const QString& aDirPath, const int& aFilters, const int& aDepth)
 {
     // Init Local Path
     QString localPath = aDirPath;
@@ -1348,9 +1762,70 @@ void FileServerConnectionWorker::scanDirTree(const QString& aDirPath)
         return;
     }
 
-    qDebug() << "FileServerConnectionWorker::scanDirTree - cID: " << cID << " - localPath: " << localPath;
+    qDebug() << "FileServerConnectionWorker::scanDirTree - cID: " << cID << " - localPath: " << localPath << " - aDepth: " << aDepth;
 
-    // ...
+    // Clear Dir Tree Items
+    dirTreeItems.clear();
+
+    // Scan Directory Tree - Items Are Sent In Batches Level By Level
+    scanDirectoryTree(localPath, aDepth, aFilters & DEFAULT_FILTER_SHOW_HIDDEN, abortFlag, dirTreeItemFoundCB, this);
+
+    // Check Pending Dir Tree Items
+    if (!dirTreeItems.isEmpty()) {
+        // Send Remaining Dir Tree Items
+        sendDirTreeItems(localPath, dirTreeItems);
+        // Clear Dir Tree Items
+        dirTreeItems.clear();
+    }
+
+    // Check Abort Flag
+    __CHECK_OP_ABORTING;
+
+    // Send Finished
+    sendFinished();
+}
+
+//==============================================================================
+// Index Directory - Content Search Index Built In The Background
+//==============================================================================
+void FileServerConnectionWorker::indexDir(const QString& aDirPath, const int& aFlags)
+{
+    // Init Local Path
+    QString localPath = aDirPath;
+
+    // Send Started
+    sendStarted();
+
+    qDebug() << "FileServerConnectionWorker::indexDir - cID: " << cID << " - localPath: " << localPath << " - aFlags: " << aFlags;
+
+    // Check Remove Flag
+    if (aFlags & DEFAULT_INDEX_FLAG_REMOVE) {
+        // Check Names Flag
+        if (aFlags & DEFAULT_INDEX_FLAG_NAMES) {
+            // Remove Name Index Root
+            NameIndexer::instance()->removeRoot(localPath);
+        } else {
+            // Remove Root
+            TrigramIndexer::instance()->removeRoot(localPath);
+        }
+
+    } else {
+        // Check File Exists
+        if (!checkSourceFileExists(localPath, true)) {
+            // Send Aborted
+            sendAborted(localPath);
+            return;
+        }
+
+        // Check Names Flag
+        if (aFlags & DEFAULT_INDEX_FLAG_NAMES) {
+            // Add Name Index Root - File Name Searches Use The Index Once It's Built
+            NameIndexer::instance()->addRoot(localPath);
+        } else {
+            // Add Root - Searches Use The Index Once It's Built
+            TrigramIndexer::instance()->addRoot(localPath);
+        }
+    }
 
     // Send Finished
     sendFinished();
@@ -1366,6 +1841,9 @@ void FileServerConnectionWorker::copyOperation(const QString& aSource, const QSt
     // Init Local Target
     QString localTarget = aTarget;
 
+    // Invalidate Last Dir List
+    invalidateDirList();
+
     // Check Abort Flag
     __CHECK_OP_ABORTING;
 
@@ -1726,22 +2204,25 @@ void FileServerConnectionWorker::copyDirectory(const QString& aSourceDir, const
 
     } while (!success && response == DEFAULT_CONFIRM_RETRY);
 
-    // Init Source Dir
-    QDir sourceDir(localSource);
-
-    // Init Filters
-    QDir::Filters filters = QDir::AllEntries | QDir::NoDotAndDotDot;
-
-    // Check Options
-    if (options & DEFAULT_COPY_OPTIONS_COPY_HIDDEN) {
-        // Adjust Filters
-        filters |=  QDir::Hidden;
-        filters |=  QDir::System;
+    // Init Walker - Single Level, Sub Dirs Are Queued Back By The Client
+    DirTreeWalker walker(localSource, (options & DEFAULT_COPY_OPTIONS_COPY_HIDDEN) ? EDTWFShowHidden : 0, abortFlag);
+    // Set Max Depth
+    walker.setMaxDepth(1);
+
+    // Init Source Entry List
+    QStringList sourceEntryList;
+    // Init Entry
+    DirTreeWalkerEntry entry;
+
+    // Go Thru Entries
+    while (walker.next(entry)) {
+        // Check Type
+        if (entry.type != EDTWTError && entry.type != EDTWTLoop) {
+            // Add File Name
+            sourceEntryList << entry.fileName();
+        }
     }
 
-    // Get Entry List
-    QStringList sourceEntryList = sourceDir.entryList(filters);
-
     // Get Entry List Count
     int selCount = sourceEntryList.count();
 
@@ -1784,6 +2265,9 @@ void FileServerConnectionWorker::moveOperation(const QString& aSource, const QSt
     // Init Local Target
     QString localTarget = aTarget;
 
+    // Invalidate Last Dir List
+    invalidateDirList();
+
     // Check Abort Flag
     __CHECK_OP_ABORTING;
 
@@ -2189,6 +2673,9 @@ void FileServerConnectionWorker::extractArchive(const QString& aSource, const QS
     // Init Local Target
     QString localTarget = aTarget;
 
+    // Invalidate Last Dir List
+    invalidateDirList();
+
     qDebug() << "FileServerConnectionWorker::extractArchive - cID: " << cID << " - aSource: " << aSource << " - aTarget: " << aTarget;
 
     // Send Started
@@ -2253,7 +2740,7 @@ void FileServerConnectionWorker::extractArchive(const QString& aSource, const QS
 //==============================================================================
 // Search File
 //==============================================================================
-void FileServerConnectionWorker::searchFile(const QString& aName, const QString& aDirPath, const QString& aContent, const int& aOptions)
+void FileServerConnectionWorker::searchFile(const QString& aName, const QString& aDirPath, const QStringList& aContentTerms, const QString& aExclude, const int& aOptions, const quint32& aResultsID)
 {
     // Init Local Path
     QString localPath = aDirPath;
@@ -2275,20 +2762,272 @@ void FileServerConnectionWorker::searchFile(const QString& aName, const QString&
     // Check Abort Flag
     __CHECK_OP_ABORTING;
 
+    // Check Content Matcher - Regular Expressions & Term Sets Rejected Before Walking
+    if (!aContentTerms.isEmpty() && !QScopedPointer<ContentMatcher>(createSearchContentMatcher(aContentTerms, aOptions))->isValid()) {
+        qWarning() << "FileServerConnectionWorker::searchFile - cID: " << cID << " - aContentTerms: " << aContentTerms << " - INVALID PATTERN!";
+
+        // Send Error
+        sendError(DEFAULT_ERROR_INVALID_PATTERN, localPath, "", "");
+
+        // Send Aborted
+        sendAborted(localPath, "", "");
+
+        return;
+    }
+
+    // Check Results ID - Refines The Kept Results Instead Of Walking
+    if (aResultsID) {
+        // Check Kept Results
+        if (aResultsID != searchResultsID || QDateTime::currentMSecsSinceEpoch() - searchResultsTime > DEFAULT_SEARCH_RESULTS_TTL_MS) {
+            qWarning() << "FileServerConnectionWorker::searchFile - cID: " << cID << " - aResultsID: " << aResultsID << " - EXPIRED!";
+
+            // Send Error
+            sendError(DEFAULT_ERROR_EXPIRED, localPath, "", "");
+
+            // Send Aborted
+            sendAborted(localPath, "", "");
+
+            return;
+        }
+
+        // Refine Search
+        refineSearch(aName, aContentTerms, aOptions);
+
+        // Check Abort Flag
+        __CHECK_OP_ABORTING;
+
+        // Send Search Results
+        sendSearchResults(searchResultsID, searchResults.count());
+
+        // Send Finished
+        sendFinished();
+
+        return;
+    }
+
+    // Clear Search Results
+    searchResults.clear();
+    // Reset Search Results ID
+    searchResultsID = 0;
+    // Set Collect Search Results
+    collectSearchResults = true;
+
     // Init Dir Info
     QFileInfo dirInfo(localPath);
 
     // Check Dir Info
     if (dirInfo.isDir() || dirInfo.isBundle()) {
-        qDebug() << "FileServerConnectionWorker::searchFile - cID: " << cID << " - aName: " << aName << " - aDirPath: " << aDirPath << " - aContent: " << aContent << " - aOptions: " << aOptions;
-
-        // Search Directory
-        searchDirectory(aDirPath, aName, aContent, aOptions, abortFlag, fileSearchItemFoundCB, this);
+        qDebug() << "FileServerConnectionWorker::searchFile - cID: " << cID << " - aName: " << aName << " - aDirPath: " << aDirPath << " - aContentTerms: " << aContentTerms << " - aExclude: " << aExclude << " - aOptions: " << aOptions;
+
+        // Init Stale
+        bool stale = false;
+        // Get Name Index - File Name Only Searches Are Answered From It, Archive Entries & Exclusions Are Not Indexed
+        QSharedPointer<NameIndex> nameIndex = aContentTerms.isEmpty() && aExclude.isEmpty() && !(aOptions & (DEFAULT_SEARCH_OPTION_NO_INDEX | DEFAULT_SEARCH_OPTION_ARCHIVES | DEFAULT_SEARCH_OPTION_IGNORE_FILES)) ? NameIndexer::instance()->indexFor(localPath, stale) : QSharedPointer<NameIndex>();
+
+        // Check Name Index
+        if (!nameIndex.isNull()) {
+            // Send Search Index State - Tells How Fresh The Results Are
+            sendSearchIndexState(nameIndex->buildTime(), stale);
+            // Search Name Index
+            nameIndex->search(localPath, GlobMatcher(getSearchFileNamePatterns(aName), false), abortFlag, fileSearchItemFoundCB, this);
+        } else {
+            // Search Directory
+            searchDirectory(aDirPath, aName, aContentTerms, aExclude, aOptions, abortFlag, fileSearchItemFoundCB, this);
+        }
 
         // Check Abort Flag
         __CHECK_OP_ABORTING;
     }
 
+    // Check Collect Search Results - Complete Results Are Kept
+    if (collectSearchResults) {
+        // Set Search Results ID
+        searchResultsID = ++lastSearchResultsID;
+        // Set Search Results Time
+        searchResultsTime = QDateTime::currentMSecsSinceEpoch();
+        // Reset Collect Search Results
+        collectSearchResults = false;
+    }
+
+    // Send Search Results - 0 If Not Kept
+    sendSearchResults(searchResultsID, searchResults.count());
+
+    // Send Finished
+    sendFinished();
+}
+
+//==============================================================================
+// Refine Search - Filters The Kept Results By Name & Content
+//==============================================================================
+void FileServerConnectionWorker::refineSearch(const QString& aName, const QStringList& aContentTerms, const int& aOptions)
+{
+    qDebug() << "FileServerConnectionWorker::refineSearch - cID: " << cID << " - aName: " << aName << " - aContentTerms: " << aContentTerms << " - count: " << searchResults.count();
+
+    // Init Previous Results
+    QList<ContentSearchItem> previousResults;
+    // Take Kept Results - Refined Results Are Collected Again
+    previousResults.swap(searchResults);
+
+    // Reset Search Results ID
+    searchResultsID = 0;
+    // Set Collect Search Results
+    collectSearchResults = true;
+
+    // Init File Name Matcher - Empty Pattern Keeps Every Result
+    GlobMatcher fileNameMatcher(getSearchFileNamePatterns(aName), false);
+    // Init Content Matcher
+    QScopedPointer<ContentMatcher> contentMatcher(createSearchContentMatcher(aContentTerms, aOptions));
+    // Init Content Search Pool - Only The Kept Files Are Re-Read
+    QScopedPointer<ContentSearchPool> contentSearchPool(aContentTerms.isEmpty() ? NULL : new ContentSearchPool(path, *contentMatcher, aOptions & DEFAULT_SEARCH_OPTION_ORDERED, abortFlag, fileSearchItemFoundCB, this));
+
+    // Go Thru Previous Results
+    for (int i=0; i<previousResults.count() && !abortFlag; ++i) {
+        // Get Result
+        const ContentSearchItem& result = previousResults[i];
+
+        // Check File Name
+        if (!fileNameMatcher.match(result.filePath.mid(result.filePath.lastIndexOf(QChar('/')) + 1))) {
+            continue;
+        }
+
+        // Check Content Search Pool
+        if (!contentSearchPool.isNull()) {
+            // Add File To Content Search Pool - Archive Entries Can't Be Opened And Drop Out
+            contentSearchPool->add(result.dirPath, result.filePath);
+        } else {
+            // Report Result - Previous Content Hit Kept
+            fileSearchItemFoundCB(result.dirPath, result.filePath, result.hit ? &result.contentHit : NULL, this);
+        }
+    }
+
+    // Check Content Search Pool
+    if (!contentSearchPool.isNull()) {
+        // Finish Content Search - Reports Remaining Hits
+        contentSearchPool->finish();
+    }
+
+    // Check Abort Flag - Partial Results Are Not Kept
+    if (abortFlag) {
+        // Clear Search Results
+        searchResults.clear();
+        // Reset Collect Search Results
+        collectSearchResults = false;
+
+        return;
+    }
+
+    // Check Collect Search Results
+    if (collectSearchResults) {
+        // Set Search Results ID
+        searchResultsID = ++lastSearchResultsID;
+        // Set Search Results Time
+        searchResultsTime = QDateTime::currentMSecsSinceEpoch();
+        // Reset Collect Search Results
+        collectSearchResults = false;
+    }
+}
+
+//==============================================================================
+// Add Search Result - Kept For Refining
+//==============================================================================
+void FileServerConnectionWorker::addSearchResult(const QString& aPath, const QString& aFileName, const ContentHit* aHit)
+{
+    // Check Collect Search Results
+    if (!collectSearchResults) {
+        return;
+    }
+
+    // Check Count
+    if (searchResults.count() >= DEFAULT_SEARCH_RESULTS_MAX_ITEMS) {
+        // Reset Collect Search Results - Too Many To Keep
+        collectSearchResults = false;
+        // Clear Search Results
+        searchResults.clear();
+
+        return;
+    }
+
+    // Init Result
+    ContentSearchItem result;
+
+    // Setup Result
+    result.dirPath  = aPath;
+    result.filePath = aFileName;
+    result.hit      = aHit && aHit->offset >= 0;
+
+    // Check Hit
+    if (result.hit) {
+        // Set Content Hit
+        result.contentHit = *aHit;
+    }
+
+    // Add Result
+    searchResults << result;
+}
+
+//==============================================================================
+// Find File - Fuzzy File Name Matches, Best First
+//==============================================================================
+void FileServerConnectionWorker::findFile(const QString& aQuery, const QString& aDirPath, const int& aTopCount)
+{
+    // Init Local Path
+    QString localPath = aDirPath;
+
+    // Check Abort Flag
+    __CHECK_OP_ABORTING;
+
+    // Send Started
+    sendStarted();
+
+    // Check Source File Exists
+    if (!checkSourceFileExists(localPath, true)) {
+        // Send Aborted
+        sendAborted("");
+
+        return;
+    }
+
+    // Check Abort Flag
+    __CHECK_OP_ABORTING;
+
+    //qDebug() << "FileServerConnectionWorker::findFile - cID: " << cID << " - aQuery: " << aQuery << " - aDirPath: " << aDirPath << " - aTopCount: " << aTopCount;
+
+    // Start Query - A Longer Query Of The Same Dir Re-Scores The Last Matches Only
+    if (fuzzyFinder.startQuery(localPath, aQuery, aTopCount)) {
+        // Refine Last Matches
+        fuzzyFinder.refine(abortFlag);
+    } else {
+        // Init Stale
+        bool stale = false;
+        // Get Name Index
+        QSharedPointer<NameIndex> nameIndex = NameIndexer::instance()->indexFor(localPath, stale);
+
+        // Check Name Index
+        if (!nameIndex.isNull()) {
+            // Send Search Index State - Tells How Fresh The Results Are
+            sendSearchIndexState(nameIndex->buildTime(), stale);
+            // Scan Name Index
+            fuzzyFinder.scanIndex(*nameIndex, abortFlag);
+        } else {
+            // Walk Dir Tree
+            fuzzyFinder.walk(abortFlag);
+        }
+    }
+
+    // Finish - Drops Partial Matches On Abort
+    QList<FuzzyMatch> results = fuzzyFinder.finish(abortFlag);
+
+    // Check Abort Flag
+    __CHECK_OP_ABORTING;
+
+    // Go Thru Results
+    for (int i=0; i<results.count(); ++i) {
+        // Get File Path
+        QString resultPath = QFile::decodeName(results[i].path);
+        // Send Find File Item
+        sendFindFileItem(resultPath.left(resultPath.lastIndexOf(QChar('/')) + 1), resultPath, results[i].score, i + 1);
+    }
+
     // Send Finished
     sendFinished();
 }
@@ -2733,18 +3472,86 @@ void FileServerConnectionWorker::dirSizeScanProgressCB(const QString& aPath,
     }
 }
 
+//==============================================================================
+// Dir Size Update Callback - Background Thread
+//==============================================================================
+void FileServerConnectionWorker::dirSizeUpdateCB(const QString& aDirPath,
+                                                 const QString& aFileName,
+                                                 const quint64& aNumDirs,
+                                                 const quint64& aNumFiles,
+                                                 const quint64& aSize,
+                                                 void* aContext)
+{
+    // Get Context
+    FileServerConnectionWorker* self = static_cast<FileServerConnectionWorker*>(aContext);
+
+    // Check Self
+    if (self) {
+        // Send Dir Size
+        self->sendDirSize(aDirPath, aFileName, aNumDirs, aNumFiles, aSize);
+    }
+}
+
+//==============================================================================
+// Dir Size Breakdown Callback
+//==============================================================================
+void FileServerConnectionWorker::dirSizeBreakdownCB(const DirSizeBreakdown& aBreakdown, void* aContext)
+{
+    // Get Context
+    FileServerConnectionWorker* self = static_cast<FileServerConnectionWorker*>(aContext);
+
+    // Check Self
+    if (self) {
+        // Send Dir Size Breakdown
+        self->sendDirSizeBreakdown(aBreakdown);
+    }
+}
+
+//==============================================================================
+// Dir Tree Item Found Callback
+//==============================================================================
+void FileServerConnectionWorker::dirTreeItemFoundCB(const QString& aPath, const int& aDepth, const bool& aHasSub, void* aContext)
+{
+    // Get Context
+    FileServerConnectionWorker* self = static_cast<FileServerConnectionWorker*>(aContext);
+
+    // Check Self
+    if (self) {
+        // Init Item
+        QVariantMap item;
+
+        // Setup Item
+        item[DEFAULT_KEY_PATH]      = aPath;
+        item[DEFAULT_KEY_DEPTH]     = aDepth;
+        item[DEFAULT_KEY_HASSUB]    = aHasSub;
+
+        // Add Item
+        self->dirTreeItems << item;
+
+        // Check Batch Size
+        if (self->dirTreeItems.count() >= DEFAULT_DIR_TREE_BATCH_SIZE) {
+            // Send Dir Tree Items
+            self->sendDirTreeItems(self->path, self->dirTreeItems);
+            // Clear Dir Tree Items
+            self->dirTreeItems.clear();
+        }
+    }
+}
+
 //==============================================================================
 // File Search Item Found Callback
 //==============================================================================
-void FileServerConnectionWorker::fileSearchItemFoundCB(const QString& aPath, const QString& aFileName, void* aContext)
+void FileServerConnectionWorker::fileSearchItemFoundCB(const QString& aPath, const QString& aFileName, const ContentHit* aHit, void* aContext)
 {
     // Get Context
     FileServerConnectionWorker* self = static_cast<FileServerConnectionWorker*>(aContext);
 
     // Check Self
     if (self) {
+        // Add Search Result
+        self->addSearchResult(aPath, aFileName, aHit);
         // Send Dir Size Scan Progress
-        self->sendSearchFileItemFound(aPath, aFileName);
+        self->sendSearchFileItemFound(aPath, aFileName, aHit);
     }
 }
 
@@ -2756,7 +3563,12 @@ FileServerConnectionWorker::~FileServerConnectionWorker()
     // Stop Worker
     stopWorker();
 
-    // ...
+    // Check Background Dir Size Worker
+    if (dirSizeWorker) {
+        // Delete Background Dir Size Worker - Waits For It
+        delete dirSizeWorker;
+        dirSizeWorker = NULL;
+    }
 
     qDebug() << "FileServerConnectionWorker::~FileServerConnectionWorker";
 }
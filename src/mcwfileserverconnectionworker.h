@@ -7,10 +7,19 @@
 #include <QMutex>
 #include <QVariantMap>
 #include <QByteArray>
+#include <QStringList>
 #include <QDir>
+#include <QDateTime>
+
+#include "mcwfilelisting.h"
+#include "mcwdirscanner.h"
+#include "mcwfuzzyfinder.h"
+#include "mcwcontentsearch.h"
 
 class FileServerConnection;
 class ArchiveEngine;
+class DirSizeWorker;
+class ContentHit;
 
 //==============================================================================
 // File Server Connection Worker Status Type
@@ -52,6 +61,9 @@ enum FSCOperationType
     EFSCWOTResume,
     EFSCWOTAcknowledge,
     EFSCWOTClearOpt,
+    EFSCWOTResortDir,
+    EFSCWOTIndexDir,
+    EFSCWOTFindFile,
 
     EFSCWOTTest         = 0x00ff
 };
@@ -128,10 +140,22 @@ private:
     void sendDirListItemFound(const QString& aFileName);
     // Send Dir Size Scan Progress Data
     void sendDirSizeScanProgress(const QString& aPath, const quint64& aNumDirs, const quint64& aNumFiles, const quint64& aScannedSize);
+    // Send Dir Size Data - Background Size Of A Listed Sub Dir
+    void sendDirSize(const QString& aDirPath, const QString& aFileName, const quint64& aNumDirs, const quint64& aNumFiles, const quint64& aSize);
+    // Send Dir Size Breakdown Data
+    void sendDirSizeBreakdown(const DirSizeBreakdown& aBreakdown);
     // Send Archive List Item Found Data
     void sendArchiveListItemFound(const QString& aArchive, const QString& aFilePath, const quint64& aSize, const QDateTime& aDate, const QString& aAttribs, const int& aFlags);
-    // Send Search File Item Found Data
-    void sendSearchFileItemFound(const QString& aPath, const QString& aFileName);
+    // Send Dir Tree Items Data - Batched
+    void sendDirTreeItems(const QString& aPath, const QVariantList& aItems);
+    // Send Search File Item Found Data - Content Hit Location If Any
+    void sendSearchFileItemFound(const QString& aPath, const QString& aFileName, const ContentHit* aHit = NULL);
+    // Send Search Index State Data - Build Time & Pending Changes Of The Index Used
+    void sendSearchIndexState(const qint64& aBuildTime, const bool& aStale);
+    // Send Search Results Data - ID Of The Results Kept For Refining
+    void sendSearchResults(const quint32& aResultsID, const int& aCount);
+    // Send Find File Item Data - Score & Rank Of A Fuzzy Match
+    void sendFindFileItem(const QString& aPath, const QString& aFilePath, const int& aScore, const int& aRank);
     // Send Operation Finished Data
     void sendFinished(const QString& aOperation = "", const QString& aPath = "", const QString& aSource = "", const QString& aTarget = "");
 
@@ -152,7 +176,17 @@ private: // Operations
     void parseQueueItem(const QVariantMap& aDataMap);
 
     // Get Dir List
-    void getDirList(const QString& aDirPath, const int& aFilters, const int& aSortFlags);
+    void getDirList(const QString& aDirPath, const int& aFilters, const QVariantMap& aFilterExpr, const int& aSortFlags);
+    // Resort Last Dir List
+    void resortDirList(const QString& aDirPath, const int& aFilters, const QVariantMap& aFilterExpr, const int& aSortFlags);
+    // Invalidate Last Dir List - Mutating Operations Make It Stale
+    void invalidateDirList();
+    // Sort & Send Dir List
+    void sendDirList(const QString& aDirPath, FileListing& aListing, const int& aSortFlags);
+    // Start Background Dir Sizes Of Listed Sub Dirs
+    void startDirSizes(const QString& aDirPath, const FileListing& aListing);
+    // Cancel Background Dir Sizes
+    void cancelDirSizes();
 
     // Create Directory
     void createDir(const QString& aDirPath);
@@ -176,9 +210,11 @@ private: // Operations
     void setFileDateTime(const QString& aFilePath, const QDateTime& aDateTime);
 
     // Scan Directory Size
-    void scanDirSize(const QString& aDirPath);
+    void scanDirSize(const QString& aDirPath, const int& aBreakdownDepth, const int& aTopCount, const QString& aExclude, const int& aOptions);
     // Scan Directory Tree
-    void scanDirTree(const QString& aDirPath);
+    void scanDirTree(const QString& aDirPath, const int& aFilters, const int& aDepth);
+    // Index Directory - Content Search Index Built In The Background
+    void indexDir(const QString& aDirPath, const int& aFlags);
 
     // Copy Operation
     void copyOperation(const QString& aSource, const QString& aTarget);
@@ -189,7 +225,13 @@ private: // Operations
     void extractArchive(const QString& aSource, const QString& aTarget);
 
     // Search File
-    void searchFile(const QString& aName, const QString& aDirPath, const QString& aContent, const int& aOptions);
+    void searchFile(const QString& aName, const QString& aDirPath, const QStringList& aContentTerms, const QString& aExclude, const int& aOptions, const quint32& aResultsID);
+    // Refine Search - Filters The Kept Results By Name & Content
+    void refineSearch(const QString& aName, const QStringList& aContentTerms, const int& aOptions);
+    // Add Search Result - Kept For Refining
+    void addSearchResult(const QString& aPath, const QString& aFileName, const ContentHit* aHit);
+    // Find File - Fuzzy File Name Matches, Best First
+    void findFile(const QString& aQuery, const QString& aDirPath, const int& aTopCount);
 
     // Test Run
     void testRun();
@@ -246,8 +288,22 @@ private:
                                       const quint64& aScannedSize,
                                       void* aContext);
 
+    // Dir Size Update Callback
+    static void dirSizeUpdateCB(const QString& aDirPath,
+                                const QString& aFileName,
+                                const quint64& aNumDirs,
+                                const quint64& aNumFiles,
+                                const quint64& aSize,
+                                void* aContext);
+
+    // Dir Size Breakdown Callback
+    static void dirSizeBreakdownCB(const DirSizeBreakdown& aBreakdown, void* aContext);
+
+    // Dir Tree Item Found Callback
+    static void dirTreeItemFoundCB(const QString& aPath, const int& aDepth, const bool& aHasSub, void* aContext);
+
     // File Search Item Found Callback
-    static void fileSearchItemFoundCB(const QString& aPath, const QString& aFileName, void* aContext);
+    static void fileSearchItemFoundCB(const QString& aPath, const QString& aFileName, const ContentHit* aHit, void* aContext);
 
 private:
     friend class FileServerConnection;
@@ -290,8 +346,16 @@ private:
 
     // Filters
     int                         filters;
+    // Filter Expression
+    QVariantMap                 filterExpr;
     // Sort Flags
     int                         sortFlags;
+    // Dir Tree Depth
+    int                         depth;
+    // Dir Size Breakdown Depth - Negative If Disabled
+    int                         breakdownDepth;
+    // Top Count
+    int                         topCount;
 
     // Supress Merge Confirm
     bool                        supressMergeConfirm;
@@ -308,6 +372,41 @@ private:
     QString                     searchTerm;
     // Operation Search Content Pattern
     QString                     contentTerm;
+    // Operation Search Content Terms
+    QStringList                 contentTerms;
+    // Operation Exclude Patterns
+    QString                     excludeTerm;
+
+    // Last Dir List Path
+    QString                     lastDirListPath;
+    // Last Dir List Filters
+    int                         lastDirListFilters;
+    // Last Dir List Filter Expression
+    QVariantMap                 lastDirListFilterExpr;
+    // Last Dir List Dir Modification Time
+    QDateTime                   lastDirListModified;
+    // Last Dir List - Cached For Resorting
+    FileListing                 lastDirList;
+
+    // Fuzzy Finder - Last Matches Cached For Refining
+    FuzzyFinder                 fuzzyFinder;
+
+    // Search Results - Last Search Results Kept For Refining
+    QList<ContentSearchItem>    searchResults;
+    // Search Results ID - 0 If None Kept
+    quint32                     searchResultsID;
+    // Last Search Results ID
+    quint32                     lastSearchResultsID;
+    // Search Results Time - Msecs Since Epoch
+    qint64                      searchResultsTime;
+    // Collect Search Results - Cleared When There Are Too Many To Keep
+    bool                        collectSearchResults;
+
+    // Dir Tree Items - Pending Batch
+    QVariantList                dirTreeItems;
+
+    // Background Dir Size Worker
+    DirSizeWorker*              dirSizeWorker;
 
     // Current File Size
     quint64                     currSize;
@@ -0,0 +1,449 @@
+#include <QDir>
+#include <QFile>
+#include <QDateTime>
+#include <QtAlgorithms>
+#include <QDebug>
+
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "mcwfuzzyfinder.h"
+#include "mcwnameindex.h"
+#include "mcwtreewalker.h"
+#include "mcwconstants.h"
+
+
+//==============================================================================
+// Fold ASCII Byte - Same Folding As The Content Matcher
+//==============================================================================
+static inline uchar ffFold(const uchar& aByte)
+{
+    return (aByte >= 'A' && aByte <= 'Z') ? aByte | 0x20 : aByte;
+}
+
+//==============================================================================
+// Is Boundary - Start Of A Path Segment Or Word
+//==============================================================================
+static inline bool ffIsBoundary(const char* aPath, const int& aPos)
+{
+    // Check Start
+    if (aPos == 0) {
+        return true;
+    }
+
+    // Get Previous & Current Bytes
+    uchar prev = (uchar)aPath[aPos - 1];
+    uchar curr = (uchar)aPath[aPos];
+
+    return prev == '/' || prev == '_' || prev == '-' || prev == '.' || prev == ' ' || (prev >= 'a' && prev <= 'z' && curr >= 'A' && curr <= 'Z');
+}
+
+//==============================================================================
+// Is Subsequence - Every Byte Of aNeedle In Order In aHaystack
+//==============================================================================
+static inline bool ffIsSubsequence(const QByteArray& aNeedle, const QByteArray& aHaystack)
+{
+    // Init Needle Index
+    int n = 0;
+
+    // Go Thru Haystack
+    for (int i=0; i<aHaystack.size() && n<aNeedle.size(); ++i) {
+        // Check Byte
+        if (aHaystack[i] == aNeedle[n]) {
+            n++;
+        }
+    }
+
+    return n == aNeedle.size();
+}
+
+//==============================================================================
+// Match Less Than - Best First, Shorter Path On Ties
+//==============================================================================
+static bool matchLessThan(const FuzzyMatch& a, const FuzzyMatch& b)
+{
+    return a.score > b.score || (a.score == b.score && a.path.size() < b.path.size());
+}
+
+//==============================================================================
+// Constructor
+//==============================================================================
+FuzzyMatch::FuzzyMatch()
+    : relativeOffset(0)
+    , score(0)
+{
+}
+
+//==============================================================================
+// Constructor
+//==============================================================================
+FuzzyFinder::FuzzyFinder()
+    : topCount(DEFAULT_FIND_TOP_COUNT)
+    , matchesOverflow(false)
+    , lastQueryTime(0)
+{
+}
+
+//==============================================================================
+// Start Query - Returns true If It Refines The Last Query, Candidates Then Come From The Last Matches
+//==============================================================================
+bool FuzzyFinder::startQuery(const QString& aDirPath, const QString& aQuery, const int& aTopCount)
+{
+    // Set Dir Path
+    dirPath     = QDir::cleanPath(aDirPath);
+    // Set Top Count
+    topCount    = qMax(aTopCount, 1);
+
+    // Get Query - UTF-8 Bytes, Spaces Dropped
+    QByteArray utf8Query = aQuery.toUtf8();
+
+    // Clear Query
+    query.clear();
+
+    // Go Thru Query Bytes
+    for (int i=0; i<utf8Query.size(); ++i) {
+        // Check Space
+        if (utf8Query[i] != ' ') {
+            // Add Folded Byte
+            query.append((char)ffFold((uchar)utf8Query[i]));
+        }
+    }
+
+    // Clear Best Matches
+    bestMatches.clear();
+    // Reset Matches Overflow
+    matchesOverflow = false;
+
+    // Check Refined - Matches Of A Subsequence Of The Query Contain Every Match Of The Query
+    bool refined = !lastQuery.isEmpty() &&
+                   lastDirPath == dirPath &&
+                   QDateTime::currentMSecsSinceEpoch() - lastQueryTime < DEFAULT_FIND_CACHE_TTL_MS &&
+                   ffIsSubsequence(lastQuery, query);
+
+    // Check Refined
+    if (!refined) {
+        // Clear Matches
+        matches.clear();
+    }
+
+    // Reset Last Query - Set Again When Finished
+    lastQuery.clear();
+
+    return refined;
+}
+
+//==============================================================================
+// Refine - Re-Scores The Last Matches
+//==============================================================================
+void FuzzyFinder::refine(const bool& aAbort)
+{
+    // Init Candidates
+    QList<FuzzyMatch> candidates;
+    // Take Last Matches
+    candidates.swap(matches);
+
+    // Go Thru Candidates
+    for (int i=0; i<candidates.count() && !aAbort; ++i) {
+        // Add Path
+        addPath(candidates[i].path, candidates[i].relativeOffset);
+    }
+}
+
+//==============================================================================
+// Scan Index - Paths Under The Dir From A Name Index
+//==============================================================================
+void FuzzyFinder::scanIndex(const NameIndex& aIndex, const bool& aAbort)
+{
+    // Go Thru Index Paths
+    aIndex.paths(dirPath, aAbort, nameIndexPathCB, this);
+}
+
+//==============================================================================
+// Walk - Paths Under The Dir From A Live Tree Walk
+//==============================================================================
+void FuzzyFinder::walk(const bool& aAbort)
+{
+    // Get Relative Offset - Walker Paths Start With The Dir Prefix
+    int relativeOffset = QFile::encodeName(dirPath.endsWith("/") ? dirPath : dirPath + "/").size();
+
+    // Init Walker - No Stat, Recency Is Checked For The Best Matches Only
+    DirTreeWalker walker(dirPath, EDTWFShowHidden, aAbort);
+    // Init Entry
+    DirTreeWalkerEntry entry;
+
+    // Go Thru Entries
+    while (walker.next(entry)) {
+        // Check Type - Unreadable Dirs & Loops Are Skipped
+        if (entry.type == EDTWTFile || entry.type == EDTWTDir) {
+            // Add Path
+            addPath(entry.path, relativeOffset);
+        }
+    }
+}
+
+//==============================================================================
+// Finish - Applies Recency To The Best Matches, Returns The Top Matches Best First
+//==============================================================================
+QList<FuzzyMatch> FuzzyFinder::finish(const bool& aAbort)
+{
+    // Check Abort - Partial Matches Can't Be Refined
+    if (aAbort) {
+        // Reset
+        reset();
+
+        return QList<FuzzyMatch>();
+    }
+
+    // Get Current Time
+    qint64 now = QDateTime::currentMSecsSinceEpoch();
+
+    // Go Thru Best Matches
+    for (int i=0; i<bestMatches.count(); ++i) {
+        // Init Stat
+        struct stat matchStat;
+
+        // Stat Match - Don't Follow Links
+        if (lstat(bestMatches[i].path.constData(), &matchStat) != 0) {
+            continue;
+        }
+
+        // Get Age - Secs
+        qint64 age = now / 1000 - matchStat.st_mtime;
+
+        // Add Recency Bonus
+        if (age < 3600)
+            bestMatches[i].score += DEFAULT_FIND_SCORE_RECENT_HOUR;
+        else if (age < 24 * 3600)
+            bestMatches[i].score += DEFAULT_FIND_SCORE_RECENT_DAY;
+        else if (age < 7 * 24 * 3600)
+            bestMatches[i].score += DEFAULT_FIND_SCORE_RECENT_WEEK;
+    }
+
+    // Sort Best Matches
+    qStableSort(bestMatches.begin(), bestMatches.end(), matchLessThan);
+
+    // Check Matches Overflow
+    if (matchesOverflow) {
+        // Clear Matches
+        matches.clear();
+    } else {
+        // Set Last Query
+        lastQuery = query;
+    }
+
+    // Set Last Dir Path
+    lastDirPath     = dirPath;
+    // Set Last Query Time
+    lastQueryTime   = now;
+
+    return bestMatches.mid(0, topCount);
+}
+
+//==============================================================================
+// Reset - Drops The Last Matches
+//==============================================================================
+void FuzzyFinder::reset()
+{
+    // Clear Matches
+    matches.clear();
+    bestMatches.clear();
+    // Clear Last Query
+    lastQuery.clear();
+}
+
+//==============================================================================
+// Add Path - Scores The Part Below The Searched Dir
+//==============================================================================
+void FuzzyFinder::addPath(const QByteArray& aPath, const int& aRelativeOffset)
+{
+    // Check Query
+    if (query.isEmpty()) {
+        return;
+    }
+
+    // Get Score
+    int pathScore = score(aPath.constData() + aRelativeOffset, aPath.size() - aRelativeOffset);
+
+    // Check Score
+    if (pathScore < 0) {
+        return;
+    }
+
+    // Init Match
+    FuzzyMatch match;
+    // Setup Match
+    match.path              = aPath;
+    match.relativeOffset    = aRelativeOffset;
+    match.score             = pathScore;
+
+    // Check Matches Overflow
+    if (!matchesOverflow) {
+        // Check Matches Count
+        if (matches.count() < DEFAULT_FIND_MAX_MATCHES) {
+            // Add Match
+            matches << match;
+        } else {
+            // Set Matches Overflow - The Next Query Starts Over
+            matchesOverflow = true;
+            // Clear Matches
+            matches.clear();
+        }
+    }
+
+    // Get Best Count - Recency Reorders The Top, So Twice As Many Are Kept
+    int bestCount = topCount * 2;
+
+    // Check Best Matches
+    if (bestMatches.count() >= bestCount && !matchLessThan(match, bestMatches.last())) {
+        return;
+    }
+
+    // Insert Sorted
+    bestMatches.insert(qUpperBound(bestMatches.begin(), bestMatches.end(), match, matchLessThan) - bestMatches.begin(), match);
+
+    // Check Best Count
+    if (bestMatches.count() > bestCount) {
+        // Remove Worst
+        bestMatches.removeLast();
+    }
+}
+
+//==============================================================================
+// Score - -1 If The Query Is Not A Subsequence
+//==============================================================================
+int FuzzyFinder::score(const char* aPath, const int& aLength) const
+{
+    // Init Name Start
+    int nameStart = aLength;
+
+    // Find Name Start
+    while (nameStart > 0 && aPath[nameStart - 1] != '/') {
+        nameStart--;
+    }
+
+    // Get Length Penalty - Shorter Paths First
+    int lengthPenalty = aLength / DEFAULT_FIND_LENGTH_PENALTY_DIVISOR;
+
+    // Score Name - Matches Within The Name Rank Higher
+    int nameScore = scoreWindow(aPath, aLength, nameStart);
+
+    // Check Name Score
+    if (nameScore >= 0) {
+        return qMax(nameScore + DEFAULT_FIND_SCORE_NAME - lengthPenalty, 0);
+    }
+
+    // Score Path
+    int pathScore = nameStart > 0 ? scoreWindow(aPath, aLength, 0) : -1;
+
+    // Check Path Score
+    if (pathScore < 0) {
+        return -1;
+    }
+
+    return qMax(pathScore - lengthPenalty, 0);
+}
+
+//==============================================================================
+// Score Window - Leftmost Match In aFrom..aLength, Tightened Backwards
+//==============================================================================
+int FuzzyFinder::scoreWindow(const char* aPath, const int& aLength, const int& aFrom) const
+{
+    // Get Query
+    const char* q = query.constData();
+    // Get Query Length
+    int qLength = query.size();
+
+    // Init Query Index
+    int j = 0;
+    // Init Window End
+    int end = -1;
+
+    // Find Leftmost Match End
+    for (int i=aFrom; i<aLength; ++i) {
+        // Check Byte
+        if (ffFold((uchar)aPath[i]) == (uchar)q[j] && ++j == qLength) {
+            // Set Window End
+            end = i;
+            break;
+        }
+    }
+
+    // Check Window End
+    if (end < 0) {
+        return -1;
+    }
+
+    // Init Window Start
+    int start = end;
+    // Reset Query Index
+    j = qLength - 1;
+
+    // Tighten Window Backwards
+    for (int i=end; i>=aFrom; --i) {
+        // Check Byte
+        if (ffFold((uchar)aPath[i]) == (uchar)q[j] && j-- == 0) {
+            // Set Window Start
+            start = i;
+            break;
+        }
+    }
+
+    // Init Score
+    int result = 0;
+    // Init Previous Match
+    int prevMatch = -1;
+    // Reset Query Index
+    j = 0;
+
+    // Go Thru Window
+    for (int i=start; i<=end && j<qLength; ++i) {
+        // Check Byte
+        if (ffFold((uchar)aPath[i]) != (uchar)q[j]) {
+            continue;
+        }
+
+        // Add Match Score
+        result += DEFAULT_FIND_SCORE_MATCH;
+
+        // Check Boundary
+        if (ffIsBoundary(aPath, i)) {
+            // Add Boundary Bonus
+            result += DEFAULT_FIND_SCORE_BOUNDARY;
+        }
+
+        // Check Previous Match
+        if (prevMatch >= 0) {
+            // Check Contiguous
+            if (prevMatch == i - 1) {
+                // Add Contiguity Bonus
+                result += DEFAULT_FIND_SCORE_CONTIGUOUS;
+            } else {
+                // Sub Gap Penalty
+                result -= qMin(i - prevMatch - 1, DEFAULT_FIND_MAX_GAP_PENALTY);
+            }
+        }
+
+        // Set Previous Match
+        prevMatch = i;
+        // Inc Query Index
+        j++;
+    }
+
+    return qMax(result, 0);
+}
+
+//==============================================================================
+// Name Index Path Callback
+//==============================================================================
+void FuzzyFinder::nameIndexPathCB(const QByteArray& aPath, const int& aRelativeOffset, void* aContext)
+{
+    // Get Context
+    FuzzyFinder* self = static_cast<FuzzyFinder*>(aContext);
+
+    // Check Self
+    if (self) {
+        // Add Path
+        self->addPath(aPath, aRelativeOffset);
+    }
+}
@@ -0,0 +1,85 @@
+#ifndef FUZZYFINDER_H
+#define FUZZYFINDER_H
+
+#include <QString>
+#include <QByteArray>
+#include <QList>
+
+class NameIndex;
+
+
+//==============================================================================
+// Fuzzy Match
+//==============================================================================
+class FuzzyMatch
+{
+public:
+    // Constructor
+    FuzzyMatch();
+
+    // Path - Local 8 Bit
+    QByteArray  path;
+    // Relative Offset - Start Of The Part Below The Searched Dir
+    int         relativeOffset;
+    // Score
+    int         score;
+};
+
+//==============================================================================
+// Fuzzy Finder Class - Subsequence Matching, Ranked, Refined Per Keystroke
+//==============================================================================
+class FuzzyFinder
+{
+public:
+    // Constructor
+    FuzzyFinder();
+
+    // Start Query - Returns true If It Refines The Last Query, Candidates Then Come From The Last Matches
+    bool startQuery(const QString& aDirPath, const QString& aQuery, const int& aTopCount);
+
+    // Refine - Re-Scores The Last Matches
+    void refine(const bool& aAbort);
+    // Scan Index - Paths Under The Dir From A Name Index
+    void scanIndex(const NameIndex& aIndex, const bool& aAbort);
+    // Walk - Paths Under The Dir From A Live Tree Walk
+    void walk(const bool& aAbort);
+
+    // Finish - Applies Recency To The Best Matches, Returns The Top Matches Best First
+    QList<FuzzyMatch> finish(const bool& aAbort);
+
+    // Reset - Drops The Last Matches
+    void reset();
+
+private:
+    // Add Path - Scores The Part Below The Searched Dir
+    void addPath(const QByteArray& aPath, const int& aRelativeOffset);
+    // Score - -1 If The Query Is Not A Subsequence
+    int score(const char* aPath, const int& aLength) const;
+    // Score Window - Leftmost Match In aFrom..aLength, Tightened Backwards
+    int scoreWindow(const char* aPath, const int& aLength, const int& aFrom) const;
+
+    // Name Index Path Callback
+    static void nameIndexPathCB(const QByteArray& aPath, const int& aRelativeOffset, void* aContext);
+
+private:
+    // Dir Path
+    QString             dirPath;
+    // Query - Folded
+    QByteArray          query;
+    // Top Count
+    int                 topCount;
+    // Best Matches - Best First, Twice The Top Count Before Recency
+    QList<FuzzyMatch>   bestMatches;
+    // Matches - Every Match, Candidates For The Next Refined Query
+    QList<FuzzyMatch>   matches;
+    // Matches Overflow - Too Many To Keep
+    bool                matchesOverflow;
+    // Last Dir Path
+    QString             lastDirPath;
+    // Last Query - Folded, Empty If The Last Matches Can't Be Used
+    QByteArray          lastQuery;
+    // Last Query Time - Msecs Since Epoch
+    qint64              lastQueryTime;
+};
+
+#endif // FUZZYFINDER_H
@@ -0,0 +1,361 @@
+#include <QDebug>
+
+#include "mcwglobmatcher.h"
+
+
+//==============================================================================
+// Is Literal - No Wildcard Characters
+//==============================================================================
+static inline bool gmIsLiteral(const QString& aPattern)
+{
+    // Go Thru Characters
+    for (int i=0; i<aPattern.length(); ++i) {
+        // Get Character
+        QChar c = aPattern.at(i);
+
+        // Check Wildcard Characters
+        if (c == QChar('*') || c == QChar('?') || c == QChar('[')) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+//==============================================================================
+// Wildcard To Regular Expression - Same Syntax As QDir::match
+//==============================================================================
+static QString gmWildcardToRegExp(const QString& aPattern)
+{
+    // Init Result
+    QString result;
+
+    // Get Pattern Length
+    int pLength = aPattern.length();
+
+    // Go Thru Characters
+    for (int i=0; i<pLength; ++i) {
+        // Get Character
+        QChar c = aPattern.at(i);
+
+        // Check Star
+        if (c == QChar('*')) {
+            // Append Any Sequence
+            result += QString(".*");
+
+        // Check Question Mark
+        } else if (c == QChar('?')) {
+            // Append Any Character
+            result += QString(".");
+
+        // Check Bracket
+        } else if (c == QChar('[')) {
+            // Init Class End - A Leading ] Is Part Of The Class
+            int end = i + 1;
+
+            // Check Negation
+            if (end < pLength && aPattern.at(end) == QChar('!')) {
+                end++;
+            }
+
+            // Check Leading Close Bracket
+            if (end < pLength && aPattern.at(end) == QChar(']')) {
+                end++;
+            }
+
+            // Find Class End
+            while (end < pLength && aPattern.at(end) != QChar(']')) {
+                end++;
+            }
+
+            // Check Class End - Unterminated Bracket Is Literal
+            if (end >= pLength) {
+                // Append Escaped Bracket
+                result += QString("\\[");
+                continue;
+            }
+
+            // Get Class Body
+            QString body = aPattern.mid(i + 1, end - i - 1);
+
+            // Check Negation
+            if (body.startsWith(QChar('!'))) {
+                // Replace Negation
+                body[0] = QChar('^');
+            }
+
+            // Append Class - Backslashes Are Literal In Globs
+            result += QString("[") + body.replace(QString("\\"), QString("\\\\")) + QString("]");
+
+            // Skip Class
+            i = end;
+
+        } else {
+            // Append Escaped Character
+            result += QRegularExpression::escape(QString(c));
+        }
+    }
+
+    return result;
+}
+
+//==============================================================================
+// Constructor
+//==============================================================================
+GlobPatternSet::GlobPatternSet()
+    : matchAll(false)
+    , hasRegExp(false)
+{
+}
+
+//==============================================================================
+// Add Pattern - Pattern Is Folded If Case Insensitive
+//==============================================================================
+void GlobPatternSet::addPattern(const QString& aPattern)
+{
+    // Get Pattern Length
+    int pLength = aPattern.length();
+
+    // Check Pattern
+    if (pLength == 0) {
+        return;
+    }
+
+    // Check Literal
+    if (gmIsLiteral(aPattern)) {
+        // Add Literal
+        literals << aPattern;
+
+        return;
+    }
+
+    // Check Leading Star
+    if (aPattern.at(0) == QChar('*')) {
+        // Get Rest
+        QString rest = aPattern.mid(1);
+
+        // Check Literal Suffix
+        if (gmIsLiteral(rest)) {
+            // Check Empty Suffix
+            if (rest.isEmpty()) {
+                // Set Match All
+                matchAll = true;
+            } else {
+                // Add Suffix
+                suffixes << rest;
+
+                // Check Suffix Length
+                if (!suffixLengths.contains(rest.length())) {
+                    // Add Suffix Length
+                    suffixLengths << rest.length();
+                }
+            }
+
+            return;
+        }
+
+        // Check Literal Infix
+        if (rest.endsWith(QChar('*')) && gmIsLiteral(rest.left(rest.length() - 1))) {
+            // Check Empty Infix
+            if (rest.length() == 1) {
+                // Set Match All
+                matchAll = true;
+            } else {
+                // Add Infix
+                infixes << rest.left(rest.length() - 1);
+            }
+
+            return;
+        }
+    }
+
+    // Check Literal Prefix
+    if (aPattern.at(pLength - 1) == QChar('*') && gmIsLiteral(aPattern.left(pLength - 1))) {
+        // Add Prefix
+        prefixes << aPattern.left(pLength - 1);
+
+        return;
+    }
+
+    // Add Wildcard
+    wildcards << gmWildcardToRegExp(aPattern);
+}
+
+//==============================================================================
+// Compile - Combines The Remaining Patterns Into One Expression
+//==============================================================================
+void GlobPatternSet::compile(const bool& aCaseSensitive)
+{
+    // Set Has Combined Expression
+    hasRegExp = !matchAll && !wildcards.isEmpty();
+
+    // Check Has Combined Expression
+    if (!hasRegExp) {
+        return;
+    }
+
+    // Set Pattern - One Alternation, Anchored
+    regExp.setPattern(QString("^(?:%1)$").arg(wildcards.join(QString("|"))));
+    // Set Options
+    regExp.setPatternOptions(aCaseSensitive ? QRegularExpression::DotMatchesEverythingOption : QRegularExpression::DotMatchesEverythingOption | QRegularExpression::CaseInsensitiveOption);
+
+    // Check If Valid
+    if (!regExp.isValid()) {
+        qDebug() << "GlobPatternSet::compile - patterns: " << wildcards << " - INVALID!!";
+        // Reset Has Combined Expression
+        hasRegExp = false;
+
+        return;
+    }
+
+    // Compile Once
+    regExp.optimize();
+}
+
+//==============================================================================
+// Is Empty
+//==============================================================================
+bool GlobPatternSet::isEmpty() const
+{
+    return !matchAll && literals.isEmpty() && suffixes.isEmpty() && prefixes.isEmpty() && infixes.isEmpty() && !hasRegExp;
+}
+
+//==============================================================================
+// Match - File Name Is Folded If Case Insensitive
+//==============================================================================
+bool GlobPatternSet::match(const QString& aFolded, const QString& aFileName) const
+{
+    // Check Match All
+    if (matchAll) {
+        return true;
+    }
+
+    // Get Name Length
+    int nLength = aFolded.length();
+
+    // Go Thru Suffix Lengths - One Lookup Per Distinct Length
+    for (int i=0; i<suffixLengths.count(); ++i) {
+        // Check Suffix
+        if (suffixLengths[i] <= nLength && suffixes.contains(aFolded.right(suffixLengths[i]))) {
+            return true;
+        }
+    }
+
+    // Check Literals
+    if (!literals.isEmpty() && literals.contains(aFolded)) {
+        return true;
+    }
+
+    // Go Thru Prefixes
+    for (int i=0; i<prefixes.count(); ++i) {
+        // Check Prefix
+        if (aFolded.startsWith(prefixes[i])) {
+            return true;
+        }
+    }
+
+    // Go Thru Infixes
+    for (int i=0; i<infixes.count(); ++i) {
+        // Check Infix
+        if (aFolded.contains(infixes[i])) {
+            return true;
+        }
+    }
+
+    // Check Combined Expression
+    return hasRegExp && regExp.match(aFileName).hasMatch();
+}
+
+//==============================================================================
+// Constructor - Patterns Starting With ! Exclude
+//==============================================================================
+GlobMatcher::GlobMatcher(const QStringList& aPatterns, const bool& aCaseSensitive)
+    : caseSensitive(aCaseSensitive)
+{
+    // Set Patterns
+    setPatterns(aPatterns, aCaseSensitive);
+}
+
+//==============================================================================
+// Set Patterns - Patterns Starting With ! Exclude
+//==============================================================================
+void GlobMatcher::setPatterns(const QStringList& aPatterns, const bool& aCaseSensitive)
+{
+    // Set Case Sensitive
+    caseSensitive = aCaseSensitive;
+
+    // Reset Pattern Sets
+    includes = GlobPatternSet();
+    excludes = GlobPatternSet();
+
+    // Get Patterns Count
+    int pCount = aPatterns.count();
+
+    // Go Thru Patterns
+    for (int i=0; i<pCount; ++i) {
+        // Get Pattern - Folded Once If Case Insensitive
+        QString pattern = caseSensitive ? aPatterns[i] : aPatterns[i].toCaseFolded();
+
+        // Check Exclude
+        if (pattern.startsWith(QChar('!'))) {
+            // Add Exclude Pattern
+            excludes.addPattern(pattern.mid(1));
+        } else {
+            // Add Include Pattern
+            includes.addPattern(pattern);
+        }
+    }
+
+    // Compile Pattern Sets
+    includes.compile(caseSensitive);
+    excludes.compile(caseSensitive);
+}
+
+//==============================================================================
+// Split Patterns - Separated By Semicolons, Or By Spaces If There Are None
+//==============================================================================
+QStringList GlobMatcher::splitPatterns(const QString& aPatterns)
+{
+    // Get Separator
+    QChar separator = aPatterns.contains(QChar(';')) ? QChar(';') : QChar(' ');
+
+    // Init Patterns
+    QStringList patterns = aPatterns.split(separator, QString::SkipEmptyParts);
+
+    // Go Thru Patterns
+    for (int i=0; i<patterns.count(); ++i) {
+        // Trim Pattern
+        patterns[i] = patterns[i].trimmed();
+    }
+
+    return patterns;
+}
+
+//==============================================================================
+// Is Empty - Everything Matches
+//==============================================================================
+bool GlobMatcher::isEmpty() const
+{
+    return includes.isEmpty() && excludes.isEmpty();
+}
+
+//==============================================================================
+// Match - Any Include Matches Or There Are None, And No Exclude Matches
+//==============================================================================
+bool GlobMatcher::match(const QString& aFileName) const
+{
+    // Get Folded Name
+    QString folded = caseSensitive ? aFileName : aFileName.toCaseFolded();
+
+    // Check Includes
+    if (!includes.isEmpty() && !includes.match(folded, aFileName)) {
+        return false;
+    }
+
+    // Check Excludes
+    if (!excludes.isEmpty() && excludes.match(folded, aFileName)) {
+        return false;
+    }
+
+    return true;
+}
@@ -0,0 +1,82 @@
+#ifndef GLOBMATCHER_H
+#define GLOBMATCHER_H
+
+#include <QString>
+#include <QStringList>
+#include <QList>
+#include <QSet>
+#include <QRegularExpression>
+
+
+//==============================================================================
+// Glob Pattern Set Class - Literal Fast Paths & One Combined Expression
+//==============================================================================
+class GlobPatternSet
+{
+public:
+    // Constructor
+    GlobPatternSet();
+
+    // Add Pattern - Pattern Is Folded If Case Insensitive
+    void addPattern(const QString& aPattern);
+    // Compile - Combines The Remaining Patterns Into One Expression
+    void compile(const bool& aCaseSensitive);
+
+    // Is Empty
+    bool isEmpty() const;
+
+    // Match - File Name Is Folded If Case Insensitive
+    bool match(const QString& aFolded, const QString& aFileName) const;
+
+private:
+    // Match All - Pattern Is A Single Star
+    bool                    matchAll;
+    // Exact Names
+    QSet<QString>           literals;
+    // Literal Suffixes - *.cpp
+    QSet<QString>           suffixes;
+    // Literal Suffix Lengths - Distinct
+    QList<int>              suffixLengths;
+    // Literal Prefixes - Makefile*
+    QStringList             prefixes;
+    // Literal Infixes - *main*
+    QStringList             infixes;
+    // Wildcard Patterns - Translated, Pending Compile
+    QStringList             wildcards;
+    // Combined Expression
+    QRegularExpression      regExp;
+    // Has Combined Expression
+    bool                    hasRegExp;
+};
+
+//==============================================================================
+// Glob Matcher Class - Compiled Once Per Operation, Several Globs, ! Excludes
+//==============================================================================
+class GlobMatcher
+{
+public:
+    // Constructor - Patterns Starting With ! Exclude
+    explicit GlobMatcher(const QStringList& aPatterns = QStringList(), const bool& aCaseSensitive = false);
+
+    // Set Patterns - Patterns Starting With ! Exclude
+    void setPatterns(const QStringList& aPatterns, const bool& aCaseSensitive);
+
+    // Split Patterns - Separated By Semicolons, Or By Spaces If There Are None
+    static QStringList splitPatterns(const QString& aPatterns);
+
+    // Is Empty - Everything Matches
+    bool isEmpty() const;
+
+    // Match - Any Include Matches Or There Are None, And No Exclude Matches
+    bool match(const QString& aFileName) const;
+
+private:
+    // Case Sensitive
+    bool                    caseSensitive;
+    // Include Patterns
+    GlobPatternSet          includes;
+    // Exclude Patterns
+    GlobPatternSet          excludes;
+};
+
+#endif // GLOBMATCHER_H
@@ -0,0 +1,429 @@
+#include <QFile>
+#include <QStringList>
+#include <QDebug>
+
+#include "mcwignorerules.h"
+#include "mcwglobmatcher.h"
+#include "mcwconstants.h"
+
+
+//==============================================================================
+// Translate gitignore Glob To Regular Expression - Stars Stop At Slashes, ** Spans Dirs
+//==============================================================================
+static QString irTranslateGlob(const QString& aGlob)
+{
+    // Init Result
+    QString result;
+    // Get Glob Length
+    int gLength = aGlob.length();
+
+    // Go Thru Glob
+    for (int i=0; i<gLength; ++i) {
+        // Get Char
+        QChar c = aGlob.at(i);
+
+        // Check Star
+        if (c == QChar('*')) {
+            // Check Double Star At A Segment Start
+            if (i + 1 < gLength && aGlob.at(i + 1) == QChar('*') && (i == 0 || aGlob.at(i - 1) == QChar('/'))) {
+                // Get Next Position
+                int next = i + 2;
+
+                // Check End - Everything Below
+                if (next == gLength) {
+                    // Add Any Path
+                    result += ".*";
+                    // Skip Second Star
+                    i = next - 1;
+
+                    continue;
+                }
+
+                // Check Slash - Zero Or More Dirs
+                if (aGlob.at(next) == QChar('/')) {
+                    // Add Any Dirs
+                    result += "(?:.*/)?";
+                    // Skip Stars & Slash
+                    i = next;
+
+                    continue;
+                }
+            }
+
+            // Add Any Chars In Segment
+            result += "[^/]*";
+
+        // Check Question Mark
+        } else if (c == QChar('?')) {
+            // Add Any Char In Segment
+            result += "[^/]";
+
+        // Check Bracket
+        } else if (c == QChar('[')) {
+            // Init Closing Position
+            int close = i + 1;
+
+            // Skip Negation
+            if (close < gLength && (aGlob.at(close) == QChar('!') || aGlob.at(close) == QChar('^'))) {
+                close++;
+            }
+
+            // Skip Leading Bracket - Part Of The Class
+            if (close < gLength && aGlob.at(close) == QChar(']')) {
+                close++;
+            }
+
+            // Find Closing Bracket
+            while (close < gLength && aGlob.at(close) != QChar(']')) {
+                close++;
+            }
+
+            // Check Closing Bracket
+            if (close < gLength) {
+                // Get Class
+                QString charClass = aGlob.mid(i + 1, close - i - 1);
+
+                // Check Negation
+                if (charClass.startsWith(QChar('!'))) {
+                    // Set Negation
+                    charClass[0] = QChar('^');
+                }
+
+                // Add Class
+                result += QString("[%1]").arg(charClass);
+                // Skip Class
+                i = close;
+            } else {
+                // Add Literal Bracket
+                result += "\\[";
+            }
+
+        // Check Escape
+        } else if (c == QChar('\\') && i + 1 < gLength) {
+            // Add Escaped Char
+            result += QRegularExpression::escape(aGlob.mid(i + 1, 1));
+            // Skip Escaped Char
+            i++;
+
+        } else {
+            // Add Literal Char
+            result += QRegularExpression::escape(QString(c));
+        }
+    }
+
+    return result;
+}
+
+//==============================================================================
+// Find Wildcard - Returns -1 For Plain Names
+//==============================================================================
+static int irFindWildcard(const QString& aPattern, const int& aFrom)
+{
+    // Go Thru Pattern
+    for (int i=aFrom; i<aPattern.length(); ++i) {
+        // Get Char
+        QChar c = aPattern.at(i);
+
+        // Check Wildcard & Escape
+        if (c == QChar('*') || c == QChar('?') || c == QChar('[') || c == QChar('\\')) {
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+//==============================================================================
+// Constructor
+//==============================================================================
+IgnoreRule::IgnoreRule()
+    : type(EIRTName)
+    , negated(false)
+    , dirOnly(false)
+{
+}
+
+//==============================================================================
+// Parse - Returns false For Blank Lines & Comments
+//==============================================================================
+bool IgnoreRule::parse(const QString& aLine)
+{
+    // Init Pattern
+    QString pattern = aLine;
+
+    // Chop Line Breaks
+    while (pattern.endsWith(QChar('\n')) || pattern.endsWith(QChar('\r'))) {
+        pattern.chop(1);
+    }
+
+    // Chop Trailing Spaces - Unless Escaped
+    while (pattern.endsWith(QChar(' ')) && !pattern.endsWith("\\ ")) {
+        pattern.chop(1);
+    }
+
+    // Check Blank Line & Comment
+    if (pattern.isEmpty() || pattern.startsWith(QChar('#'))) {
+        return false;
+    }
+
+    // Check Negation
+    if (pattern.startsWith(QChar('!'))) {
+        // Set Negated
+        negated = true;
+        // Remove Mark
+        pattern.remove(0, 1);
+
+    // Check Escaped Mark
+    } else if (pattern.startsWith("\\!") || pattern.startsWith("\\#")) {
+        // Remove Escape
+        pattern.remove(0, 1);
+    }
+
+    // Check Trailing Slash - Dirs Only
+    if (pattern.endsWith(QChar('/'))) {
+        // Set Dirs Only
+        dirOnly = true;
+        // Remove Slash
+        pattern.chop(1);
+    }
+
+    // Check Pattern
+    if (pattern.isEmpty()) {
+        return false;
+    }
+
+    // Check Slash - A Slash At The Start Or In The Middle Anchors The Pattern To Its Dir
+    if (pattern.contains(QChar('/'))) {
+        // Check Leading Slash
+        if (pattern.startsWith(QChar('/'))) {
+            // Remove Slash
+            pattern.remove(0, 1);
+        }
+
+        // Set Type
+        type = EIRTPathRegExp;
+        // Set Regular Expression
+        regExp.setPattern(QString("^%1$").arg(irTranslateGlob(pattern)));
+
+        return regExp.isValid();
+    }
+
+    // Get Wildcard Position
+    int wildcard = irFindWildcard(pattern, 0);
+
+    // Check Wildcard - Plain Names Are Compared Directly
+    if (wildcard < 0) {
+        // Set Type
+        type    = EIRTName;
+        // Set Literal
+        literal = pattern;
+
+        return true;
+    }
+
+    // Check Suffix - *.o, *.log
+    if (wildcard == 0 && pattern.startsWith("*.") && irFindWildcard(pattern, 1) < 0) {
+        // Set Type
+        type    = EIRTSuffix;
+        // Set Literal
+        literal = pattern.mid(1);
+
+        return true;
+    }
+
+    // Set Type
+    type = EIRTNameRegExp;
+    // Set Regular Expression
+    regExp.setPattern(QString("^%1$").arg(irTranslateGlob(pattern)));
+
+    return regExp.isValid();
+}
+
+//==============================================================================
+// Match - Relative Path Is Only Used For Patterns With A Slash
+//==============================================================================
+bool IgnoreRule::match(const QString& aRelativePath, const QString& aName) const
+{
+    // Switch Type
+    switch (type) {
+        case EIRTName:          return aName == literal;
+        case EIRTSuffix:        return aName.endsWith(literal);
+        case EIRTNameRegExp:    return regExp.match(aName).hasMatch();
+        case EIRTPathRegExp:    return regExp.match(aRelativePath).hasMatch();
+
+        default:
+        break;
+    }
+
+    return false;
+}
+
+//==============================================================================
+// Constructor
+//==============================================================================
+IgnoreRules::IgnoreRules()
+    : root(NULL)
+    , readIgnoreFiles(false)
+{
+}
+
+//==============================================================================
+// Create - Request Patterns Override Ignore Files, NULL If Nothing Would Be Excluded
+//==============================================================================
+QSharedPointer<const IgnoreRules> IgnoreRules::create(const QString& aRootPath, const QString& aPatterns, const bool& aReadIgnoreFiles)
+{
+    // Init Rules
+    QSharedPointer<IgnoreRules> newRules(new IgnoreRules());
+
+    // Setup Rules
+    newRules->root              = newRules.data();
+    newRules->basePath          = aRootPath.endsWith(QChar('/')) ? aRootPath : aRootPath + QChar('/');
+    newRules->readIgnoreFiles   = aReadIgnoreFiles;
+
+    // Get Patterns - gitignore Syntax, Separated Like File Name Patterns
+    QStringList patterns = GlobMatcher::splitPatterns(aPatterns);
+
+    // Go Thru Patterns
+    for (int i=0; i<patterns.count(); ++i) {
+        // Init Rule
+        IgnoreRule rule;
+
+        // Parse Pattern
+        if (rule.parse(patterns[i])) {
+            // Add Override
+            newRules->overrides << rule;
+        }
+    }
+
+    // Check Read Ignore Files
+    if (aReadIgnoreFiles) {
+        // Init Git Dir Rule
+        IgnoreRule gitDirRule;
+
+        // Parse Git Dir Pattern - Never Worth Descending Into
+        if (gitDirRule.parse(DEFAULT_IGNORE_GIT_DIR_PATTERN)) {
+            // Add Rule
+            newRules->rules << gitDirRule;
+        }
+
+    // Check Overrides
+    } else if (newRules->overrides.isEmpty()) {
+        return QSharedPointer<const IgnoreRules>();
+    }
+
+    qDebug() << "IgnoreRules::create - aRootPath: " << aRootPath << " - overrides: " << newRules->overrides.count() << " - aReadIgnoreFiles: " << aReadIgnoreFiles;
+
+    return newRules;
+}
+
+//==============================================================================
+// For Dir - Parent Rules Plus The Ignore Files Of The Dir, The Parent Itself If There Are None
+//==============================================================================
+QSharedPointer<const IgnoreRules> IgnoreRules::forDir(const QSharedPointer<const IgnoreRules>& aParent, const QString& aDirPath)
+{
+    // Check Parent & Read Ignore Files
+    if (aParent.isNull() || !aParent->readIgnoreFiles) {
+        return aParent;
+    }
+
+    // Init Rules
+    QSharedPointer<IgnoreRules> newRules(new IgnoreRules());
+    // Get Dir Prefix
+    QString dirPrefix = aDirPath.endsWith(QChar('/')) ? aDirPath : aDirPath + QChar('/');
+
+    // Read Ignore Files - Later Files Win
+    bool found = newRules->readFile(dirPrefix + DEFAULT_IGNORE_FILE_GIT);
+    found = newRules->readFile(dirPrefix + DEFAULT_IGNORE_FILE_IGNORE) || found;
+
+    // Check Rules
+    if (!found || newRules->rules.isEmpty()) {
+        return aParent;
+    }
+
+    // Setup Rules
+    newRules->parent            = aParent;
+    newRules->root              = aParent->root;
+    newRules->basePath          = dirPrefix;
+    newRules->readIgnoreFiles   = true;
+
+    return newRules;
+}
+
+//==============================================================================
+// Read Ignore File - Returns false If It Doesn't Exist
+//==============================================================================
+bool IgnoreRules::readFile(const QString& aFilePath)
+{
+    // Init File
+    QFile file(aFilePath);
+
+    // Open File
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    // Go Thru Lines
+    while (!file.atEnd()) {
+        // Init Rule
+        IgnoreRule rule;
+
+        // Parse Line
+        if (rule.parse(QString::fromUtf8(file.readLine()))) {
+            // Add Rule
+            rules << rule;
+        }
+    }
+
+    return true;
+}
+
+//==============================================================================
+// Match Rules - 1 Excluded, 0 Included, -1 No Rule Matched
+//==============================================================================
+int IgnoreRules::matchRules(const QList<IgnoreRule>& aRules, const QString& aRelativePath, const QString& aName, const bool& aIsDir)
+{
+    // Go Thru Rules - Last Matching Line Wins
+    for (int i=aRules.count()-1; i>=0; --i) {
+        // Get Rule
+        const IgnoreRule& rule = aRules[i];
+
+        // Check Dirs Only & Match
+        if ((!rule.dirOnly || aIsDir) && rule.match(aRelativePath, aName)) {
+            return rule.negated ? 0 : 1;
+        }
+    }
+
+    return -1;
+}
+
+//==============================================================================
+// Is Excluded - Deeper Rules & Later Lines Win, Request Patterns Are Checked First
+//==============================================================================
+bool IgnoreRules::isExcluded(const QString& aPath, const QString& aName, const bool& aIsDir) const
+{
+    // Match Overrides - Relative To The Root
+    int result = matchRules(root->overrides, aPath.mid(root->basePath.length()), aName, aIsDir);
+
+    // Check Result
+    if (result >= 0) {
+        return result == 1;
+    }
+
+    // Go Thru Rules - Deepest Dir First
+    for (const IgnoreRules* dirRules = this; dirRules; dirRules = dirRules->parent.data()) {
+        // Check Rules
+        if (dirRules->rules.isEmpty()) {
+            continue;
+        }
+
+        // Match Rules - Relative To Their Dir
+        result = matchRules(dirRules->rules, aPath.mid(dirRules->basePath.length()), aName, aIsDir);
+
+        // Check Result
+        if (result >= 0) {
+            return result == 1;
+        }
+    }
+
+    return false;
+}
@@ -0,0 +1,88 @@
+#ifndef IGNORERULES_H
+#define IGNORERULES_H
+
+#include <QString>
+#include <QList>
+#include <QSharedPointer>
+#include <QRegularExpression>
+
+
+//==============================================================================
+// Ignore Rule Type
+//==============================================================================
+enum IgnoreRuleType
+{
+    EIRTName            = 0,
+    EIRTSuffix,
+    EIRTNameRegExp,
+    EIRTPathRegExp
+};
+
+//==============================================================================
+// Ignore Rule - One gitignore Line
+//==============================================================================
+class IgnoreRule
+{
+public:
+    // Constructor
+    IgnoreRule();
+
+    // Parse - Returns false For Blank Lines & Comments
+    bool parse(const QString& aLine);
+
+    // Match - Relative Path Is Only Used For Patterns With A Slash
+    bool match(const QString& aRelativePath, const QString& aName) const;
+
+    // Type
+    IgnoreRuleType      type;
+    // Literal - Name Or Suffix
+    QString             literal;
+    // Regular Expression
+    QRegularExpression  regExp;
+    // Negated - Re-Includes
+    bool                negated;
+    // Dirs Only - Trailing Slash
+    bool                dirOnly;
+};
+
+//==============================================================================
+// Ignore Rules Class - Immutable, One Per Dir With Ignore Files, Chained To The Parent Dir
+//==============================================================================
+class IgnoreRules
+{
+public:
+    // Create - Request Patterns Override Ignore Files, NULL If Nothing Would Be Excluded
+    static QSharedPointer<const IgnoreRules> create(const QString& aRootPath, const QString& aPatterns, const bool& aReadIgnoreFiles);
+
+    // For Dir - Parent Rules Plus The Ignore Files Of The Dir, The Parent Itself If There Are None
+    static QSharedPointer<const IgnoreRules> forDir(const QSharedPointer<const IgnoreRules>& aParent, const QString& aDirPath);
+
+    // Is Excluded - Deeper Rules & Later Lines Win, Request Patterns Are Checked First
+    bool isExcluded(const QString& aPath, const QString& aName, const bool& aIsDir) const;
+
+private:
+    // Constructor
+    IgnoreRules();
+
+    // Read Ignore File - Returns false If It Doesn't Exist
+    bool readFile(const QString& aFilePath);
+
+    // Match Rules - 1 Excluded, 0 Included, -1 No Rule Matched
+    static int matchRules(const QList<IgnoreRule>& aRules, const QString& aRelativePath, const QString& aName, const bool& aIsDir);
+
+private:
+    // Parent Rules
+    QSharedPointer<const IgnoreRules>   parent;
+    // Root Rules - Holds The Request Patterns
+    const IgnoreRules*                  root;
+    // Base Path - With Trailing Slash
+    QString                             basePath;
+    // Rules - Ignore File Lines In Order
+    QList<IgnoreRule>                   rules;
+    // Override Rules - Request Patterns, Root Only
+    QList<IgnoreRule>                   overrides;
+    // Read Ignore Files
+    bool                                readIgnoreFiles;
+};
+
+#endif // IGNORERULES_H
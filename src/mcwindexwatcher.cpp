@@ -0,0 +1,877 @@
+#include <QDir>
+#include <QDateTime>
+#include <QMutexLocker>
+#include <QDebug>
+
+#include <unistd.h>
+#include <errno.h>
+
+#if defined(Q_OS_LINUX)
+#include <sys/inotify.h>
+#endif // Q_OS_LINUX
+
+#include "mcwindexwatcher.h"
+#include "mcwconstants.h"
+
+
+//==============================================================================
+// Get Dir Prefix
+//==============================================================================
+static inline QString iwDirPrefix(const QString& aDirPath)
+{
+    return aDirPath.endsWith("/") ? aDirPath : aDirPath + "/";
+}
+
+//==============================================================================
+// Constructor
+//==============================================================================
+IndexWatchRoot::IndexWatchRoot()
+    : changeTime(0)
+    , buildTime(0)
+    , watchesComplete(false)
+{
+}
+
+//==============================================================================
+// Constructor
+//==============================================================================
+IndexWatcher::IndexWatcher()
+    : QThread(NULL)
+    , abortFlag(false)
+    , buildAbort(false)
+    , activeClient(NULL)
+    , watchFd(-1)
+{
+#if defined(Q_OS_LINUX)
+    // Init inotify - One For Every Index
+    watchFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+#endif // Q_OS_LINUX
+
+    // Start Thread - Never Competes With Operations
+    start(QThread::IdlePriority);
+}
+
+//==============================================================================
+// Get Instance
+//==============================================================================
+IndexWatcher* IndexWatcher::instance()
+{
+    // Init Instance
+    static IndexWatcher watcherInstance;
+
+    return &watcherInstance;
+}
+
+//==============================================================================
+// Add Client - Its Indexes Are Loaded On The Watcher Thread
+//==============================================================================
+void IndexWatcher::addClient(IndexWatcherClient* aClient)
+{
+    // Init Locker
+    QMutexLocker locker(&mutex);
+
+    // Check Client
+    if (roots.contains(aClient)) {
+        return;
+    }
+
+    // Add Client
+    clients << aClient;
+    // Add Client To Load
+    pendingClients << aClient;
+    // Init Client Roots
+    roots[aClient].clear();
+
+    // Wake Watcher
+    condition.wakeAll();
+}
+
+//==============================================================================
+// Remove Client - Waits Until The Watcher Thread Is Done With It
+//==============================================================================
+void IndexWatcher::removeClient(IndexWatcherClient* aClient)
+{
+    // Init Locker
+    QMutexLocker locker(&mutex);
+
+    // Remove Client
+    clients.removeAll(aClient);
+    // Remove Client To Load
+    pendingClients.removeAll(aClient);
+
+    // Get Client Roots
+    QList<QString> rootPaths = roots.value(aClient).keys();
+
+    // Go Thru Client Roots
+    for (int i=0; i<rootPaths.count(); ++i) {
+        // Add Owner To Unwatch - Index Files Are Kept
+        removedOwners << IndexWatchOwner(aClient, rootPaths[i]);
+    }
+
+    // Remove Client Roots
+    roots.remove(aClient);
+
+    // Check Active Client
+    if (activeClient == aClient) {
+        // Set Build Abort Flag
+        buildAbort = true;
+
+        // Wait For The Watcher Thread To Leave The Client
+        while (activeClient == aClient) {
+            // Wait
+            condition.wait(&mutex);
+        }
+    }
+}
+
+//==============================================================================
+// Add Root - Nested Roots Are Merged Into The Outermost One
+//==============================================================================
+void IndexWatcher::addRoot(IndexWatcherClient* aClient, const QString& aRootPath)
+{
+    // Get Root Path
+    QString rootPath = QDir::cleanPath(aRootPath);
+    // Get Root Prefix
+    QString rootPrefix = iwDirPrefix(rootPath);
+
+    qDebug() << "IndexWatcher::addRoot - rootPath: " << rootPath;
+
+    // Init Locker
+    QMutexLocker locker(&mutex);
+
+    // Check Client
+    if (!roots.contains(aClient)) {
+        return;
+    }
+
+    // Get Client Roots
+    QMap<QString, IndexWatchRoot>& clientRoots = roots[aClient];
+    // Init Iterator
+    QMap<QString, IndexWatchRoot>::iterator it = clientRoots.begin();
+
+    // Go Thru Roots
+    while (it != clientRoots.end()) {
+        // Check Covered By An Indexed Root
+        if (rootPath != it.key() && rootPath.startsWith(iwDirPrefix(it.key()))) {
+            qDebug() << "IndexWatcher::addRoot - rootPath: " << rootPath << " - ALREADY INDEXED UNDER: " << it.key();
+            return;
+        }
+
+        // Check Nested Root
+        if (it.key().startsWith(rootPrefix)) {
+            // Add Owner To Unwatch
+            removedOwners << IndexWatchOwner(aClient, it.key());
+            // Drop Nested Root Index
+            aClient->dropRoot(it.key());
+
+            // Check Building Root
+            if (activeClient == aClient && buildingRoot == it.key()) {
+                // Set Build Abort Flag
+                buildAbort = true;
+            }
+
+            // Remove Nested Root
+            it = clientRoots.erase(it);
+
+        } else {
+            ++it;
+        }
+    }
+
+    // Keep Watches - Root Removed & Added Again Before They Were Unwatched
+    removedOwners.removeAll(IndexWatchOwner(aClient, rootPath));
+
+    // Set Change Time - Long Ago, Built Right Away
+    clientRoots[rootPath].changeTime = 1;
+
+    // Wake Watcher
+    condition.wakeAll();
+}
+
+//==============================================================================
+// Remove Root
+//==============================================================================
+void IndexWatcher::removeRoot(IndexWatcherClient* aClient, const QString& aRootPath)
+{
+    // Get Root Path
+    QString rootPath = QDir::cleanPath(aRootPath);
+
+    qDebug() << "IndexWatcher::removeRoot - rootPath: " << rootPath;
+
+    // Init Locker
+    QMutexLocker locker(&mutex);
+
+    // Check Root
+    if (!roots.value(aClient).contains(rootPath)) {
+        return;
+    }
+
+    // Add Owner To Unwatch
+    removedOwners << IndexWatchOwner(aClient, rootPath);
+    // Remove Root
+    roots[aClient].remove(rootPath);
+
+    // Check Building Root
+    if (activeClient == aClient && buildingRoot == rootPath) {
+        // Set Build Abort Flag
+        buildAbort = true;
+    }
+
+    // Drop Root Index - Searches Still Using It Keep Their Mapping
+    aClient->dropRoot(rootPath);
+
+    // Wake Watcher
+    condition.wakeAll();
+}
+
+//==============================================================================
+// Load Root - Registers An Index Loaded From Disk, Returns false If The Root Was Added Meanwhile
+//==============================================================================
+bool IndexWatcher::loadRoot(IndexWatcherClient* aClient, const QString& aRootPath, const qint64& aBuildTime, const bool& aChanged, const QList<QByteArray>& aDirs)
+{
+    // Lock Mutex
+    mutex.lock();
+
+    // Check Root - Might Have Been Added Meanwhile
+    bool added = roots.contains(aClient) && !roots[aClient].contains(aRootPath);
+
+    // Check Added
+    if (added) {
+        // Get Root
+        IndexWatchRoot& root = roots[aClient][aRootPath];
+        // Set Build Time
+        root.buildTime = aBuildTime;
+        // Set Change Time - Long Ago If Changed While Not Running
+        root.changeTime = aChanged ? 1 : 0;
+    }
+
+    // Unlock Mutex
+    mutex.unlock();
+
+    // Check Added & Dirs
+    if (added && !aDirs.isEmpty()) {
+        // Watch Root Dirs - Completeness Is Only Trusted After A Refresh
+        watchRoot(IndexWatchOwner(aClient, aRootPath), aDirs);
+    }
+
+    return added;
+}
+
+//==============================================================================
+// Find Root - Indexed Root Of A Dir, Empty If None, aStale If Changes Are Pending Or Can't Be Tracked
+//==============================================================================
+QString IndexWatcher::findRoot(IndexWatcherClient* aClient, const QString& aDirPath, bool& aStale)
+{
+    // Get Dir Path
+    QString dirPath = QDir::cleanPath(aDirPath);
+
+    // Init Locker
+    QMutexLocker locker(&mutex);
+
+    // Get Client Roots
+    const QMap<QString, IndexWatchRoot> clientRoots = roots.value(aClient);
+
+    // Go Thru Roots
+    for (QMap<QString, IndexWatchRoot>::const_iterator it = clientRoots.constBegin(); it != clientRoots.constEnd(); ++it) {
+        // Check Dir Path
+        if (dirPath == it.key() || dirPath.startsWith(iwDirPrefix(it.key()))) {
+            // Set Stale
+            aStale = it.value().changeTime != 0 || !it.value().watchesComplete;
+
+            return it.key();
+        }
+    }
+
+    return QString();
+}
+
+//==============================================================================
+// Mark Changed - Schedules A Refresh
+//==============================================================================
+void IndexWatcher::markChanged(IndexWatcherClient* aClient, const QString& aRootPath)
+{
+    // Init Locker
+    QMutexLocker locker(&mutex);
+
+    // Check Root
+    if (roots.value(aClient).contains(aRootPath) && roots[aClient][aRootPath].changeTime == 0) {
+        // Set Change Time
+        roots[aClient][aRootPath].changeTime = QDateTime::currentMSecsSinceEpoch();
+    }
+}
+
+//==============================================================================
+// Thread Execution Method
+//==============================================================================
+void IndexWatcher::run()
+{
+    // Main Loop
+    while (!abortFlag) {
+        // Lock Mutex
+        mutex.lock();
+        // Take Clients To Load
+        QList<IndexWatcherClient*> loadClients = pendingClients;
+        // Clear Clients To Load
+        pendingClients.clear();
+        // Take Owners Of Removed Roots
+        QList<IndexWatchOwner> owners = removedOwners;
+        // Clear Owners Of Removed Roots
+        removedOwners.clear();
+        // Unlock Mutex
+        mutex.unlock();
+
+        // Go Thru Clients To Load
+        for (int i=0; i<loadClients.count() && !abortFlag; ++i) {
+            // Enter Client
+            if (enterClient(loadClients[i])) {
+                // Load Indexes
+                loadClients[i]->loadIndexes(buildAbort);
+                // Leave Client
+                leaveClient();
+            }
+        }
+
+        // Unwatch Owners Of Removed Roots
+        unwatchOwners(owners);
+        // Read Watch Events
+        readWatchEvents();
+
+        // Init Client
+        IndexWatcherClient* client = NULL;
+        // Init Root Path
+        QString rootPath;
+
+        // Get Next Root To Refresh
+        if (nextRootToRefresh(client, rootPath)) {
+            // Refresh Root
+            refreshRoot(client, rootPath);
+            // Leave Client
+            leaveClient();
+
+            continue;
+        }
+
+        // Lock Mutex
+        mutex.lock();
+
+        // Check Abort Flag & Clients To Load
+        if (!abortFlag && pendingClients.isEmpty()) {
+            // Wait - Timed So Watch Events Are Read
+            condition.wait(&mutex, DEFAULT_INDEX_WATCH_POLL_MS);
+        }
+
+        // Unlock Mutex
+        mutex.unlock();
+    }
+}
+
+//==============================================================================
+// Enter Client - Returns false If The Client Was Removed
+//==============================================================================
+bool IndexWatcher::enterClient(IndexWatcherClient* aClient)
+{
+    // Init Locker
+    QMutexLocker locker(&mutex);
+
+    // Check Client
+    if (!roots.contains(aClient)) {
+        return false;
+    }
+
+    // Set Active Client
+    activeClient = aClient;
+    // Reset Build Abort Flag
+    buildAbort = abortFlag;
+
+    return true;
+}
+
+//==============================================================================
+// Leave Client
+//==============================================================================
+void IndexWatcher::leaveClient()
+{
+    // Init Locker
+    QMutexLocker locker(&mutex);
+
+    // Reset Active Client
+    activeClient = NULL;
+    // Reset Building Root
+    buildingRoot.clear();
+
+    // Wake Waiting Client Removal
+    condition.wakeAll();
+}
+
+//==============================================================================
+// Get Next Root To Refresh - Enters Its Client
+//==============================================================================
+bool IndexWatcher::nextRootToRefresh(IndexWatcherClient*& aClient, QString& aRootPath)
+{
+    // Init Locker
+    QMutexLocker locker(&mutex);
+
+    // Get Current Time
+    qint64 now = QDateTime::currentMSecsSinceEpoch();
+
+    // Go Thru Clients
+    for (int i=0; i<clients.count(); ++i) {
+        // Get Client Roots
+        QMap<QString, IndexWatchRoot>& clientRoots = roots[clients[i]];
+
+        // Go Thru Roots
+        for (QMap<QString, IndexWatchRoot>::iterator it = clientRoots.begin(); it != clientRoots.end(); ++it) {
+            // Check Expired - Periodic mtime Check Catches What Watches Can't See
+            if (it.value().changeTime == 0 && it.value().buildTime != 0 && now - it.value().buildTime > clients[i]->timeToLive()) {
+                // Set Change Time - Long Ago
+                it.value().changeTime = 1;
+                // Reset Watches Complete - Full mtime Check
+                it.value().watchesComplete = false;
+            }
+
+            // Check Change Time - Changes Are Let Settle Before Refreshing
+            if (it.value().changeTime != 0 && now - it.value().changeTime >= clients[i]->refreshDelay()) {
+                // Reset Change Time - Changes During The Refresh Set It Again
+                it.value().changeTime = 0;
+                // Set Active Client
+                activeClient = clients[i];
+                // Set Building Root
+                buildingRoot = it.key();
+                // Reset Build Abort Flag
+                buildAbort = abortFlag;
+
+                // Set Client
+                aClient = clients[i];
+                // Set Root Path
+                aRootPath = it.key();
+
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+//==============================================================================
+// Refresh Root
+//==============================================================================
+void IndexWatcher::refreshRoot(IndexWatcherClient* aClient, const QString& aRootPath)
+{
+    // Lock Mutex
+    mutex.lock();
+
+    // Get Root
+    IndexWatchRoot root = roots.value(aClient).value(aRootPath);
+
+    // Check Root
+    if (roots.value(aClient).contains(aRootPath)) {
+        // Clear Changed Dirs
+        roots[aClient][aRootPath].changedDirs.clear();
+    }
+
+    // Unlock Mutex
+    mutex.unlock();
+
+    qDebug() << "IndexWatcher::refreshRoot - aRootPath: " << aRootPath << " - changedDirs: " << root.changedDirs.count() << " - watchesComplete: " << root.watchesComplete;
+
+    // Get Start Time
+    qint64 startTime = QDateTime::currentMSecsSinceEpoch();
+    // Init Dirs
+    QList<QByteArray> dirs;
+
+    // Refresh Root - Changed Dirs Can Only Be Trusted If Watches Are Complete
+    bool built = aClient->refreshRoot(aRootPath, root.watchesComplete ? &root.changedDirs : NULL, buildAbort, dirs);
+
+    // Lock Mutex
+    mutex.lock();
+
+    // Reset Building Root
+    buildingRoot.clear();
+
+    // Check Client Removed - Shutting Down, Index Files Are Kept
+    bool clientRemoved = !roots.contains(aClient);
+    // Check Removed During The Build
+    bool removed = !clientRemoved && !roots[aClient].contains(aRootPath);
+
+    // Check Removed
+    if (!clientRemoved && !removed) {
+        // Check Built
+        if (built) {
+            // Set Build Time
+            roots[aClient][aRootPath].buildTime = startTime;
+        } else if (!abortFlag) {
+            // Give Back Changed Dirs
+            roots[aClient][aRootPath].changedDirs.unite(root.changedDirs);
+            // Set Change Time - Retried Later
+            roots[aClient][aRootPath].changeTime = QDateTime::currentMSecsSinceEpoch();
+        }
+    }
+
+    // Unlock Mutex
+    mutex.unlock();
+
+    // Check Client Removed
+    if (clientRemoved) {
+        return;
+    }
+
+    // Check Removed
+    if (removed) {
+        // Check Built
+        if (built) {
+            // Drop Root Index
+            aClient->dropRoot(aRootPath);
+        }
+
+        return;
+    }
+
+    // Check Built
+    if (built) {
+        // Watch Root Dirs
+        bool complete = watchRoot(IndexWatchOwner(aClient, aRootPath), dirs);
+
+        // Init Locker
+        QMutexLocker locker(&mutex);
+
+        // Check Root
+        if (roots.value(aClient).contains(aRootPath)) {
+            // Set Watches Complete
+            roots[aClient][aRootPath].watchesComplete = complete;
+        }
+    }
+}
+
+//==============================================================================
+// Watch Root Dirs - Returns true If Every Dir Is Watched
+//==============================================================================
+bool IndexWatcher::watchRoot(const IndexWatchOwner& aOwner, const QList<QByteArray>& aDirs)
+{
+    // Init Complete
+    bool complete = false;
+
+#if defined(Q_OS_LINUX)
+
+    // Init Old Watches
+    QList<int> oldWatches;
+    // Init Sole Owned Watches - Freed If Not Kept
+    QSet<int> soleWatches;
+
+    // Go Thru Watch Dirs
+    for (QHash<int, IndexWatchDir>::const_iterator it = watchDirs.constBegin(); it != watchDirs.constEnd(); ++it) {
+        // Check Owner
+        if (it.value().owners.contains(aOwner)) {
+            // Add Old Watch
+            oldWatches << it.key();
+
+            // Check Sole Owner
+            if (it.value().owners.count() == 1) {
+                // Add Sole Watch
+                soleWatches << it.key();
+            }
+        }
+    }
+
+    // Init Watches
+    QList<int> watches;
+    // Init Watch Count - Other Roots' Watches Count Too, Dirs Shared By Roots Count Once
+    int watchCount = watchDirs.count() - soleWatches.count();
+    // Set Complete
+    complete = watchFd >= 0;
+
+    // Go Thru Dirs - New Watches Are Added Before Old Ones Go, So No Event Is Missed
+    for (int i=0; i<aDirs.count() && complete; ++i) {
+        // Check Watch Count - Dirs Over The Limit Rely On mtime Checks
+        if (watchCount >= DEFAULT_INDEX_WATCH_MAX_WATCHES) {
+            // Reset Complete
+            complete = false;
+            break;
+        }
+
+        // Add Watch - Same Descriptor For Dirs Already Watched
+        int wd = inotify_add_watch(watchFd, aDirs[i].constData(), IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO | IN_CLOSE_WRITE | IN_DELETE_SELF | IN_ONLYDIR | IN_DONT_FOLLOW);
+
+        // Check Watch Descriptor
+        if (wd >= 0) {
+            // Check New Or Kept Sole Watch
+            if (!watchDirs.contains(wd) || soleWatches.remove(wd)) {
+                // Inc Watch Count
+                watchCount++;
+            }
+
+            // Get Watch Dir
+            IndexWatchDir& watchDir = watchDirs[wd];
+            // Set Dir Path
+            watchDir.path = aDirs[i];
+
+            // Check Owner
+            if (!watchDir.owners.contains(aOwner)) {
+                // Add Owner
+                watchDir.owners << aOwner;
+            }
+
+            // Add Watch
+            watches << wd;
+
+        // Check System Limit - Unreadable & Gone Dirs Don't Count
+        } else if (errno == ENOSPC || errno == ENOMEM) {
+            // Reset Complete
+            complete = false;
+        }
+    }
+
+    // Init Kept Watches
+    QSet<int> keptWatches = watches.toSet();
+    // Init Stale Watches
+    QList<int> staleWatches;
+
+    // Go Thru Old Watches
+    for (int i=0; i<oldWatches.count(); ++i) {
+        // Check Kept
+        if (!keptWatches.contains(oldWatches[i])) {
+            // Add Stale Watch
+            staleWatches << oldWatches[i];
+        }
+    }
+
+    // Unwatch Stale Watches
+    unwatch(aOwner, staleWatches);
+
+    // Init Locker
+    QMutexLocker locker(&mutex);
+
+    // Check Root - Might Have Been Removed Meanwhile
+    if (!roots.value(aOwner.first).contains(aOwner.second)) {
+        // Add Owner To Unwatch
+        removedOwners << aOwner;
+    }
+
+#else // Q_OS_LINUX
+
+    Q_UNUSED(aOwner);
+    Q_UNUSED(aDirs);
+
+#endif // Q_OS_LINUX
+
+    return complete;
+}
+
+//==============================================================================
+// Unwatch - Watches Without Owners Are Removed
+//==============================================================================
+void IndexWatcher::unwatch(const IndexWatchOwner& aOwner, const QList<int>& aWatches)
+{
+#if defined(Q_OS_LINUX)
+
+    // Go Thru Watches
+    for (int i=0; i<aWatches.count(); ++i) {
+        // Check Watch Dir
+        if (!watchDirs.contains(aWatches[i])) {
+            continue;
+        }
+
+        // Remove Owner
+        watchDirs[aWatches[i]].owners.removeAll(aOwner);
+
+        // Check Owners
+        if (watchDirs[aWatches[i]].owners.isEmpty()) {
+            // Remove Watch
+            inotify_rm_watch(watchFd, aWatches[i]);
+            // Remove Watch Dir
+            watchDirs.remove(aWatches[i]);
+        }
+    }
+
+#else // Q_OS_LINUX
+
+    Q_UNUSED(aOwner);
+    Q_UNUSED(aWatches);
+
+#endif // Q_OS_LINUX
+}
+
+//==============================================================================
+// Unwatch Owners - Every Watch Held By The Owners
+//==============================================================================
+void IndexWatcher::unwatchOwners(const QList<IndexWatchOwner>& aOwners)
+{
+#if defined(Q_OS_LINUX)
+
+    // Check Owners
+    if (aOwners.isEmpty()) {
+        return;
+    }
+
+    // Init Iterator
+    QHash<int, IndexWatchDir>::iterator it = watchDirs.begin();
+
+    // Go Thru Watch Dirs
+    while (it != watchDirs.end()) {
+        // Go Thru Owners
+        for (int i=0; i<aOwners.count(); ++i) {
+            // Remove Owner
+            it.value().owners.removeAll(aOwners[i]);
+        }
+
+        // Check Owners
+        if (it.value().owners.isEmpty()) {
+            // Remove Watch
+            inotify_rm_watch(watchFd, it.key());
+            // Remove Watch Dir
+            it = watchDirs.erase(it);
+
+        } else {
+            ++it;
+        }
+    }
+
+#else // Q_OS_LINUX
+
+    Q_UNUSED(aOwners);
+
+#endif // Q_OS_LINUX
+}
+
+//==============================================================================
+// Read Watch Events
+//==============================================================================
+void IndexWatcher::readWatchEvents()
+{
+#if defined(Q_OS_LINUX)
+
+    // Check Watch fd
+    if (watchFd < 0) {
+        return;
+    }
+
+    // Init Event Buffer
+    char buffer[DEFAULT_INDEX_WATCH_EVENT_BUFFER_SIZE] __attribute__ ((aligned(__alignof__(struct inotify_event))));
+    // Init Changed Dirs By Owner - Entries Added, Removed Or Renamed
+    QHash<IndexWatchOwner, QSet<QByteArray> > changedDirs;
+    // Init Written Owners - Files Written Only
+    QSet<IndexWatchOwner> writtenOwners;
+    // Init Overflow
+    bool overflow = false;
+
+    // Read Events
+    forever {
+        // Read
+        ssize_t length = read(watchFd, buffer, sizeof(buffer));
+
+        // Check Length - Non Blocking, Nothing Left
+        if (length <= 0) {
+            break;
+        }
+
+        // Go Thru Events
+        for (char* ptr = buffer; ptr < buffer + length; ) {
+            // Get Event
+            const struct inotify_event* event = reinterpret_cast<const struct inotify_event*>(ptr);
+
+            // Check Overflow - Events Lost, Every Root Is Suspect
+            if (event->mask & IN_Q_OVERFLOW) {
+                // Set Overflow
+                overflow = true;
+
+            } else if (watchDirs.contains(event->wd)) {
+                // Get Watch Dir
+                const IndexWatchDir& watchDir = watchDirs[event->wd];
+
+                // Go Thru Owners
+                for (int i=0; i<watchDir.owners.count(); ++i) {
+                    // Check Written Only
+                    if ((event->mask & ~IN_CLOSE_WRITE) == 0) {
+                        // Add Written Owner
+                        writtenOwners << watchDir.owners[i];
+                    } else {
+                        // Add Changed Dir - Its Entries Are Re-Read
+                        changedDirs[watchDir.owners[i]] << watchDir.path;
+                    }
+                }
+
+                // Check Ignored - Watched Dir Gone
+                if (event->mask & IN_IGNORED) {
+                    // Remove Watch Dir
+                    watchDirs.remove(event->wd);
+                }
+            }
+
+            // Next Event
+            ptr += sizeof(struct inotify_event) + event->len;
+        }
+    }
+
+    // Check Changes
+    if (!overflow && changedDirs.isEmpty() && writtenOwners.isEmpty()) {
+        return;
+    }
+
+    // Init Locker
+    QMutexLocker locker(&mutex);
+
+    // Get Current Time
+    qint64 now = QDateTime::currentMSecsSinceEpoch();
+
+    // Go Thru Clients
+    for (int i=0; i<clients.count(); ++i) {
+        // Get Client Roots
+        QMap<QString, IndexWatchRoot>& clientRoots = roots[clients[i]];
+        // Get Watches File Writes
+        bool watchesFileWrites = clients[i]->watchesFileWrites();
+
+        // Go Thru Roots
+        for (QMap<QString, IndexWatchRoot>::iterator it = clientRoots.begin(); it != clientRoots.end(); ++it) {
+            // Init Owner
+            IndexWatchOwner owner(clients[i], it.key());
+
+            // Check Overflow
+            if (overflow) {
+                // Reset Watches Complete - Full mtime Check
+                it.value().watchesComplete = false;
+            }
+
+            // Check Changed - File Writes Matter To Content Indexes Only
+            if (overflow || changedDirs.contains(owner) || (watchesFileWrites && writtenOwners.contains(owner))) {
+                // Add Changed Dirs
+                it.value().changedDirs.unite(changedDirs.value(owner));
+
+                // Check Change Time - First Change Counts, Churn Doesn't Postpone The Refresh
+                if (it.value().changeTime == 0) {
+                    // Set Change Time
+                    it.value().changeTime = now;
+                }
+            }
+        }
+    }
+
+#endif // Q_OS_LINUX
+}
+
+//==============================================================================
+// Destructor
+//==============================================================================
+IndexWatcher::~IndexWatcher()
+{
+    // Lock Mutex
+    mutex.lock();
+    // Set Abort Flag
+    abortFlag = true;
+    // Set Build Abort Flag
+    buildAbort = true;
+    // Wake Watcher
+    condition.wakeAll();
+    // Unlock Mutex
+    mutex.unlock();
+
+    // Wait
+    wait();
+
+#if defined(Q_OS_LINUX)
+    // Check Watch fd
+    if (watchFd >= 0) {
+        // Close Watch fd
+        close(watchFd);
+    }
+#endif // Q_OS_LINUX
+}
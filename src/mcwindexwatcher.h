@@ -0,0 +1,160 @@
+#ifndef INDEXWATCHER_H
+#define INDEXWATCHER_H
+
+#include <QThread>
+#include <QString>
+#include <QByteArray>
+#include <QList>
+#include <QMap>
+#include <QHash>
+#include <QSet>
+#include <QPair>
+#include <QMutex>
+#include <QWaitCondition>
+
+
+//==============================================================================
+// Index Watcher Client - One Index Type, Loaded & Refreshed On The Watcher Thread
+//==============================================================================
+class IndexWatcherClient
+{
+public:
+    // Destructor
+    virtual ~IndexWatcherClient() {}
+
+    // Watches File Writes - Otherwise Only Entries Added, Removed Or Renamed Change The Index
+    virtual bool watchesFileWrites() const = 0;
+    // Get Refresh Delay - Msecs Changes Are Let Settle Before Refreshing
+    virtual qint64 refreshDelay() const = 0;
+    // Get Time To Live - Msecs After Which Up To Date Roots Are Checked Again
+    virtual qint64 timeToLive() const = 0;
+
+    // Load Indexes - Existing Index Files, Registered Thru IndexWatcher::loadRoot
+    virtual void loadIndexes(const bool& aAbort) = 0;
+    // Refresh Root - aChangedDirs Is NULL If Changes Weren't Tracked, Dirs To Watch Are Returned In aDirs
+    virtual bool refreshRoot(const QString& aRootPath, const QSet<QByteArray>* aChangedDirs, const bool& aAbort, QList<QByteArray>& aDirs) = 0;
+    // Drop Root - Index Of A Removed Or Merged Root Is Deleted
+    virtual void dropRoot(const QString& aRootPath) = 0;
+};
+
+// Index Watch Owner - Client & Root Holding A Watch
+typedef QPair<IndexWatcherClient*, QString> IndexWatchOwner;
+
+//==============================================================================
+// Index Watch Root
+//==============================================================================
+class IndexWatchRoot
+{
+public:
+    // Constructor
+    IndexWatchRoot();
+
+    // Change Time - Msecs Since Epoch, 0 If Up To Date
+    qint64                      changeTime;
+    // Build Time - Msecs Since Epoch, 0 If Not Built Yet
+    qint64                      buildTime;
+    // Changed Dirs - Reported By Watches Since The Last Refresh
+    QSet<QByteArray>            changedDirs;
+    // Watches Complete - Every Dir Watched & No Events Lost, Otherwise mtimes Are Checked
+    bool                        watchesComplete;
+};
+
+//==============================================================================
+// Index Watch Dir - One inotify Watch, Shared By Every Root Containing The Dir
+//==============================================================================
+class IndexWatchDir
+{
+public:
+    // Dir Path
+    QByteArray                  path;
+    // Owners
+    QList<IndexWatchOwner>      owners;
+};
+
+//==============================================================================
+// Index Watcher Class - Shared inotify Watches & Root Registry Of The Indexes
+//==============================================================================
+class IndexWatcher : public QThread
+{
+public:
+    // Get Instance
+    static IndexWatcher* instance();
+
+    // Add Client - Its Indexes Are Loaded On The Watcher Thread
+    void addClient(IndexWatcherClient* aClient);
+    // Remove Client - Waits Until The Watcher Thread Is Done With It
+    void removeClient(IndexWatcherClient* aClient);
+
+    // Add Root - Nested Roots Are Merged Into The Outermost One
+    void addRoot(IndexWatcherClient* aClient, const QString& aRootPath);
+    // Remove Root
+    void removeRoot(IndexWatcherClient* aClient, const QString& aRootPath);
+
+    // Load Root - Registers An Index Loaded From Disk, Returns false If The Root Was Added Meanwhile
+    bool loadRoot(IndexWatcherClient* aClient, const QString& aRootPath, const qint64& aBuildTime, const bool& aChanged, const QList<QByteArray>& aDirs);
+
+    // Find Root - Indexed Root Of A Dir, Empty If None, aStale If Changes Are Pending Or Can't Be Tracked
+    QString findRoot(IndexWatcherClient* aClient, const QString& aDirPath, bool& aStale);
+
+    // Mark Changed - Schedules A Refresh
+    void markChanged(IndexWatcherClient* aClient, const QString& aRootPath);
+
+    // Destructor
+    virtual ~IndexWatcher();
+
+protected: // From QThread
+
+    // Thread Execution Method
+    virtual void run();
+
+private:
+    // Constructor
+    IndexWatcher();
+
+    // Enter Client - Returns false If The Client Was Removed
+    bool enterClient(IndexWatcherClient* aClient);
+    // Leave Client
+    void leaveClient();
+
+    // Get Next Root To Refresh - Enters Its Client
+    bool nextRootToRefresh(IndexWatcherClient*& aClient, QString& aRootPath);
+    // Refresh Root
+    void refreshRoot(IndexWatcherClient* aClient, const QString& aRootPath);
+
+    // Watch Root Dirs - Returns true If Every Dir Is Watched
+    bool watchRoot(const IndexWatchOwner& aOwner, const QList<QByteArray>& aDirs);
+    // Unwatch - Watches Without Owners Are Removed
+    void unwatch(const IndexWatchOwner& aOwner, const QList<int>& aWatches);
+    // Unwatch Owners - Every Watch Held By The Owners
+    void unwatchOwners(const QList<IndexWatchOwner>& aOwners);
+    // Read Watch Events
+    void readWatchEvents();
+
+private:
+    // Mutex
+    QMutex                                                      mutex;
+    // Wait Condition
+    QWaitCondition                                              condition;
+    // Abort Flag
+    bool                                                        abortFlag;
+    // Build Abort Flag
+    bool                                                        buildAbort;
+    // Active Client - Being Loaded Or Refreshed
+    IndexWatcherClient*                                         activeClient;
+    // Building Root
+    QString                                                     buildingRoot;
+    // Clients
+    QList<IndexWatcherClient*>                                  clients;
+    // Clients To Load
+    QList<IndexWatcherClient*>                                  pendingClients;
+    // Roots By Client
+    QHash<IndexWatcherClient*, QMap<QString, IndexWatchRoot> >  roots;
+    // Owners Of Removed Roots - Unwatched On The Watcher Thread
+    QList<IndexWatchOwner>                                      removedOwners;
+    // Watch fd
+    int                                                         watchFd;
+    // Watch Dirs - Watcher Thread Only
+    QHash<int, IndexWatchDir>                                   watchDirs;
+};
+
+#endif // INDEXWATCHER_H
@@ -51,10 +51,44 @@
 #define DEFAULT_KEY_CONFIRMCODE                     "conf"
 #define DEFAULT_KEY_READY                           "rdy"
 #define DEFAULT_KEY_CUSTOM                          "user"
+#define DEFAULT_KEY_FILTEREXPR                      "fexp"
+#define DEFAULT_KEY_DEPTH                           "dpth"
+#define DEFAULT_KEY_HASSUB                          "sub"
+#define DEFAULT_KEY_ITEMS                           "itms"
+#define DEFAULT_KEY_BREAKDOWN                       "brkd"
+#define DEFAULT_KEY_TOPCOUNT                        "top"
+#define DEFAULT_KEY_CHILDREN                        "chld"
+#define DEFAULT_KEY_REST                            "rest"
+#define DEFAULT_KEY_TYPES                           "typs"
+#define DEFAULT_KEY_LARGEST                         "lrgs"
+#define DEFAULT_KEY_LINE                            "ln"
+#define DEFAULT_KEY_OFFSET                          "offs"
+#define DEFAULT_KEY_SNIPPET                         "snip"
+#define DEFAULT_KEY_INDEXTIME                       "idxt"
+#define DEFAULT_KEY_STALE                           "stl"
+#define DEFAULT_KEY_SCORE                           "scr"
+#define DEFAULT_KEY_RANK                            "rnk"
+#define DEFAULT_KEY_RESULTS                         "rsid"
+#define DEFAULT_KEY_COUNT                           "cnt"
+#define DEFAULT_KEY_CONTENTTERMS                    "cntnts"
+#define DEFAULT_KEY_TERMS                           "trms"
+#define DEFAULT_KEY_EXCLUDE                         "excl"
+
+// Filter Expression Keys
+#define DEFAULT_FILTER_KEY_INCLUDE                  "inc"
+#define DEFAULT_FILTER_KEY_EXCLUDE                  "exc"
+#define DEFAULT_FILTER_KEY_MIN_SIZE                 "smin"
+#define DEFAULT_FILTER_KEY_MAX_SIZE                 "smax"
+#define DEFAULT_FILTER_KEY_MIN_DATE                 "dmin"
+#define DEFAULT_FILTER_KEY_MAX_DATE                 "dmax"
+#define DEFAULT_FILTER_KEY_TYPES                    "type"
+#define DEFAULT_FILTER_KEY_PERMISSIONS              "prms"
+#define DEFAULT_FILTER_KEY_OPTIONS                  "fopt"
 
 
 // Operation Codes
 #define DEFAULT_OPERATION_LIST_DIR                  "LD"
+#define DEFAULT_OPERATION_RESORT_DIR                "RS"
 #define DEFAULT_OPERATION_SCAN_DIR                  "SD"
 #define DEFAULT_OPERATION_TREE_DIR                  "TD"
 #define DEFAULT_OPERATION_MAKE_DIR                  "MD"
@@ -78,6 +112,8 @@
 #define DEFAULT_OPERATION_RESUME                    "RSM"
 #define DEFAULT_OPERATION_CONTENT                   "CNT"
 #define DEFAULT_OPERATION_CLEAR                     "CLR"
+#define DEFAULT_OPERATION_INDEX_DIR                 "IDX"
+#define DEFAULT_OPERATION_FIND_FILE                 "FIND"
 
 #define DEFAULT_OPERATION_TEST                      "TEST"
 
@@ -100,7 +136,12 @@
 #define DEFAULT_RESPONSE_ARCHIVEITEM                "ALI"
 #define DEFAULT_RESPONSE_DIRSCAN                    "DSC"
 #define DEFAULT_RESPONSE_DIRTREE                    "DTR"
+#define DEFAULT_RESPONSE_DIRBREAKDOWN               "DSB"
+#define DEFAULT_RESPONSE_DIRSIZE                    "DSZ"
 #define DEFAULT_RESPONSE_SEARCH                     "SRCH"
+#define DEFAULT_RESPONSE_SEARCHINDEX                "SIX"
+#define DEFAULT_RESPONSE_SEARCHRESULTS              "SRS"
+#define DEFAULT_RESPONSE_FIND                       "FND"
 #define DEFAULT_RESPONSE_QUEUE                      "QLI"
 #define DEFAULT_RESPONSE_START                      "STRT"
 #define DEFAULT_RESPONSE_PROGRESS                   "PRG"
@@ -131,6 +172,8 @@
 #define DEFAULT_ERROR_CANNOT_DELETE_TARGET_DIR      0x000C
 #define DEFAULT_ERROR_NOT_ENOUGH_SPACE              0x000D
 #define DEFAULT_ERROR_NOT_SUPPORTED                 0x000E
+#define DEFAULT_ERROR_INVALID_PATTERN               0x000F
+#define DEFAULT_ERROR_EXPIRED                       0x0010
 
 
 
@@ -150,13 +193,36 @@
 
 // Filter Options
 #define DEFAULT_FILTER_SHOW_HIDDEN                  0x0001
+#define DEFAULT_FILTER_DIR_SIZES                    0x0002
+
+// Filter Expression Types
+#define DEFAULT_FILTER_TYPE_FILE                    0x0001
+#define DEFAULT_FILTER_TYPE_DIR                     0x0002
+#define DEFAULT_FILTER_TYPE_LINK                    0x0004
+
+// Filter Expression Options
+#define DEFAULT_FILTER_OPTION_CASE_SENSITIVE        0x0001
+#define DEFAULT_FILTER_OPTION_MATCH_DIRS            0x0002
 
 // Copy Options
 #define DEFAULT_COPY_OPTIONS_COPY_HIDDEN            0x0001
 
+// Dir Size Scan Options
+#define DEFAULT_SCAN_OPTION_IGNORE_FILES            0x0001
+
 // Search Options
 #define DEFAULT_SEARCH_OPTION_CASE_SENSITIVE        0x0001
 #define DEFAULT_SEARCH_OPTION_WHOLE_WORD            0x0010
+#define DEFAULT_SEARCH_OPTION_ORDERED               0x0020
+#define DEFAULT_SEARCH_OPTION_REGEXP                0x0040
+#define DEFAULT_SEARCH_OPTION_NO_INDEX              0x0080
+#define DEFAULT_SEARCH_OPTION_ARCHIVES              0x0100
+#define DEFAULT_SEARCH_OPTION_ALL_TERMS             0x0200
+#define DEFAULT_SEARCH_OPTION_IGNORE_FILES          0x0400
+
+// Index Flags
+#define DEFAULT_INDEX_FLAG_REMOVE                   0x0001
+#define DEFAULT_INDEX_FLAG_NAMES                    0x0002
 
 
 // Default Root File Server Idle Timeout in Millisecs
@@ -176,6 +242,9 @@
 #define DEFAULT_EXTENSION_TGZ                       "tgz"
 #define DEFAULT_EXTENSION_TARGZ                     "tar.gz"
 #define DEFAULT_EXTENSION_TARBZ                     "tar.bz2"
+#define DEFAULT_EXTENSION_TBZ                       "tbz2"
+#define DEFAULT_EXTENSION_TARXZ                     "tar.xz"
+#define DEFAULT_EXTENSION_TXZ                       "txz"
 
 #endif // INTERFACE
 
@@ -0,0 +1,174 @@
+#include <QDateTime>
+#include <QStringList>
+#include <QDebug>
+
+#include "mcwlistfilter.h"
+#include "mcwinterface.h"
+
+
+//==============================================================================
+// Constructor
+//==============================================================================
+DirListFilter::DirListFilter(const QVariantMap& aFilterExpr)
+    : minSize(-1)
+    , maxSize(-1)
+    , minDate(-1)
+    , maxDate(-1)
+    , types(0)
+    , permissions(0)
+    , filterOptions(0)
+    , empty(true)
+{
+    // Set Filter Expression
+    setFilterExpression(aFilterExpr);
+}
+
+//==============================================================================
+// Set Filter Expression
+//==============================================================================
+void DirListFilter::setFilterExpression(const QVariantMap& aFilterExpr)
+{
+    // Get Filter Options
+    filterOptions   = aFilterExpr.value(DEFAULT_FILTER_KEY_OPTIONS, 0).toInt();
+
+    // Get Include Patterns
+    QStringList patterns = aFilterExpr.value(DEFAULT_FILTER_KEY_INCLUDE).toStringList();
+    // Get Exclude Patterns
+    QStringList excludePatterns = aFilterExpr.value(DEFAULT_FILTER_KEY_EXCLUDE).toStringList();
+
+    // Go Thru Exclude Patterns
+    for (int i=0; i<excludePatterns.count(); ++i) {
+        // Check Pattern
+        if (!excludePatterns[i].isEmpty()) {
+            // Add Exclude Pattern
+            patterns << QString("!") + excludePatterns[i];
+        }
+    }
+
+    // Set Name Matcher Patterns - Compiled Once
+    nameMatcher.setPatterns(patterns, filterOptions & DEFAULT_FILTER_OPTION_CASE_SENSITIVE);
+
+    // Get Size Range
+    minSize         = aFilterExpr.value(DEFAULT_FILTER_KEY_MIN_SIZE, -1).toLongLong();
+    maxSize         = aFilterExpr.value(DEFAULT_FILTER_KEY_MAX_SIZE, -1).toLongLong();
+
+    // Init Date Values
+    QVariant minDateValue = aFilterExpr.value(DEFAULT_FILTER_KEY_MIN_DATE, -1);
+    QVariant maxDateValue = aFilterExpr.value(DEFAULT_FILTER_KEY_MAX_DATE, -1);
+
+    // Get Date Range - Date Time Or Msecs Since Epoch
+    minDate         = minDateValue.type() == QVariant::DateTime ? minDateValue.toDateTime().toMSecsSinceEpoch() : minDateValue.toLongLong();
+    maxDate         = maxDateValue.type() == QVariant::DateTime ? maxDateValue.toDateTime().toMSecsSinceEpoch() : maxDateValue.toLongLong();
+
+    // Get Types
+    types           = aFilterExpr.value(DEFAULT_FILTER_KEY_TYPES, 0).toInt();
+    // Get Required Permissions
+    permissions     = aFilterExpr.value(DEFAULT_FILTER_KEY_PERMISSIONS, 0).toInt();
+
+    // Set Empty
+    empty           = nameMatcher.isEmpty() && minSize < 0 && maxSize < 0 && minDate < 0 && maxDate < 0 && types == 0 && permissions == 0;
+}
+
+//==============================================================================
+// Is Empty - Everything Passes
+//==============================================================================
+bool DirListFilter::isEmpty() const
+{
+    return empty;
+}
+
+//==============================================================================
+// Has Name Filter
+//==============================================================================
+bool DirListFilter::hasNameFilter() const
+{
+    return !nameMatcher.isEmpty();
+}
+
+//==============================================================================
+// Match File Name - No Stat Needed
+//==============================================================================
+bool DirListFilter::matchName(const QString& aFileName, const bool& aIsDir) const
+{
+    // Check Double Dot
+    if (aFileName == QString("..")) {
+        return true;
+    }
+
+    // Check Dirs
+    if (aIsDir && !(filterOptions & DEFAULT_FILTER_OPTION_MATCH_DIRS)) {
+        return true;
+    }
+
+    return nameMatcher.match(aFileName);
+}
+
+//==============================================================================
+// Match Attributes
+//==============================================================================
+bool DirListFilter::matchAttributes(const qint64& aSize, const qint64& aLastModified, const int& aPermissions, const bool& aIsDir, const bool& aIsSymLink) const
+{
+    // Check Types
+    if (types) {
+        // Init Type Matched
+        bool typeMatched = (aIsSymLink && (types & DEFAULT_FILTER_TYPE_LINK)) ||
+                           (aIsDir     && (types & DEFAULT_FILTER_TYPE_DIR))  ||
+                           (!aIsDir    && (types & DEFAULT_FILTER_TYPE_FILE));
+
+        // Check Type Matched
+        if (!typeMatched) {
+            return false;
+        }
+    }
+
+    // Check Required Permissions
+    if (permissions && (aPermissions & permissions) != permissions) {
+        return false;
+    }
+
+    // Check Dirs
+    if (aIsDir && !(filterOptions & DEFAULT_FILTER_OPTION_MATCH_DIRS)) {
+        return true;
+    }
+
+    // Check Size Range - Files Only
+    if (!aIsDir && ((minSize >= 0 && aSize < minSize) || (maxSize >= 0 && aSize > maxSize))) {
+        return false;
+    }
+
+    // Check Date Range
+    if ((minDate >= 0 && aLastModified < minDate) || (maxDate >= 0 && aLastModified > maxDate)) {
+        return false;
+    }
+
+    return true;
+}
+
+//==============================================================================
+// Match File Info
+//==============================================================================
+bool DirListFilter::match(const QFileInfo& aFileInfo) const
+{
+    // Check If Empty
+    if (empty) {
+        return true;
+    }
+
+    // Get File Name
+    QString fileName = aFileInfo.fileName();
+
+    // Check Double Dot
+    if (fileName == QString("..")) {
+        return true;
+    }
+
+    // Get Is Dir
+    bool isDir = aFileInfo.isDir();
+
+    // Match Name
+    if (!matchName(fileName, isDir)) {
+        return false;
+    }
+
+    return matchAttributes(aFileInfo.size(), aFileInfo.lastModified().toMSecsSinceEpoch(), (int)aFileInfo.permissions(), isDir, aFileInfo.isSymLink());
+}
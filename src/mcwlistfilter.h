@@ -0,0 +1,58 @@
+#ifndef LISTFILTER_H
+#define LISTFILTER_H
+
+#include <QString>
+#include <QVariantMap>
+#include <QFileInfo>
+
+#include "mcwglobmatcher.h"
+
+
+//==============================================================================
+// Dir List Filter Class - Evaluates Filter Expression During Listing
+//==============================================================================
+class DirListFilter
+{
+public:
+    // Constructor
+    explicit DirListFilter(const QVariantMap& aFilterExpr = QVariantMap());
+
+    // Set Filter Expression
+    void setFilterExpression(const QVariantMap& aFilterExpr);
+
+    // Is Empty - Everything Passes
+    bool isEmpty() const;
+    // Has Name Filter
+    bool hasNameFilter() const;
+
+    // Match File Name - No Stat Needed
+    bool matchName(const QString& aFileName, const bool& aIsDir) const;
+    // Match Attributes
+    bool matchAttributes(const qint64& aSize, const qint64& aLastModified, const int& aPermissions, const bool& aIsDir, const bool& aIsSymLink) const;
+
+    // Match File Info
+    bool match(const QFileInfo& aFileInfo) const;
+
+private:
+
+    // Name Matcher - Include & Exclude Patterns
+    GlobMatcher         nameMatcher;
+    // Min Size
+    qint64              minSize;
+    // Max Size
+    qint64              maxSize;
+    // Min Last Modified - Msecs Since Epoch
+    qint64              minDate;
+    // Max Last Modified - Msecs Since Epoch
+    qint64              maxDate;
+    // Types
+    int                 types;
+    // Required Permissions
+    int                 permissions;
+    // Filter Options
+    int                 filterOptions;
+    // Empty
+    bool                empty;
+};
+
+#endif // LISTFILTER_H
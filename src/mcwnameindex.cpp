@@ -0,0 +1,1045 @@
+#include <QDir>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QDateTime>
+#include <QCryptographicHash>
+#include <QStringList>
+#include <QMutexLocker>
+#include <QtAlgorithms>
+#include <QDebug>
+
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <dirent.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <string.h>
+
+#include "mcwnameindex.h"
+#include "mcwglobmatcher.h"
+#include "mcwconstants.h"
+
+
+//==============================================================================
+// Index File Header - Followed By The Root Path & The Dir Records
+//==============================================================================
+struct NameIndexFileHeader
+{
+    // Magic
+    quint32     magic;
+    // Version
+    quint32     version;
+    // Dir Count
+    quint32     dirCount;
+    // Entry Count
+    quint32     entryCount;
+    // Data Size
+    quint64     dataSize;
+    // Build Time - Msecs Since Epoch
+    qint64      buildTime;
+    // Root Path Length
+    quint32     rootLength;
+    // Reserved
+    quint32     reserved;
+};
+
+//==============================================================================
+// Index Entry Types
+//==============================================================================
+enum NameIndexEntryType
+{
+    ENIETFile           = 0,
+    ENIETDir
+};
+
+//==============================================================================
+// Dir Record - Path Front Coded Against The Previous Dir, Children Against The Previous Sibling
+//==============================================================================
+struct NameIndexDirRecord
+{
+    // Path Relative To The Root - Empty For The Root
+    QByteArray      path;
+    // Last Modified - Msecs Since Epoch
+    qint64          lastModified;
+    // Child Count
+    quint32         childCount;
+    // Encoded Children
+    const uchar*    children;
+    // Encoded Children Size
+    quint32         childBytes;
+};
+
+//==============================================================================
+// Build Dir - Collected While Refreshing
+//==============================================================================
+struct NameIndexBuildDir
+{
+    // Path Relative To The Root
+    QByteArray      path;
+    // Last Modified - Msecs Since Epoch
+    qint64          lastModified;
+    // Child Count
+    quint32         childCount;
+    // Encoded Children
+    QByteArray      children;
+};
+
+//==============================================================================
+// Get Dir Prefix
+//==============================================================================
+static inline QString niDirPrefix(const QString& aDirPath)
+{
+    return aDirPath.endsWith("/") ? aDirPath : aDirPath + "/";
+}
+
+//==============================================================================
+// Get Last Modified - Msecs Since Epoch
+//==============================================================================
+static inline qint64 niLastModified(const struct stat& aStat)
+{
+#if defined(Q_OS_MAC)
+    return (qint64)aStat.st_mtimespec.tv_sec * 1000 + aStat.st_mtimespec.tv_nsec / 1000000;
+#else // Q_OS_MAC
+    return (qint64)aStat.st_mtim.tv_sec * 1000 + aStat.st_mtim.tv_nsec / 1000000;
+#endif // Q_OS_MAC
+}
+
+//==============================================================================
+// Put Variable Length Integer
+//==============================================================================
+static inline void niPutVarint(QByteArray& aData, quint32 aValue)
+{
+    // Go Thru 7 Bit Groups
+    while (aValue >= 0x80) {
+        // Append Group With Continuation Bit
+        aData.append((char)((aValue & 0x7F) | 0x80));
+        // Shift
+        aValue >>= 7;
+    }
+
+    // Append Last Group
+    aData.append((char)aValue);
+}
+
+//==============================================================================
+// Get Variable Length Integer - false If Truncated
+//==============================================================================
+static inline bool niGetVarint(const uchar*& aPos, const uchar* aEnd, quint32& aValue)
+{
+    // Init Value
+    aValue = 0;
+
+    // Go Thru 7 Bit Groups
+    for (int shift=0; shift<35 && aPos < aEnd; shift+=7) {
+        // Get Byte
+        uchar byte = *aPos++;
+        // Add Group
+        aValue |= (quint32)(byte & 0x7F) << shift;
+
+        // Check Continuation Bit
+        if (!(byte & 0x80)) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+//==============================================================================
+// Put Front Coded Name - Shares The Common Prefix With The Previous Name
+//==============================================================================
+static inline void niPutName(QByteArray& aData, const QByteArray& aPrevious, const QByteArray& aName)
+{
+    // Get Max Shared Length
+    int maxShared = qMin(aPrevious.size(), aName.size());
+    // Init Shared Length
+    int shared = 0;
+
+    // Get Shared Length
+    while (shared < maxShared && aPrevious.at(shared) == aName.at(shared)) {
+        shared++;
+    }
+
+    // Put Shared Length
+    niPutVarint(aData, shared);
+    // Put Suffix Length
+    niPutVarint(aData, aName.size() - shared);
+    // Put Suffix
+    aData.append(aName.constData() + shared, aName.size() - shared);
+}
+
+//==============================================================================
+// Get Front Coded Name - aName Holds The Previous Name On Entry
+//==============================================================================
+static inline bool niGetName(const uchar*& aPos, const uchar* aEnd, QByteArray& aName)
+{
+    // Init Lengths
+    quint32 shared = 0;
+    quint32 suffixLength = 0;
+
+    // Get Lengths
+    if (!niGetVarint(aPos, aEnd, shared) || !niGetVarint(aPos, aEnd, suffixLength) || shared > (quint32)aName.size() || suffixLength > (quint32)(aEnd - aPos)) {
+        return false;
+    }
+
+    // Keep Shared Prefix
+    aName.truncate(shared);
+    // Append Suffix
+    aName.append(reinterpret_cast<const char*>(aPos), suffixLength);
+    // Skip Suffix
+    aPos += suffixLength;
+
+    return true;
+}
+
+//==============================================================================
+// Get Next Dir Record - aRecord Holds The Previous Record On Entry
+//==============================================================================
+static bool niNextDir(const uchar*& aPos, const uchar* aEnd, NameIndexDirRecord& aRecord)
+{
+    // Get Path
+    if (!niGetName(aPos, aEnd, aRecord.path)) {
+        return false;
+    }
+
+    // Check Last Modified
+    if (aEnd - aPos < (qint64)sizeof(qint64)) {
+        return false;
+    }
+
+    // Get Last Modified
+    memcpy(&aRecord.lastModified, aPos, sizeof(qint64));
+    // Skip Last Modified
+    aPos += sizeof(qint64);
+
+    // Get Child Count & Encoded Children Size
+    if (!niGetVarint(aPos, aEnd, aRecord.childCount) || !niGetVarint(aPos, aEnd, aRecord.childBytes) || aRecord.childBytes > (quint32)(aEnd - aPos)) {
+        return false;
+    }
+
+    // Set Children
+    aRecord.children = aPos;
+    // Skip Children
+    aPos += aRecord.childBytes;
+
+    return true;
+}
+
+//==============================================================================
+// Get Next Child - aName Holds The Previous Sibling On Entry
+//==============================================================================
+static inline bool niNextChild(const uchar*& aPos, const uchar* aEnd, QByteArray& aName, uchar& aType)
+{
+    // Check Type
+    if (aPos >= aEnd) {
+        return false;
+    }
+
+    // Get Type
+    aType = *aPos++;
+
+    return niGetName(aPos, aEnd, aName);
+}
+
+//==============================================================================
+// Build Dir Less Than
+//==============================================================================
+static bool buildDirLessThan(const NameIndexBuildDir& a, const NameIndexBuildDir& b)
+{
+    return a.path < b.path;
+}
+
+//==============================================================================
+// Child Less Than - By Name
+//==============================================================================
+static bool childLessThan(const QPair<QByteArray, uchar>& a, const QPair<QByteArray, uchar>& b)
+{
+    return a.first < b.first;
+}
+
+//==============================================================================
+// Read Dir Children - Encoded & Sorted, Returns false If The Dir Can't Be Read
+//==============================================================================
+static bool readDirChildren(const QByteArray& aDirPath, NameIndexBuildDir& aDir, QList<QByteArray>& aSubDirs)
+{
+    // Open Dir
+    int fd = open(aDirPath.constData(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+
+    // Check fd
+    if (fd < 0) {
+        return false;
+    }
+
+    // Init Stat
+    struct stat dirStat;
+
+    // Stat Dir - mtime Before Reading, Changes While Reading Show Up Next Time
+    if (fstat(fd, &dirStat) != 0) {
+        // Close fd
+        close(fd);
+        return false;
+    }
+
+    // Set Last Modified
+    aDir.lastModified = niLastModified(dirStat);
+
+    // Open Dir Stream - Takes Over The fd
+    DIR* dir = fdopendir(fd);
+
+    // Check Dir Stream
+    if (!dir) {
+        // Close fd
+        close(fd);
+        return false;
+    }
+
+    // Init Children
+    QList<QPair<QByteArray, uchar> > children;
+    // Init Dir Entry
+    struct dirent* dirEntry = NULL;
+
+    // Go Thru Dir Entries
+    while ((dirEntry = readdir(dir)) != NULL) {
+        // Get Name
+        const char* name = dirEntry->d_name;
+
+        // Check Dot & Double Dot
+        if (name[0] == '.' && (name[1] == '\0' || (name[1] == '.' && name[2] == '\0'))) {
+            continue;
+        }
+
+        // Get Is Dir - d_type Is Enough Most Of The Time, Links Are Not Followed
+        bool isDir = dirEntry->d_type == DT_DIR;
+
+        // Check Unknown Type
+        if (dirEntry->d_type == DT_UNKNOWN) {
+            // Init Stat
+            struct stat entryStat;
+            // Stat Entry
+            isDir = fstatat(dirfd(dir), name, &entryStat, AT_SYMLINK_NOFOLLOW) == 0 && S_ISDIR(entryStat.st_mode);
+        }
+
+        // Add Child
+        children << qMakePair(QByteArray(name), (uchar)(isDir ? ENIETDir : ENIETFile));
+    }
+
+    // Close Dir Stream
+    closedir(dir);
+
+    // Sort Children - Front Coding Works On Sorted Names
+    qSort(children.begin(), children.end(), childLessThan);
+
+    // Init Previous Name
+    QByteArray previous;
+
+    // Go Thru Children
+    for (int i=0; i<children.count(); ++i) {
+        // Put Type
+        aDir.children.append((char)children[i].second);
+        // Put Name
+        niPutName(aDir.children, previous, children[i].first);
+
+        // Check Dir
+        if (children[i].second == ENIETDir) {
+            // Add Sub Dir
+            aSubDirs << children[i].first;
+        }
+
+        // Set Previous Name
+        previous = children[i].first;
+    }
+
+    // Set Child Count
+    aDir.childCount = children.count();
+
+    return true;
+}
+
+//==============================================================================
+// Build Index File - Unchanged Dirs Are Copied From aPrevious, Dirs In aChangedDirs Or With A New mtime Are Re-Read
+//==============================================================================
+bool NameIndex::build(const QString& aRootPath,
+                      const QString& aFilePath,
+                      const NameIndex* aPrevious,
+                      const QSet<QByteArray>* aChangedDirs,
+                      const bool& aAbort,
+                      QList<QByteArray>& aDirs)
+{
+    // Get Build Time
+    qint64 buildTime = QDateTime::currentMSecsSinceEpoch();
+    // Get Root Path
+    QByteArray rootPath = QFile::encodeName(aRootPath);
+    // Get Root Prefix
+    QByteArray rootPrefix = rootPath.endsWith('/') ? rootPath : rootPath + '/';
+    // Get Cache Dir - Skipped, Index Saves Would Trigger Refreshes
+    QByteArray cacheDir = QFile::encodeName(getCacheDir());
+
+    // Init Previous Dirs
+    QHash<QByteArray, NameIndexDirRecord> previousDirs;
+    // Init Previous Build Time
+    qint64 previousBuildTime = 0;
+
+    // Check Previous Index
+    if (aPrevious && aPrevious->isValid() && aPrevious->rootPath() == aRootPath) {
+        // Get Previous Build Time
+        previousBuildTime = aPrevious->buildTime();
+
+        // Init Record
+        NameIndexDirRecord record;
+        // Get Data Bounds
+        const uchar* pos = aPrevious->dataStart();
+        const uchar* end = aPrevious->dataEnd();
+
+        // Go Thru Previous Dirs
+        while (pos < end && niNextDir(pos, end, record)) {
+            // Add Previous Dir
+            previousDirs.insert(record.path, record);
+        }
+    }
+
+    // Init Dirs
+    QList<NameIndexBuildDir> dirs;
+    // Init Pending Dirs - Relative Paths
+    QList<QByteArray> pending;
+    // Init Entry Count
+    quint32 entryCount = 0;
+    // Init Counters
+    int reusedCount = 0;
+
+    // Add Root
+    pending << QByteArray();
+
+    // Go Thru Pending Dirs
+    while (!pending.isEmpty() && !aAbort) {
+        // Get Relative Path
+        QByteArray relativePath = pending.takeLast();
+        // Get Dir Path
+        QByteArray dirPath = relativePath.isEmpty() ? rootPath : rootPrefix + relativePath;
+
+        // Check Cache Dir
+        if (!relativePath.isEmpty() && dirPath == cacheDir) {
+            continue;
+        }
+
+        // Init Build Dir
+        NameIndexBuildDir dir;
+        // Set Path
+        dir.path         = relativePath;
+        dir.lastModified = 0;
+        dir.childCount   = 0;
+
+        // Init Sub Dirs
+        QList<QByteArray> subDirs;
+        // Init Reused
+        bool reused = false;
+
+        // Check Previous Dir
+        if (previousDirs.contains(relativePath)) {
+            // Get Previous Record
+            const NameIndexDirRecord& record = previousDirs[relativePath];
+            // Init Changed - Unreadable Dirs & Dirs Modified Around The Previous Build Are Re-Read
+            bool changed = record.lastModified == 0 || record.lastModified >= previousBuildTime - DEFAULT_NAME_INDEX_RACY_MS;
+
+            // Check Changed Dirs - Watches Tell Directly, Otherwise The mtime Does
+            if (!changed && aChangedDirs) {
+                // Set Changed
+                changed = aChangedDirs->contains(dirPath);
+            } else if (!changed) {
+                // Init Stat
+                struct stat dirStat;
+                // Set Changed
+                changed = stat(dirPath.constData(), &dirStat) != 0 || niLastModified(dirStat) != record.lastModified;
+            }
+
+            // Check Changed
+            if (!changed) {
+                // Copy Previous Dir - Encoded Children Are Kept As They Are
+                dir.lastModified = record.lastModified;
+                dir.childCount   = record.childCount;
+                dir.children     = QByteArray(reinterpret_cast<const char*>(record.children), record.childBytes);
+
+                // Get Children Bounds
+                const uchar* pos = record.children;
+                const uchar* end = record.children + record.childBytes;
+                // Init Child Name & Type
+                QByteArray childName;
+                uchar childType = ENIETFile;
+
+                // Go Thru Children
+                while (pos < end && niNextChild(pos, end, childName, childType)) {
+                    // Check Dir
+                    if (childType == ENIETDir) {
+                        // Add Sub Dir
+                        subDirs << childName;
+                    }
+                }
+
+                // Set Reused
+                reused = true;
+                // Inc Reused Count
+                reusedCount++;
+            }
+        }
+
+        // Check Reused
+        if (!reused && !readDirChildren(dirPath, dir, subDirs)) {
+            // Check Root
+            if (relativePath.isEmpty()) {
+                qWarning() << "NameIndex::build - aRootPath: " << aRootPath << " - CAN NOT OPEN ROOT!";
+                return false;
+            }
+
+            // Reset Last Modified - Unreadable Dirs Are Retried Next Time
+            dir.lastModified = 0;
+        }
+
+        // Go Thru Sub Dirs
+        for (int i=0; i<subDirs.count(); ++i) {
+            // Add Pending Dir
+            pending << (relativePath.isEmpty() ? subDirs[i] : relativePath + '/' + subDirs[i]);
+        }
+
+        // Inc Entry Count
+        entryCount += dir.childCount;
+
+        // Add Dir Path
+        aDirs << dirPath;
+        // Add Build Dir
+        dirs << dir;
+    }
+
+    // Check Abort
+    if (aAbort) {
+        return false;
+    }
+
+    // Sort Dirs By Path
+    qSort(dirs.begin(), dirs.end(), buildDirLessThan);
+
+    // Init Data
+    QByteArray data;
+    // Init Previous Path
+    QByteArray previous;
+
+    // Go Thru Dirs
+    for (int i=0; i<dirs.count(); ++i) {
+        // Put Path
+        niPutName(data, previous, dirs[i].path);
+        // Put Last Modified
+        data.append(reinterpret_cast<const char*>(&dirs[i].lastModified), sizeof(qint64));
+        // Put Child Count
+        niPutVarint(data, dirs[i].childCount);
+        // Put Encoded Children Size
+        niPutVarint(data, dirs[i].children.size());
+        // Put Encoded Children
+        data.append(dirs[i].children);
+
+        // Set Previous Path
+        previous = dirs[i].path;
+    }
+
+    // Init Header
+    NameIndexFileHeader header;
+    // Setup Header
+    header.magic        = DEFAULT_NAME_INDEX_MAGIC;
+    header.version      = DEFAULT_NAME_INDEX_VERSION;
+    header.dirCount     = dirs.count();
+    header.entryCount   = entryCount;
+    header.dataSize     = data.size();
+    header.buildTime    = buildTime;
+    header.rootLength   = rootPath.size();
+    header.reserved     = 0;
+
+    // Init Save File
+    QSaveFile saveFile(aFilePath);
+
+    // Open Save File
+    if (!saveFile.open(QIODevice::WriteOnly)) {
+        qWarning() << "NameIndex::build - aFilePath: " << aFilePath << " - CAN NOT OPEN FILE!";
+        return false;
+    }
+
+    // Write Data
+    saveFile.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    saveFile.write(rootPath);
+    saveFile.write(data);
+
+    // Commit
+    if (!saveFile.commit()) {
+        qWarning() << "NameIndex::build - aFilePath: " << aFilePath << " - COMMIT FAILED!";
+        return false;
+    }
+
+    qDebug() << "NameIndex::build - aRootPath: " << aRootPath << " - dirCount: " << header.dirCount << " - reused: " << reusedCount << " - entryCount: " << header.entryCount << " - dataSize: " << header.dataSize;
+
+    return true;
+}
+
+//==============================================================================
+// Constructor - Maps An Index File
+//==============================================================================
+NameIndex::NameIndex(const QString& aFilePath)
+    : indexFile(aFilePath)
+    , mappedData(NULL)
+    , mappedSize(0)
+{
+    // Open Index File
+    if (!indexFile.open(QIODevice::ReadOnly)) {
+        return;
+    }
+
+    // Get Size
+    qint64 fileSize = indexFile.size();
+
+    // Check Size
+    if (fileSize < (qint64)sizeof(NameIndexFileHeader)) {
+        // Close Index File
+        indexFile.close();
+        return;
+    }
+
+    // Map File
+    mappedData = indexFile.map(0, fileSize);
+
+    // Check Mapped Data
+    if (!mappedData) {
+        // Close Index File
+        indexFile.close();
+        return;
+    }
+
+    // Set Mapped Size
+    mappedSize = fileSize;
+
+    // Get Header
+    const NameIndexFileHeader* header = reinterpret_cast<const NameIndexFileHeader*>(mappedData);
+
+    // Check Header
+    bool valid = header->magic == DEFAULT_NAME_INDEX_MAGIC && header->version == DEFAULT_NAME_INDEX_VERSION && (qint64)(sizeof(NameIndexFileHeader) + header->rootLength + header->dataSize) == mappedSize;
+
+    // Init Dir Count
+    quint32 dirCount = 0;
+
+    // Check Valid
+    if (valid) {
+        // Init Record
+        NameIndexDirRecord record;
+        // Get Data Bounds
+        const uchar* pos = dataStart();
+        const uchar* end = dataEnd();
+
+        // Go Thru Dirs
+        while (pos < end && valid) {
+            // Get Next Dir
+            valid = niNextDir(pos, end, record);
+            // Inc Dir Count
+            dirCount++;
+        }
+
+        // Check Dir Count
+        valid = valid && dirCount == header->dirCount;
+    }
+
+    // Check Valid
+    if (!valid) {
+        qWarning() << "NameIndex::NameIndex - aFilePath: " << aFilePath << " - INVALID INDEX FILE!";
+        // Unmap Index File
+        unmapIndexFile();
+        return;
+    }
+
+    // Set Root Path
+    root = QFile::decodeName(QByteArray(reinterpret_cast<const char*>(mappedData) + sizeof(NameIndexFileHeader), header->rootLength));
+}
+
+//==============================================================================
+// Is Valid
+//==============================================================================
+bool NameIndex::isValid() const
+{
+    return mappedData != NULL;
+}
+
+//==============================================================================
+// Get Root Path
+//==============================================================================
+QString NameIndex::rootPath() const
+{
+    return root;
+}
+
+//==============================================================================
+// Get Build Time - Msecs Since Epoch
+//==============================================================================
+qint64 NameIndex::buildTime() const
+{
+    return mappedData ? reinterpret_cast<const NameIndexFileHeader*>(mappedData)->buildTime : 0;
+}
+
+//==============================================================================
+// Get Entry Count
+//==============================================================================
+int NameIndex::entryCount() const
+{
+    return mappedData ? reinterpret_cast<const NameIndexFileHeader*>(mappedData)->entryCount : 0;
+}
+
+//==============================================================================
+// Search - Reports Entries Under aDirPath Matching The Name Matcher
+//==============================================================================
+void NameIndex::search(const QString& aDirPath,
+                       const GlobMatcher& aMatcher,
+                       const bool& aAbort,
+                       fileSearchItemFoundCallback aCallback,
+                       void* aContext) const
+{
+    // Check Index
+    if (!mappedData) {
+        return;
+    }
+
+    // Get Dir Path
+    QString dirPath = QDir::cleanPath(aDirPath);
+    // Get Relative Path Of The Searched Dir
+    QByteArray relativePath = dirPath == root ? QByteArray() : QFile::encodeName(dirPath.mid(niDirPrefix(root).length()));
+    // Get Relative Prefix - Sub Dirs Of The Searched Dir
+    QByteArray relativePrefix = relativePath.isEmpty() ? QByteArray() : relativePath + '/';
+
+    // Init Record
+    NameIndexDirRecord record;
+    // Get Data Bounds
+    const uchar* pos = dataStart();
+    const uchar* end = dataEnd();
+
+    // Go Thru Dirs
+    while (pos < end && !aAbort && niNextDir(pos, end, record)) {
+        // Check Dir Under The Searched Dir
+        if (record.path != relativePath && !record.path.startsWith(relativePrefix)) {
+            continue;
+        }
+
+        // Get Parent Path - Same Form As The Tree Walker Reports
+        QString parentPath = record.path == relativePath ? dirPath : niDirPrefix(dirPath) + QFile::decodeName(record.path.mid(relativePrefix.length()));
+
+        // Get Children Bounds
+        const uchar* childPos = record.children;
+        const uchar* childEnd = record.children + record.childBytes;
+        // Init Child Name & Type
+        QByteArray childName;
+        uchar childType = ENIETFile;
+
+        // Go Thru Children
+        while (childPos < childEnd && niNextChild(childPos, childEnd, childName, childType)) {
+            // Get File Name
+            QString fileName = QFile::decodeName(childName);
+
+            // Check Match & Callback
+            if (aMatcher.match(fileName) && aCallback) {
+                // Callback
+                aCallback(parentPath, niDirPrefix(parentPath) + fileName, NULL, aContext);
+            }
+        }
+    }
+}
+
+//==============================================================================
+// Paths - Reports Every Entry Under aDirPath
+//==============================================================================
+void NameIndex::paths(const QString& aDirPath,
+                      const bool& aAbort,
+                      nameIndexPathCallback aCallback,
+                      void* aContext) const
+{
+    // Check Index & Callback
+    if (!mappedData || !aCallback) {
+        return;
+    }
+
+    // Get Dir Path
+    QString dirPath = QDir::cleanPath(aDirPath);
+    // Get Relative Path Of The Searched Dir
+    QByteArray relativePath = dirPath == root ? QByteArray() : QFile::encodeName(dirPath.mid(niDirPrefix(root).length()));
+    // Get Relative Prefix - Sub Dirs Of The Searched Dir
+    QByteArray relativePrefix = relativePath.isEmpty() ? QByteArray() : relativePath + '/';
+    // Get Dir Prefix - Same Form As The Tree Walker Reports
+    QByteArray dirPrefix = QFile::encodeName(niDirPrefix(dirPath));
+
+    // Init Record
+    NameIndexDirRecord record;
+    // Get Data Bounds
+    const uchar* pos = dataStart();
+    const uchar* end = dataEnd();
+
+    // Go Thru Dirs
+    while (pos < end && !aAbort && niNextDir(pos, end, record)) {
+        // Check Dir Under The Searched Dir
+        if (record.path != relativePath && !record.path.startsWith(relativePrefix)) {
+            continue;
+        }
+
+        // Get Parent Prefix
+        QByteArray parentPrefix = record.path == relativePath ? dirPrefix : dirPrefix + record.path.mid(relativePrefix.length()) + '/';
+        // Get Parent Prefix Length
+        int ppLength = parentPrefix.size();
+
+        // Get Children Bounds
+        const uchar* childPos = record.children;
+        const uchar* childEnd = record.children + record.childBytes;
+        // Init Child Name & Type
+        QByteArray childName;
+        uchar childType = ENIETFile;
+
+        // Go Thru Children
+        while (childPos < childEnd && niNextChild(childPos, childEnd, childName, childType)) {
+            // Set Path - Parent Prefix Is Kept
+            parentPrefix.truncate(ppLength);
+            parentPrefix.append(childName);
+
+            // Callback
+            aCallback(parentPrefix, dirPrefix.size(), aContext);
+        }
+    }
+}
+
+//==============================================================================
+// Get Data Start
+//==============================================================================
+const uchar* NameIndex::dataStart() const
+{
+    return mappedData + sizeof(NameIndexFileHeader) + reinterpret_cast<const NameIndexFileHeader*>(mappedData)->rootLength;
+}
+
+//==============================================================================
+// Get Data End
+//==============================================================================
+const uchar* NameIndex::dataEnd() const
+{
+    return mappedData + mappedSize;
+}
+
+//==============================================================================
+// Unmap Index File
+//==============================================================================
+void NameIndex::unmapIndexFile()
+{
+    // Check Mapped Data
+    if (mappedData) {
+        // Unmap
+        indexFile.unmap(mappedData);
+        // Reset Mapped Data
+        mappedData = NULL;
+    }
+
+    // Close Index File
+    indexFile.close();
+
+    // Reset Mapped Size
+    mappedSize = 0;
+}
+
+//==============================================================================
+// Destructor
+//==============================================================================
+NameIndex::~NameIndex()
+{
+    // Unmap Index File
+    unmapIndexFile();
+}
+
+
+
+
+//==============================================================================
+// Constructor
+//==============================================================================
+NameIndexer::NameIndexer()
+{
+    // Make Index Dir
+    QDir().mkpath(getCacheDir() + "/" + DEFAULT_NAME_INDEX_DIR_NAME);
+
+    // Add Client - Indexes Are Loaded & Refreshed On The Watcher Thread
+    IndexWatcher::instance()->addClient(this);
+}
+
+//==============================================================================
+// Get Instance
+//==============================================================================
+NameIndexer* NameIndexer::instance()
+{
+    // Init Instance
+    static NameIndexer indexerInstance;
+
+    return &indexerInstance;
+}
+
+//==============================================================================
+// Get Index File Path
+//==============================================================================
+QString NameIndexer::indexFilePath(const QString& aRootPath)
+{
+    // Get Root Hash
+    QString rootHash = QString::fromLatin1(QCryptographicHash::hash(QFile::encodeName(aRootPath), QCryptographicHash::Sha1).toHex().constData());
+
+    return getCacheDir() + "/" + DEFAULT_NAME_INDEX_DIR_NAME + "/" + rootHash + DEFAULT_NAME_INDEX_FILE_SUFFIX;
+}
+
+//==============================================================================
+// Add Root - Nested Roots Are Merged Into The Outermost One
+//==============================================================================
+void NameIndexer::addRoot(const QString& aRootPath)
+{
+    // Add Root
+    IndexWatcher::instance()->addRoot(this, aRootPath);
+}
+
+//==============================================================================
+// Remove Root
+//==============================================================================
+void NameIndexer::removeRoot(const QString& aRootPath)
+{
+    // Remove Root
+    IndexWatcher::instance()->removeRoot(this, aRootPath);
+}
+
+//==============================================================================
+// Get Index For Dir - NULL If The Dir Is Not Under An Indexed Root, aStale If Changes Are Pending Or Can't Be Tracked
+//==============================================================================
+QSharedPointer<NameIndex> NameIndexer::indexFor(const QString& aDirPath, bool& aStale)
+{
+    // Find Root
+    QString rootPath = IndexWatcher::instance()->findRoot(this, aDirPath, aStale);
+
+    // Check Root Path
+    if (rootPath.isEmpty()) {
+        return QSharedPointer<NameIndex>();
+    }
+
+    // Init Locker
+    QMutexLocker locker(&mutex);
+
+    return indexes.value(rootPath);
+}
+
+//==============================================================================
+// Watches File Writes - Names Only Change With Entries
+//==============================================================================
+bool NameIndexer::watchesFileWrites() const
+{
+    return false;
+}
+
+//==============================================================================
+// Get Refresh Delay
+//==============================================================================
+qint64 NameIndexer::refreshDelay() const
+{
+    return DEFAULT_NAME_INDEX_REFRESH_DELAY_MS;
+}
+
+//==============================================================================
+// Get Time To Live
+//==============================================================================
+qint64 NameIndexer::timeToLive() const
+{
+    return (qint64)DEFAULT_NAME_INDEX_TTL_SECS * 1000;
+}
+
+//==============================================================================
+// Load Indexes - Existing Index Files, Refreshed Against Dir mtimes
+//==============================================================================
+void NameIndexer::loadIndexes(const bool& aAbort)
+{
+    // Get Index Dir Path
+    QString indexDirPath = getCacheDir() + "/" + DEFAULT_NAME_INDEX_DIR_NAME;
+    // Get Index Files
+    QStringList indexFiles = QDir(indexDirPath).entryList(QStringList() << QString("*") + DEFAULT_NAME_INDEX_FILE_SUFFIX, QDir::Files);
+
+    // Go Thru Index Files
+    for (int i=0; i<indexFiles.count() && !aAbort; ++i) {
+        // Get Index File Path
+        QString filePath = indexDirPath + "/" + indexFiles[i];
+        // Init Index
+        QSharedPointer<NameIndex> index(new NameIndex(filePath));
+
+        // Check Index - Invalid Indexes & Indexes Of Gone Roots Are Dropped
+        if (!index->isValid() || indexFilePath(index->rootPath()) != filePath || !QFileInfo(index->rootPath()).isDir()) {
+            qDebug() << "NameIndexer::loadIndexes - filePath: " << filePath << " - DROPPED";
+            // Clear Index
+            index.clear();
+            // Remove Index File
+            QFile::remove(filePath);
+            continue;
+        }
+
+        // Load Root - Refreshed Right Away, Changes While Not Running Show Up In Dir mtimes
+        if (IndexWatcher::instance()->loadRoot(this, index->rootPath(), index->buildTime(), true, QList<QByteArray>())) {
+            // Init Locker
+            QMutexLocker locker(&mutex);
+            // Set Index - Usable Right Away
+            indexes[index->rootPath()] = index;
+        }
+    }
+}
+
+//==============================================================================
+// Refresh Root - Unchanged Dirs Are Copied From The Previous Index
+//==============================================================================
+bool NameIndexer::refreshRoot(const QString& aRootPath, const QSet<QByteArray>* aChangedDirs, const bool& aAbort, QList<QByteArray>& aDirs)
+{
+    // Lock Mutex
+    mutex.lock();
+    // Get Previous Index
+    QSharedPointer<NameIndex> previous = indexes.value(aRootPath);
+    // Unlock Mutex
+    mutex.unlock();
+
+    qDebug() << "NameIndexer::refreshRoot - aRootPath: " << aRootPath;
+
+    // Get Index File Path
+    QString filePath = indexFilePath(aRootPath);
+
+    // Build Index File
+    if (!NameIndex::build(aRootPath, filePath, previous.data(), aChangedDirs, aAbort, aDirs)) {
+        return false;
+    }
+
+    // Init Index
+    QSharedPointer<NameIndex> index(new NameIndex(filePath));
+
+    // Check Index
+    if (!index->isValid()) {
+        return false;
+    }
+
+    // Init Locker
+    QMutexLocker locker(&mutex);
+    // Set Index
+    indexes[aRootPath] = index;
+
+    return true;
+}
+
+//==============================================================================
+// Drop Root
+//==============================================================================
+void NameIndexer::dropRoot(const QString& aRootPath)
+{
+    // Lock Mutex
+    mutex.lock();
+    // Remove Index
+    indexes.remove(aRootPath);
+    // Unlock Mutex
+    mutex.unlock();
+
+    // Remove Index File - Searches Still Using It Keep Their Mapping
+    QFile::remove(indexFilePath(aRootPath));
+}
+
+//==============================================================================
+// Destructor
+//==============================================================================
+NameIndexer::~NameIndexer()
+{
+    // Remove Client - Waits For A Running Refresh To Abort
+    IndexWatcher::instance()->removeClient(this);
+}
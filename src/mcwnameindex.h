@@ -0,0 +1,133 @@
+#ifndef NAMEINDEX_H
+#define NAMEINDEX_H
+
+#include <QString>
+#include <QByteArray>
+#include <QList>
+#include <QMap>
+#include <QSet>
+#include <QFile>
+#include <QMutex>
+#include <QSharedPointer>
+
+#include "mcwutility.h"
+#include "mcwindexwatcher.h"
+
+class GlobMatcher;
+
+// Name Index Path Callback Type - Local 8 Bit Path & Offset Of The Part Below The Searched Dir
+typedef void (*nameIndexPathCallback)(const QByteArray&, const int&, void*);
+
+
+//==============================================================================
+// Name Index Class - Persistent, Memory Mapped, Front Coded, One Per Root
+//==============================================================================
+class NameIndex
+{
+public:
+    // Build Index File - Unchanged Dirs Are Copied From aPrevious, Dirs In aChangedDirs Or With A New mtime Are Re-Read
+    static bool build(const QString& aRootPath,
+                      const QString& aFilePath,
+                      const NameIndex* aPrevious,
+                      const QSet<QByteArray>* aChangedDirs,
+                      const bool& aAbort,
+                      QList<QByteArray>& aDirs);
+
+    // Constructor - Maps An Index File
+    explicit NameIndex(const QString& aFilePath);
+
+    // Is Valid
+    bool isValid() const;
+    // Get Root Path
+    QString rootPath() const;
+    // Get Build Time - Msecs Since Epoch
+    qint64 buildTime() const;
+    // Get Entry Count
+    int entryCount() const;
+
+    // Search - Reports Entries Under aDirPath Matching The Name Matcher
+    void search(const QString& aDirPath,
+                const GlobMatcher& aMatcher,
+                const bool& aAbort,
+                fileSearchItemFoundCallback aCallback = NULL,
+                void* aContext = NULL) const;
+
+    // Paths - Reports Every Entry Under aDirPath
+    void paths(const QString& aDirPath,
+               const bool& aAbort,
+               nameIndexPathCallback aCallback,
+               void* aContext = NULL) const;
+
+    // Destructor
+    ~NameIndex();
+
+private:
+    // Get Data Start
+    const uchar* dataStart() const;
+    // Get Data End
+    const uchar* dataEnd() const;
+    // Unmap Index File
+    void unmapIndexFile();
+
+private:
+    // Index File
+    QFile           indexFile;
+    // Mapped Data
+    uchar*          mappedData;
+    // Mapped Size
+    qint64          mappedSize;
+    // Root Path
+    QString         root;
+};
+
+//==============================================================================
+// Name Indexer Class - Builds & Refreshes Filename Indexes Of The Roots Registered With The Index Watcher
+//==============================================================================
+class NameIndexer : public IndexWatcherClient
+{
+public:
+    // Get Instance
+    static NameIndexer* instance();
+
+    // Add Root - Nested Roots Are Merged Into The Outermost One
+    void addRoot(const QString& aRootPath);
+    // Remove Root
+    void removeRoot(const QString& aRootPath);
+
+    // Get Index For Dir - NULL If The Dir Is Not Under An Indexed Root, aStale If Changes Are Pending Or Can't Be Tracked
+    QSharedPointer<NameIndex> indexFor(const QString& aDirPath, bool& aStale);
+
+    // Destructor
+    virtual ~NameIndexer();
+
+protected: // From IndexWatcherClient
+
+    // Watches File Writes - Names Only Change With Entries
+    virtual bool watchesFileWrites() const;
+    // Get Refresh Delay
+    virtual qint64 refreshDelay() const;
+    // Get Time To Live
+    virtual qint64 timeToLive() const;
+
+    // Load Indexes - Existing Index Files, Refreshed Against Dir mtimes
+    virtual void loadIndexes(const bool& aAbort);
+    // Refresh Root - Unchanged Dirs Are Copied From The Previous Index
+    virtual bool refreshRoot(const QString& aRootPath, const QSet<QByteArray>* aChangedDirs, const bool& aAbort, QList<QByteArray>& aDirs);
+    // Drop Root
+    virtual void dropRoot(const QString& aRootPath);
+
+private:
+    // Constructor
+    NameIndexer();
+
+    // Get Index File Path
+    static QString indexFilePath(const QString& aRootPath);
+
+private:
+    // Mutex
+    QMutex                                      mutex;
+    // Indexes By Root
+    QMap<QString, QSharedPointer<NameIndex> >   indexes;
+};
+
+#endif // NAMEINDEX_H
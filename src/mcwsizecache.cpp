@@ -0,0 +1,589 @@
+#include <QSaveFile>
+#include <QDateTime>
+#include <QReadLocker>
+#include <QWriteLocker>
+#include <QtAlgorithms>
+#include <QDebug>
+
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#include "mcwsizecache.h"
+#include "mcwutility.h"
+#include "mcwconstants.h"
+
+
+//==============================================================================
+// Cache File Header
+//==============================================================================
+struct DirSizeCacheFileHeader
+{
+    // Magic
+    quint32     magic;
+    // Version
+    quint32     version;
+    // Record Count
+    quint32     recordCount;
+    // Child Count
+    quint32     childCount;
+    // Name Pool Size
+    quint64     poolSize;
+    // Reserved
+    quint64     reserved;
+};
+
+//==============================================================================
+// Cache File Record - Sorted By Device And Inode
+//==============================================================================
+struct DirSizeCacheFileRecord
+{
+    // Device
+    quint64     device;
+    // Inode
+    quint64     inode;
+    // Last Modified - Nsecs Since Epoch
+    qint64      lastModified;
+    // Scan Time - Secs Since Epoch
+    qint64      scanTime;
+    // Number Of Files
+    quint64     numFiles;
+    // Size Of Files
+    quint64     fileSize;
+    // First Child Index
+    quint32     firstChild;
+    // Child Count
+    quint32     childCount;
+};
+
+//==============================================================================
+// Cache File Child - Sub Dir Name In The Name Pool
+//==============================================================================
+struct DirSizeCacheFileChild
+{
+    // Name Offset
+    quint32     nameOffset;
+    // Name Length
+    quint32     nameLength;
+};
+
+//==============================================================================
+// Get Mapped Header
+//==============================================================================
+static inline const DirSizeCacheFileHeader* mappedHeader(const uchar* aData)
+{
+    return reinterpret_cast<const DirSizeCacheFileHeader*>(aData);
+}
+
+//==============================================================================
+// Get Mapped Records
+//==============================================================================
+static inline const DirSizeCacheFileRecord* mappedRecords(const uchar* aData)
+{
+    return reinterpret_cast<const DirSizeCacheFileRecord*>(aData + sizeof(DirSizeCacheFileHeader));
+}
+
+//==============================================================================
+// Get Mapped Children
+//==============================================================================
+static inline const DirSizeCacheFileChild* mappedChildren(const uchar* aData)
+{
+    return reinterpret_cast<const DirSizeCacheFileChild*>(mappedRecords(aData) + mappedHeader(aData)->recordCount);
+}
+
+//==============================================================================
+// Get Mapped Name Pool
+//==============================================================================
+static inline const char* mappedPool(const uchar* aData)
+{
+    return reinterpret_cast<const char*>(mappedChildren(aData) + mappedHeader(aData)->childCount);
+}
+
+//==============================================================================
+// Compare Keys
+//==============================================================================
+static inline int compareKeys(const quint64& aDevice, const quint64& aInode, const DirSizeCacheKey& aKey)
+{
+    // Compare Device
+    if (aDevice != aKey.device)
+        return aDevice < aKey.device ? -1 : 1;
+
+    // Compare Inode
+    if (aInode != aKey.inode)
+        return aInode < aKey.inode ? -1 : 1;
+
+    return 0;
+}
+
+//==============================================================================
+// Key Less Than
+//==============================================================================
+static bool keyLessThan(const DirSizeCacheKey& a, const DirSizeCacheKey& b)
+{
+    return compareKeys(a.device, a.inode, b) < 0;
+}
+
+//==============================================================================
+// Constructor
+//==============================================================================
+DirSizeCacheKey::DirSizeCacheKey(const quint64& aDevice, const quint64& aInode)
+    : device(aDevice)
+    , inode(aInode)
+{
+}
+
+//==============================================================================
+// Equal Operator
+//==============================================================================
+bool DirSizeCacheKey::operator==(const DirSizeCacheKey& aOther) const
+{
+    return device == aOther.device && inode == aOther.inode;
+}
+
+//==============================================================================
+// Hash Function
+//==============================================================================
+uint qHash(const DirSizeCacheKey& aKey, uint aSeed)
+{
+    return qHash(aKey.inode, aSeed) ^ qHash(aKey.device, aSeed);
+}
+
+//==============================================================================
+// Constructor
+//==============================================================================
+DirSizeCacheItem::DirSizeCacheItem()
+    : lastModified(0)
+    , scanTime(0)
+    , numFiles(0)
+    , fileSize(0)
+{
+}
+
+//==============================================================================
+// Constructor
+//==============================================================================
+DirSizeCache::DirSizeCache()
+    : mappedData(NULL)
+    , mappedSize(0)
+    , recordCount(0)
+{
+    // Set Cache File Path
+    cacheFilePath = getCacheDir() + "/" + DEFAULT_DIR_SIZE_CACHE_FILE_NAME;
+
+    // Map Cache File
+    mapCacheFile();
+}
+
+//==============================================================================
+// Get Instance
+//==============================================================================
+DirSizeCache* DirSizeCache::instance()
+{
+    // Init Instance
+    static DirSizeCache cacheInstance;
+
+    return &cacheInstance;
+}
+
+//==============================================================================
+// Stat Dir - Get Key And Last Modified In Nsecs
+//==============================================================================
+bool DirSizeCache::statDir(const QString& aDirPath, DirSizeCacheKey& aKey, qint64& aLastModified)
+{
+    // Init Stat
+    struct stat dirStat;
+
+    // Stat Dir
+    if (stat(QFile::encodeName(aDirPath).constData(), &dirStat) != 0 || !S_ISDIR(dirStat.st_mode)) {
+        return false;
+    }
+
+    // Set Key
+    aKey.device     = dirStat.st_dev;
+    aKey.inode      = dirStat.st_ino;
+
+#if defined(Q_OS_MAC)
+    // Set Last Modified
+    aLastModified   = (qint64)dirStat.st_mtimespec.tv_sec * 1000000000 + dirStat.st_mtimespec.tv_nsec;
+#else // Q_OS_MAC
+    // Set Last Modified
+    aLastModified   = (qint64)dirStat.st_mtim.tv_sec * 1000000000 + dirStat.st_mtim.tv_nsec;
+#endif // Q_OS_MAC
+
+    return true;
+}
+
+//==============================================================================
+// Look Up Dir - Fails If Not Cached, Modified Or Expired
+//==============================================================================
+bool DirSizeCache::lookup(const DirSizeCacheKey& aKey, const qint64& aLastModified, DirSizeCacheItem& aItem)
+{
+    // Init Locker
+    QReadLocker locker(&lock);
+
+    // Find Changed Item
+    QHash<DirSizeCacheKey, DirSizeCacheItem>::const_iterator it = changedItems.constFind(aKey);
+
+    // Check Changed Item
+    if (it != changedItems.constEnd()) {
+        // Check Last Modified & Expired
+        if (it.value().lastModified != aLastModified || isExpired(it.value().scanTime)) {
+            return false;
+        }
+
+        // Set Item
+        aItem = it.value();
+
+        return true;
+    }
+
+    // Find Mapped Record
+    int index = findMapped(aKey);
+
+    // Check Index
+    if (index < 0) {
+        return false;
+    }
+
+    // Get Record
+    const DirSizeCacheFileRecord& record = mappedRecords(mappedData)[index];
+
+    // Check Last Modified & Expired
+    if (record.lastModified != aLastModified || isExpired(record.scanTime)) {
+        return false;
+    }
+
+    // Read Mapped Item
+    readMapped(index, aItem);
+
+    return true;
+}
+
+//==============================================================================
+// Insert Dir
+//==============================================================================
+void DirSizeCache::insert(const DirSizeCacheKey& aKey, const DirSizeCacheItem& aItem)
+{
+    // Check If Modified Too Recently - Another Change Within The Same mtime Tick Would Go Unnoticed
+    if (aItem.scanTime - aItem.lastModified / 1000000000 < DEFAULT_DIR_SIZE_CACHE_RACY_SECS) {
+        return;
+    }
+
+    // Init Locker
+    QWriteLocker locker(&lock);
+
+    // Set Changed Item
+    changedItems[aKey] = aItem;
+}
+
+//==============================================================================
+// Append Record To Save Buffers
+//==============================================================================
+static void appendRecord(QByteArray& aRecords, QByteArray& aChildren, QByteArray& aPool, DirSizeCacheFileRecord aRecord, const QList<QByteArray>& aNames)
+{
+    // Set First Child
+    aRecord.firstChild = aChildren.size() / sizeof(DirSizeCacheFileChild);
+    // Set Child Count
+    aRecord.childCount = aNames.count();
+
+    // Go Thru Names
+    for (int i=0; i<aNames.count(); ++i) {
+        // Init Child
+        DirSizeCacheFileChild child;
+        // Set Name Offset
+        child.nameOffset = aPool.size();
+        // Set Name Length
+        child.nameLength = aNames[i].size();
+
+        // Add Name
+        aPool.append(aNames[i]);
+        // Add Child
+        aChildren.append(reinterpret_cast<const char*>(&child), sizeof(child));
+    }
+
+    // Add Record
+    aRecords.append(reinterpret_cast<const char*>(&aRecord), sizeof(aRecord));
+}
+
+//==============================================================================
+// Save Cache File If Changed
+//==============================================================================
+void DirSizeCache::save()
+{
+    // Init Locker
+    QWriteLocker locker(&lock);
+
+    // Check Changed Items
+    if (changedItems.isEmpty()) {
+        return;
+    }
+
+    // Get Changed Keys
+    QList<DirSizeCacheKey> changedKeys = changedItems.keys();
+    // Sort Changed Keys
+    qSort(changedKeys.begin(), changedKeys.end(), keyLessThan);
+
+    // Init Buffers
+    QByteArray records;
+    QByteArray children;
+    QByteArray pool;
+
+    // Init Indexes
+    int i = 0;
+    int j = 0;
+    // Get Changed Count
+    int cCount = changedKeys.count();
+
+    // Merge Mapped Records And Changed Items - Both Sorted
+    while (i < recordCount || j < cCount) {
+        // Compare Keys
+        int cmp = i >= recordCount ? 1 : j >= cCount ? -1 : compareKeys(mappedRecords(mappedData)[i].device, mappedRecords(mappedData)[i].inode, changedKeys[j]);
+
+        // Check Mapped Record
+        if (cmp < 0) {
+            // Check Expired
+            if (!isExpired(mappedRecords(mappedData)[i].scanTime)) {
+                // Init Item
+                DirSizeCacheItem item;
+                // Read Mapped Item
+                readMapped(i, item);
+                // Append Record
+                appendRecord(records, children, pool, mappedRecords(mappedData)[i], item.subDirs);
+            }
+
+            i++;
+
+            continue;
+        }
+
+        // Get Changed Item
+        const DirSizeCacheItem& item = changedItems[changedKeys[j]];
+
+        // Check Expired
+        if (!isExpired(item.scanTime)) {
+            // Init Record
+            DirSizeCacheFileRecord record;
+            // Set Up Record
+            record.device       = changedKeys[j].device;
+            record.inode        = changedKeys[j].inode;
+            record.lastModified = item.lastModified;
+            record.scanTime     = item.scanTime;
+            record.numFiles     = item.numFiles;
+            record.fileSize     = item.fileSize;
+            // Append Record
+            appendRecord(records, children, pool, record, item.subDirs);
+        }
+
+        // Check Replaced Mapped Record
+        if (cmp == 0) {
+            i++;
+        }
+
+        j++;
+    }
+
+    // Init Header
+    DirSizeCacheFileHeader header;
+    // Set Up Header
+    header.magic        = DEFAULT_DIR_SIZE_CACHE_MAGIC;
+    header.version      = DEFAULT_DIR_SIZE_CACHE_VERSION;
+    header.recordCount  = records.size() / sizeof(DirSizeCacheFileRecord);
+    header.childCount   = children.size() / sizeof(DirSizeCacheFileChild);
+    header.poolSize     = pool.size();
+    header.reserved     = 0;
+
+    // Init Save File
+    QSaveFile saveFile(cacheFilePath);
+
+    // Open Save File
+    if (!saveFile.open(QIODevice::WriteOnly)) {
+        qWarning() << "DirSizeCache::save - cacheFilePath: " << cacheFilePath << " - CAN NOT OPEN FILE!";
+        return;
+    }
+
+    // Write Data
+    saveFile.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    saveFile.write(records);
+    saveFile.write(children);
+    saveFile.write(pool);
+
+    // Unmap Cache File
+    unmapCacheFile();
+
+    // Commit
+    if (!saveFile.commit()) {
+        qWarning() << "DirSizeCache::save - cacheFilePath: " << cacheFilePath << " - COMMIT FAILED!";
+    }
+
+    // Clear Changed Items
+    changedItems.clear();
+
+    // Map Cache File
+    mapCacheFile();
+
+    qDebug() << "DirSizeCache::save - recordCount: " << recordCount;
+}
+
+//==============================================================================
+// Map Cache File
+//==============================================================================
+void DirSizeCache::mapCacheFile()
+{
+    // Set File Name
+    cacheFile.setFileName(cacheFilePath);
+
+    // Open Cache File
+    if (!cacheFile.open(QIODevice::ReadOnly)) {
+        return;
+    }
+
+    // Get Size
+    qint64 fileSize = cacheFile.size();
+
+    // Check Size
+    if (fileSize < (qint64)sizeof(DirSizeCacheFileHeader)) {
+        // Close Cache File
+        cacheFile.close();
+        return;
+    }
+
+    // Map File
+    mappedData = cacheFile.map(0, fileSize);
+
+    // Check Mapped Data
+    if (!mappedData) {
+        // Close Cache File
+        cacheFile.close();
+        return;
+    }
+
+    // Set Mapped Size
+    mappedSize = fileSize;
+
+    // Get Header
+    const DirSizeCacheFileHeader* header = mappedHeader(mappedData);
+
+    // Get Expected Size
+    qint64 expectedSize = sizeof(DirSizeCacheFileHeader)
+                        + (qint64)header->recordCount * sizeof(DirSizeCacheFileRecord)
+                        + (qint64)header->childCount * sizeof(DirSizeCacheFileChild)
+                        + (qint64)header->poolSize;
+
+    // Check Header
+    if (header->magic != DEFAULT_DIR_SIZE_CACHE_MAGIC || header->version != DEFAULT_DIR_SIZE_CACHE_VERSION || expectedSize != mappedSize) {
+        qWarning() << "DirSizeCache::mapCacheFile - cacheFilePath: " << cacheFilePath << " - INVALID CACHE FILE!";
+        // Unmap Cache File
+        unmapCacheFile();
+        return;
+    }
+
+    // Set Record Count
+    recordCount = header->recordCount;
+}
+
+//==============================================================================
+// Unmap Cache File
+//==============================================================================
+void DirSizeCache::unmapCacheFile()
+{
+    // Check Mapped Data
+    if (mappedData) {
+        // Unmap
+        cacheFile.unmap(mappedData);
+        // Reset Mapped Data
+        mappedData = NULL;
+    }
+
+    // Close Cache File
+    cacheFile.close();
+
+    // Reset Mapped Size
+    mappedSize  = 0;
+    // Reset Record Count
+    recordCount = 0;
+}
+
+//==============================================================================
+// Find Mapped Record - Binary Search
+//==============================================================================
+int DirSizeCache::findMapped(const DirSizeCacheKey& aKey) const
+{
+    // Get Records
+    const DirSizeCacheFileRecord* records = recordCount > 0 ? mappedRecords(mappedData) : NULL;
+
+    // Init Bounds
+    int left  = 0;
+    int right = recordCount - 1;
+
+    // Search
+    while (left <= right) {
+        // Get Middle
+        int middle = (left + right) / 2;
+        // Compare Keys
+        int cmp = compareKeys(records[middle].device, records[middle].inode, aKey);
+
+        // Check Result
+        if (cmp == 0)
+            return middle;
+
+        // Adjust Bounds
+        if (cmp < 0)
+            left = middle + 1;
+        else
+            right = middle - 1;
+    }
+
+    return -1;
+}
+
+//==============================================================================
+// Read Mapped Item
+//==============================================================================
+void DirSizeCache::readMapped(const int& aIndex, DirSizeCacheItem& aItem) const
+{
+    // Get Record
+    const DirSizeCacheFileRecord& record = mappedRecords(mappedData)[aIndex];
+    // Get Children
+    const DirSizeCacheFileChild* children = mappedChildren(mappedData);
+    // Get Name Pool
+    const char* pool = mappedPool(mappedData);
+    // Get Name Pool Size
+    quint64 poolSize = mappedHeader(mappedData)->poolSize;
+
+    // Set Up Item
+    aItem.lastModified  = record.lastModified;
+    aItem.scanTime      = record.scanTime;
+    aItem.numFiles      = record.numFiles;
+    aItem.fileSize      = record.fileSize;
+    aItem.subDirs.clear();
+
+    // Go Thru Children
+    for (quint32 i=0; i<record.childCount && record.firstChild + i < mappedHeader(mappedData)->childCount; ++i) {
+        // Get Child
+        const DirSizeCacheFileChild& child = children[record.firstChild + i];
+
+        // Check Name Bounds
+        if ((quint64)child.nameOffset + child.nameLength > poolSize) {
+            break;
+        }
+
+        // Add Sub Dir Name
+        aItem.subDirs << QByteArray(pool + child.nameOffset, child.nameLength);
+    }
+}
+
+//==============================================================================
+// Is Expired
+//==============================================================================
+bool DirSizeCache::isExpired(const qint64& aScanTime) const
+{
+    return QDateTime::currentMSecsSinceEpoch() / 1000 - aScanTime > DEFAULT_DIR_SIZE_CACHE_TTL_SECS;
+}
+
+//==============================================================================
+// Destructor
+//==============================================================================
+DirSizeCache::~DirSizeCache()
+{
+    // Unmap Cache File
+    unmapCacheFile();
+}
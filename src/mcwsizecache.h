@@ -0,0 +1,110 @@
+#ifndef SIZECACHE_H
+#define SIZECACHE_H
+
+#include <QString>
+#include <QByteArray>
+#include <QList>
+#include <QHash>
+#include <QFile>
+#include <QReadWriteLock>
+
+
+//==============================================================================
+// Dir Size Cache Key
+//==============================================================================
+class DirSizeCacheKey
+{
+public:
+    // Constructor
+    DirSizeCacheKey(const quint64& aDevice = 0, const quint64& aInode = 0);
+
+    // Equal Operator
+    bool operator==(const DirSizeCacheKey& aOther) const;
+
+    // Device
+    quint64     device;
+    // Inode
+    quint64     inode;
+};
+
+// Hash Function
+uint qHash(const DirSizeCacheKey& aKey, uint aSeed = 0);
+
+//==============================================================================
+// Dir Size Cache Item - Direct Entries Of A Single Dir
+//==============================================================================
+class DirSizeCacheItem
+{
+public:
+    // Constructor
+    DirSizeCacheItem();
+
+    // Last Modified - Nsecs Since Epoch
+    qint64              lastModified;
+    // Scan Time - Secs Since Epoch
+    qint64              scanTime;
+    // Number Of Files
+    quint64             numFiles;
+    // Size Of Files
+    quint64             fileSize;
+    // Sub Dir Names
+    QList<QByteArray>   subDirs;
+};
+
+//==============================================================================
+// Dir Size Cache Class - Persistent, Keyed By Device And Inode, Validated By Dir mtime
+//==============================================================================
+class DirSizeCache
+{
+public:
+    // Get Instance
+    static DirSizeCache* instance();
+
+    // Stat Dir - Get Key And Last Modified In Nsecs
+    static bool statDir(const QString& aDirPath, DirSizeCacheKey& aKey, qint64& aLastModified);
+
+    // Look Up Dir - Fails If Not Cached, Modified Or Expired
+    bool lookup(const DirSizeCacheKey& aKey, const qint64& aLastModified, DirSizeCacheItem& aItem);
+    // Insert Dir
+    void insert(const DirSizeCacheKey& aKey, const DirSizeCacheItem& aItem);
+
+    // Save Cache File If Changed
+    void save();
+
+    // Destructor
+    ~DirSizeCache();
+
+private:
+    // Constructor
+    DirSizeCache();
+
+    // Map Cache File
+    void mapCacheFile();
+    // Unmap Cache File
+    void unmapCacheFile();
+
+    // Find Mapped Record
+    int findMapped(const DirSizeCacheKey& aKey) const;
+    // Read Mapped Item
+    void readMapped(const int& aIndex, DirSizeCacheItem& aItem) const;
+    // Is Expired
+    bool isExpired(const qint64& aScanTime) const;
+
+private:
+    // Lock
+    QReadWriteLock                              lock;
+    // Cache File Path
+    QString                                     cacheFilePath;
+    // Cache File
+    QFile                                       cacheFile;
+    // Mapped Data
+    uchar*                                      mappedData;
+    // Mapped Size
+    qint64                                      mappedSize;
+    // Mapped Record Count
+    int                                         recordCount;
+    // Changed Items - Not Yet Saved
+    QHash<DirSizeCacheKey, DirSizeCacheItem>    changedItems;
+};
+
+#endif // SIZECACHE_H
@@ -0,0 +1,596 @@
+#include <QFile>
+#include <QThreadPool>
+#include <QThreadStorage>
+#include <QRunnable>
+#include <QSemaphore>
+#include <QDebug>
+
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <dirent.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <stdlib.h>
+
+#include <errno.h>
+
+#if defined(Q_OS_LINUX) && defined(MCW_USE_IO_URING)
+#include <sys/sysmacros.h>
+#include <liburing.h>
+#endif // MCW_USE_IO_URING
+
+#include "mcwstatbatch.h"
+#include "mcwconstants.h"
+
+
+//==============================================================================
+// Constructor
+//==============================================================================
+StatBatchEntry::StatBatchEntry()
+    : size(0)
+    , lastModified(0)
+    , mode(0)
+    , uid(0)
+    , device(0)
+    , inode(0)
+    , dirType(DT_UNKNOWN)
+    , isDir(false)
+    , isSymLink(false)
+    , valid(false)
+{
+}
+
+//==============================================================================
+// Fill Entry From Stat
+//==============================================================================
+static void fillStatBatchEntry(StatBatchEntry& aEntry, const struct stat& aStat)
+{
+    // Set Size
+    aEntry.size         = aStat.st_size;
+#if defined(Q_OS_MAC)
+    // Set Last Modified
+    aEntry.lastModified = (qint64)aStat.st_mtimespec.tv_sec * 1000 + aStat.st_mtimespec.tv_nsec / 1000000;
+#else // Q_OS_MAC
+    // Set Last Modified
+    aEntry.lastModified = (qint64)aStat.st_mtim.tv_sec * 1000 + aStat.st_mtim.tv_nsec / 1000000;
+#endif // Q_OS_MAC
+    // Set Mode
+    aEntry.mode         = aStat.st_mode;
+    // Set Owner
+    aEntry.uid          = aStat.st_uid;
+    // Set Device
+    aEntry.device       = aStat.st_dev;
+    // Set Inode
+    aEntry.inode        = aStat.st_ino;
+    // Set Is Dir
+    aEntry.isDir        = S_ISDIR(aStat.st_mode);
+    // Set Is Link
+    aEntry.isSymLink    = S_ISLNK(aStat.st_mode);
+    // Set Valid
+    aEntry.valid        = true;
+}
+
+//==============================================================================
+// Resolve Symlink Target - Size And Type Follow The Link Like QFileInfo
+//==============================================================================
+static void resolveStatBatchLink(const int& aDirFd, StatBatchEntry& aEntry)
+{
+    // Init Target Stat
+    struct stat targetStat;
+
+    // Stat Link Target
+    if (fstatat(aDirFd, aEntry.name.constData(), &targetStat, 0) == 0) {
+        // Set Size
+        aEntry.size  = targetStat.st_size;
+        // Set Is Dir
+        aEntry.isDir = S_ISDIR(targetStat.st_mode);
+    }
+}
+
+//==============================================================================
+// Stat Single Entry
+//==============================================================================
+static void statBatchEntry(const int& aDirFd, StatBatchEntry& aEntry)
+{
+    // Init Stat
+    struct stat entryStat;
+
+    // Stat Entry - Don't Follow Links
+    if (fstatat(aDirFd, aEntry.name.constData(), &entryStat, AT_SYMLINK_NOFOLLOW) != 0) {
+        return;
+    }
+
+    // Fill Entry
+    fillStatBatchEntry(aEntry, entryStat);
+
+    // Check If Link
+    if (aEntry.isSymLink) {
+        // Resolve Link
+        resolveStatBatchLink(aDirFd, aEntry);
+    }
+}
+
+//==============================================================================
+// Stat Batch Task Class - Thread Pool Fallback
+//==============================================================================
+class StatBatchTask : public QRunnable
+{
+public:
+    // Constructor
+    StatBatchTask(const int& aDirFd, StatBatchEntry* aEntries, const int& aCount, const int& aFirst, const int& aStep, const bool& aAbort, QSemaphore& aDone)
+        : dirFd(aDirFd)
+        , entries(aEntries)
+        , count(aCount)
+        , first(aFirst)
+        , step(aStep)
+        , abortFlag(aAbort)
+        , done(aDone)
+    {
+        // Set Auto Delete
+        setAutoDelete(true);
+    }
+
+    // Run
+    virtual void run()
+    {
+        // Go Thru Entries Of This Stripe
+        for (int i=first; i<count && !abortFlag; i+=step) {
+            // Check Entry - May Be Done By A Failed io_uring Pass
+            if (!entries[i].valid) {
+                // Stat Entry
+                statBatchEntry(dirFd, entries[i]);
+            }
+        }
+
+        // Release Done Semaphore
+        done.release();
+    }
+
+private:
+    // Dir File Descriptor
+    int                 dirFd;
+    // Entries
+    StatBatchEntry*     entries;
+    // Count
+    int                 count;
+    // First Index
+    int                 first;
+    // Step
+    int                 step;
+    // Abort Flag
+    const bool&         abortFlag;
+    // Done Semaphore
+    QSemaphore&         done;
+};
+
+//==============================================================================
+// Get Stat Batch Thread Pool
+//==============================================================================
+static QThreadPool* statBatchThreadPool()
+{
+    // Init Thread Pool - Stat Calls Block On Network Round Trips, Not CPU
+    static QThreadPool statPool;
+
+    return &statPool;
+}
+
+//==============================================================================
+// Stat Entries Using The Thread Pool
+//==============================================================================
+static void statBatchThreaded(const int& aDirFd, StatBatchEntry* aEntries, const int& aCount, const int& aQueueDepth, const bool& aAbort)
+{
+    // Get Thread Pool
+    QThreadPool* pool = statBatchThreadPool();
+
+    // Check Max Thread Count
+    if (pool->maxThreadCount() < aQueueDepth) {
+        // Set Max Thread Count
+        pool->setMaxThreadCount(aQueueDepth);
+    }
+
+    // Get Number Of Stripes
+    int stripes = qMin(aQueueDepth, aCount);
+
+    // Init Done Semaphore
+    QSemaphore done;
+
+    // Go Thru Stripes
+    for (int i=0; i<stripes; ++i) {
+        // Start Task
+        pool->start(new StatBatchTask(aDirFd, aEntries, aCount, i, stripes, aAbort, done));
+    }
+
+    // Wait For All Stripes
+    done.acquire(stripes);
+}
+
+#if defined(Q_OS_LINUX) && defined(MCW_USE_IO_URING)
+
+//==============================================================================
+// Fill Entry From Statx
+//==============================================================================
+static void fillStatBatchEntry(StatBatchEntry& aEntry, const struct statx& aStatx)
+{
+    // Set Size
+    aEntry.size         = aStatx.stx_size;
+    // Set Last Modified
+    aEntry.lastModified = (qint64)aStatx.stx_mtime.tv_sec * 1000 + aStatx.stx_mtime.tv_nsec / 1000000;
+    // Set Mode
+    aEntry.mode         = aStatx.stx_mode;
+    // Set Owner
+    aEntry.uid          = aStatx.stx_uid;
+    // Set Device
+    aEntry.device       = makedev(aStatx.stx_dev_major, aStatx.stx_dev_minor);
+    // Set Inode
+    aEntry.inode        = aStatx.stx_ino;
+    // Set Is Dir
+    aEntry.isDir        = S_ISDIR(aStatx.stx_mode);
+    // Set Is Link
+    aEntry.isSymLink    = S_ISLNK(aStatx.stx_mode);
+    // Set Valid
+    aEntry.valid        = true;
+}
+
+//==============================================================================
+// io_uring Stat Ring Class - One Per Thread, Reused Across Directories
+//==============================================================================
+class StatBatchRing
+{
+public:
+    // Constructor
+    explicit StatBatchRing(const int& aQueueDepth)
+        : depth(aQueueDepth)
+        , ready(io_uring_queue_init(aQueueDepth, &ring, 0) == 0)
+    {
+    }
+
+    // Destructor
+    ~StatBatchRing()
+    {
+        // Check Ready
+        if (ready) {
+            // Exit Queue
+            io_uring_queue_exit(&ring);
+        }
+    }
+
+    // Queue Depth
+    int                 depth;
+    // Ring Initialized
+    bool                ready;
+    // Ring
+    struct io_uring     ring;
+};
+
+// Per Thread Stat Rings
+static QThreadStorage<StatBatchRing*> statBatchRings;
+
+//==============================================================================
+// Stat Entries Using io_uring - Returns false If The Ring Is Not Usable
+//==============================================================================
+static bool statBatchUring(const int& aDirFd, StatBatchEntry* aEntries, const int& aCount, const int& aQueueDepth, const bool& aAbort)
+{
+    // Check Thread Ring
+    if (!statBatchRings.hasLocalData() || statBatchRings.localData()->depth != aQueueDepth) {
+        // Set Thread Ring - Deletes Previous One
+        statBatchRings.setLocalData(new StatBatchRing(aQueueDepth));
+    }
+
+    // Get Ring
+    StatBatchRing* statRing = statBatchRings.localData();
+
+    // Check Ring
+    if (!statRing->ready) {
+        return false;
+    }
+
+    // Init Statx Buffers
+    QVector<struct statx> buffers(aQueueDepth);
+    // Init Slot Entry Indexes
+    QVector<int> slotEntries(aQueueDepth);
+    // Init Free Slots
+    QVector<int> freeSlots;
+
+    // Go Thru Slots
+    for (int i=aQueueDepth-1; i>=0; --i) {
+        // Add Free Slot
+        freeSlots << i;
+    }
+
+    // Init Next Entry Index
+    int next = 0;
+    // Init In Flight Count
+    int inFlight = 0;
+    // Init Failed
+    bool failed = false;
+
+    // Loop Until All Submitted & Reaped
+    while (next < aCount || inFlight > 0) {
+
+        // Fill Submission Queue
+        while (next < aCount && !freeSlots.isEmpty() && !aAbort && !failed) {
+            // Get Submission Queue Entry
+            struct io_uring_sqe* sqe = io_uring_get_sqe(&statRing->ring);
+
+            // Check Submission Queue Entry
+            if (!sqe) {
+                break;
+            }
+
+            // Get Free Slot
+            int slot = freeSlots.takeLast();
+            // Set Slot Entry
+            slotEntries[slot] = next;
+
+            // Prepare Statx - Don't Follow Links
+            io_uring_prep_statx(sqe, aDirFd, aEntries[next].name.constData(), AT_SYMLINK_NOFOLLOW, STATX_BASIC_STATS, &buffers[slot]);
+            // Set User Data
+            io_uring_sqe_set_data(sqe, (void*)(quintptr)slot);
+
+            // Inc Next
+            next++;
+            // Inc In Flight
+            inFlight++;
+        }
+
+        // Check In Flight - Aborted Or Failed With Nothing Pending
+        if (inFlight <= 0) {
+            break;
+        }
+
+        // Init Wait Completion Queue Entry - Written By liburing, Reaped Below
+        struct io_uring_cqe* waitCqe = NULL;
+        // Submit And Wait For At Least One Completion
+        int result = failed ? io_uring_wait_cqe_nr(&statRing->ring, &waitCqe, 1) : io_uring_submit_and_wait(&statRing->ring, 1);
+
+        // Check Result
+        if (result < 0 && result != -EINTR && result != -EAGAIN && result != -EBUSY) {
+            qWarning() << "statBatchUring - result: " << result;
+
+            // Check Failed - Nothing Left To Wait For
+            if (failed) {
+                break;
+            }
+
+            // Set Failed - Stop Submitting, Keep Reaping The Buffers Still In Use
+            failed = true;
+        }
+
+        // Init Completion Queue Entry
+        struct io_uring_cqe* cqe = NULL;
+        // Init Head
+        unsigned head = 0;
+        // Init Reaped
+        unsigned reaped = 0;
+
+        // Go Thru Available Completions
+        io_uring_for_each_cqe(&statRing->ring, head, cqe) {
+            // Get Slot
+            int slot = (int)(quintptr)io_uring_cqe_get_data(cqe);
+
+            // Check Result
+            if (cqe->res == 0) {
+                // Fill Entry
+                fillStatBatchEntry(aEntries[slotEntries[slot]], buffers[slot]);
+            }
+
+            // Release Slot
+            freeSlots << slot;
+            // Dec In Flight
+            inFlight--;
+            // Inc Reaped
+            reaped++;
+        }
+
+        // Advance Completion Queue
+        io_uring_cq_advance(&statRing->ring, reaped);
+    }
+
+    // Go Thru Entries
+    for (int i=0; i<next; ++i) {
+        // Check If Link
+        if (aEntries[i].isSymLink) {
+            // Resolve Link
+            resolveStatBatchLink(aDirFd, aEntries[i]);
+        }
+    }
+
+    return !failed;
+}
+
+//==============================================================================
+// Probe io_uring Stat Backend - IORING_OP_STATX Needs Linux 5.6
+//==============================================================================
+static bool probeStatBatchUring()
+{
+    // Init Available
+    bool available = false;
+    // Init Probe Ring
+    struct io_uring ring;
+
+    // Init Ring
+    if (io_uring_queue_init(2, &ring, 0) == 0) {
+        // Get Probe
+        struct io_uring_probe* probe = io_uring_get_probe_ring(&ring);
+
+        // Check Probe
+        if (probe) {
+            // Set Available
+            available = io_uring_opcode_supported(probe, IORING_OP_STATX);
+            // Free Probe
+            io_uring_free_probe(probe);
+        }
+
+        // Exit Ring
+        io_uring_queue_exit(&ring);
+    }
+
+    qDebug() << "probeStatBatchUring - available: " << available;
+
+    return available;
+}
+
+#endif // MCW_USE_IO_URING
+
+//==============================================================================
+// Is io_uring Stat Backend Available
+//==============================================================================
+bool statBatchUringAvailable()
+{
+#if defined(Q_OS_LINUX) && defined(MCW_USE_IO_URING)
+
+    // Init Available - Probed Once, Function Local Statics Are Initialized Thread Safely
+    static const bool available = probeStatBatchUring();
+
+    return available;
+
+#else // MCW_USE_IO_URING
+
+    return false;
+
+#endif // MCW_USE_IO_URING
+}
+
+//==============================================================================
+// Read Stat Batch Queue Depth - Environment Or Default, Bounded
+//==============================================================================
+static int readStatBatchQueueDepth()
+{
+    // Get Queue Depth From Environment
+    int queueDepth = qgetenv(DEFAULT_STAT_BATCH_QUEUE_DEPTH_ENV).toInt();
+
+    // Check Queue Depth
+    if (queueDepth <= 0) {
+        // Set Default Queue Depth
+        queueDepth = DEFAULT_STAT_BATCH_QUEUE_DEPTH;
+    }
+
+    // Bound Queue Depth
+    return qBound(1, queueDepth, DEFAULT_STAT_BATCH_MAX_QUEUE_DEPTH);
+}
+
+//==============================================================================
+// Get Stat Batch Queue Depth
+//==============================================================================
+int statBatchQueueDepth()
+{
+    // Init Queue Depth - Read Once, Function Local Statics Are Initialized Thread Safely
+    static const int queueDepth = readStatBatchQueueDepth();
+
+    return queueDepth;
+}
+
+//==============================================================================
+// Read Dir Entry Names - No Stat
+//==============================================================================
+bool readDirEntries(const QString& aDirPath, StatBatchList& aEntries, const bool& aShowHidden, const bool& aDotDot)
+{
+    // Open Dir
+    DIR* dir = opendir(QFile::encodeName(aDirPath).constData());
+
+    // Check Dir
+    if (!dir) {
+        return false;
+    }
+
+    // Init Dir Entry
+    struct dirent* dirEntry = NULL;
+
+    // Go Thru Dir Entries
+    while ((dirEntry = readdir(dir)) != NULL) {
+        // Get Name
+        const char* name = dirEntry->d_name;
+
+        // Check Dot
+        if (name[0] == '.') {
+            // Check Current Dir
+            if (name[1] == '\0') {
+                continue;
+            }
+
+            // Check Parent Dir
+            if (name[1] == '.' && name[2] == '\0') {
+                // Check Dot Dot
+                if (!aDotDot) {
+                    continue;
+                }
+
+            } else if (!aShowHidden) {
+                // Skip Hidden
+                continue;
+            }
+        }
+
+        // Init New Entry
+        StatBatchEntry newEntry;
+        // Set Name
+        newEntry.name = QByteArray(name);
+        // Set Dir Entry Type
+        newEntry.dirType = dirEntry->d_type;
+
+        // Add Entry
+        aEntries << newEntry;
+    }
+
+    // Close Dir
+    closedir(dir);
+
+    return true;
+}
+
+//==============================================================================
+// Stat Dir Entries In Batches
+//==============================================================================
+void statBatch(const QString& aDirPath, StatBatchList& aEntries, const int& aQueueDepth, const bool& aAbort)
+{
+    // Get Entries Count
+    int eCount = aEntries.count();
+
+    // Check Count
+    if (eCount <= 0) {
+        return;
+    }
+
+    // Open Dir - All Stats Are Relative To It
+    int dirFd = open(QFile::encodeName(aDirPath).constData(), O_RDONLY | O_DIRECTORY);
+
+    // Check Dir Fd
+    if (dirFd < 0) {
+        return;
+    }
+
+    // Get Entries - Detach Before Handing Out To Other Threads
+    StatBatchEntry* entries = aEntries.data();
+
+    // Check Count & Queue Depth - Small Dirs Are Not Worth The Batching
+    if (eCount < DEFAULT_STAT_BATCH_MIN_ENTRIES || aQueueDepth <= 1) {
+        // Go Thru Entries
+        for (int i=0; i<eCount && !aAbort; ++i) {
+            // Stat Entry
+            statBatchEntry(dirFd, entries[i]);
+        }
+
+        // Close Dir Fd
+        close(dirFd);
+
+        return;
+    }
+
+#if defined(Q_OS_LINUX) && defined(MCW_USE_IO_URING)
+
+    // Check io_uring
+    if (statBatchUringAvailable() && statBatchUring(dirFd, entries, eCount, aQueueDepth, aAbort)) {
+        // Close Dir Fd
+        close(dirFd);
+
+        return;
+    }
+
+#endif // MCW_USE_IO_URING
+
+    // Stat Using Thread Pool
+    statBatchThreaded(dirFd, entries, eCount, aQueueDepth, aAbort);
+
+    // Close Dir Fd
+    close(dirFd);
+}
@@ -0,0 +1,60 @@
+#ifndef STATBATCH_H
+#define STATBATCH_H
+
+#include <QString>
+#include <QByteArray>
+#include <QVector>
+
+
+//==============================================================================
+// Stat Batch Entry Class
+//==============================================================================
+class StatBatchEntry
+{
+public:
+    // Constructor
+    StatBatchEntry();
+
+    // Name - Local 8 Bit As Returned By readdir
+    QByteArray  name;
+    // Size - Symlink Target Size For Links
+    qint64      size;
+    // Last Modified - Msecs Since Epoch
+    qint64      lastModified;
+    // Mode - lstat Mode
+    quint32     mode;
+    // Owner User ID
+    quint32     uid;
+    // Device
+    quint64     device;
+    // Inode
+    quint64     inode;
+    // Dir Entry Type - d_type Hint, DT_UNKNOWN If Not Reported
+    quint8      dirType;
+    // Is Dir - Symlink Target Type For Links
+    bool        isDir;
+    // Is Link
+    bool        isSymLink;
+    // Valid - Stat Succeeded
+    bool        valid;
+};
+
+//==============================================================================
+// Stat Batch List Type
+//==============================================================================
+typedef QVector<StatBatchEntry> StatBatchList;
+
+
+// Read Dir Entry Names - No Stat
+bool readDirEntries(const QString& aDirPath, StatBatchList& aEntries, const bool& aShowHidden = true, const bool& aDotDot = false);
+
+// Stat Dir Entries In Batches
+void statBatch(const QString& aDirPath, StatBatchList& aEntries, const int& aQueueDepth, const bool& aAbort);
+
+// Get Stat Batch Queue Depth
+int statBatchQueueDepth();
+
+// Is io_uring Stat Backend Available
+bool statBatchUringAvailable();
+
+#endif // STATBATCH_H
@@ -0,0 +1,157 @@
+#include <QQueue>
+#include <QDebug>
+
+#include "mcwtermautomaton.h"
+
+
+//==============================================================================
+// Constructor
+//==============================================================================
+TermAutomaton::TermAutomaton()
+    : transitions(256, -1)
+    , stateOutputs(1)
+    , maxLength(0)
+{
+}
+
+//==============================================================================
+// Add Pattern - Folded If Case Insensitive, Several Patterns May Share A Term
+//==============================================================================
+void TermAutomaton::addPattern(const QByteArray& aPattern, const int& aTerm)
+{
+    // Get Pattern Length
+    int pLength = aPattern.length();
+
+    // Check Pattern
+    if (pLength == 0) {
+        return;
+    }
+
+    // Init State
+    int state = 0;
+
+    // Go Thru Pattern - Trie Insert
+    for (int i=0; i<pLength; ++i) {
+        // Get Transition Index
+        int index = (state << 8) | (uchar)aPattern[i];
+
+        // Check Transition
+        if (transitions[index] < 0) {
+            // Add State
+            transitions[index] = stateOutputs.count();
+            transitions += QVector<int>(256, -1);
+            stateOutputs.resize(stateOutputs.count() + 1);
+        }
+
+        // Next State
+        state = transitions[index];
+    }
+
+    // Add Output
+    stateOutputs[state] << patternTerms.count();
+    // Add Pattern Term & Length
+    patternTerms << aTerm;
+    patternLengths << pLength;
+    // Update Max Length
+    maxLength = qMax(maxLength, pLength);
+}
+
+//==============================================================================
+// Build - Failure Links Resolved Into The Table, ASCII Upper Case Folded Into It
+//==============================================================================
+void TermAutomaton::build(const bool& aCaseSensitive)
+{
+    // Get State Count
+    int sCount = stateOutputs.count();
+
+    // Init Failure Links
+    QVector<int> failures(sCount, 0);
+    // Init Queue - Breadth First, Failures Point To Shallower States
+    QQueue<int> queue;
+
+    // Go Thru Root Transitions
+    for (int c=0; c<256; ++c) {
+        // Check Transition
+        if (transitions[c] < 0) {
+            // Loop To Root
+            transitions[c] = 0;
+        } else {
+            // Enqueue Child - Fails To Root
+            queue.enqueue(transitions[c]);
+        }
+    }
+
+    // Go Thru States
+    while (!queue.isEmpty()) {
+        // Get State
+        int state = queue.dequeue();
+        // Get Failure
+        int failure = failures[state];
+
+        // Inherit Failure Outputs - Suffixes Ending Here
+        stateOutputs[state] += stateOutputs[failure];
+
+        // Go Thru Bytes
+        for (int c=0; c<256; ++c) {
+            // Get Transition Index
+            int index = (state << 8) | c;
+
+            // Check Transition
+            if (transitions[index] < 0) {
+                // Follow Failure - Already Complete, It Is Shallower
+                transitions[index] = transitions[(failure << 8) | c];
+            } else {
+                // Set Child Failure
+                failures[transitions[index]] = transitions[(failure << 8) | c];
+                // Enqueue Child
+                queue.enqueue(transitions[index]);
+            }
+        }
+    }
+
+    // Check Case Sensitive
+    if (aCaseSensitive) {
+        return;
+    }
+
+    // Go Thru States - Upper Case Bytes Move Like Their Folded Bytes
+    for (int s=0; s<sCount; ++s) {
+        // Go Thru Upper Case Bytes
+        for (int c='A'; c<='Z'; ++c) {
+            // Copy Folded Transition
+            transitions[(s << 8) | c] = transitions[(s << 8) | (c | 0x20)];
+        }
+    }
+}
+
+//==============================================================================
+// Is Empty
+//==============================================================================
+bool TermAutomaton::isEmpty() const
+{
+    return patternTerms.isEmpty();
+}
+
+//==============================================================================
+// Get Pattern Term
+//==============================================================================
+int TermAutomaton::patternTerm(const int& aPattern) const
+{
+    return patternTerms[aPattern];
+}
+
+//==============================================================================
+// Get Pattern Length
+//==============================================================================
+int TermAutomaton::patternLength(const int& aPattern) const
+{
+    return patternLengths[aPattern];
+}
+
+//==============================================================================
+// Get Max Pattern Length
+//==============================================================================
+int TermAutomaton::maxPatternLength() const
+{
+    return maxLength;
+}
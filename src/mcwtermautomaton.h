@@ -0,0 +1,58 @@
+#ifndef TERMAUTOMATON_H
+#define TERMAUTOMATON_H
+
+#include <QByteArray>
+#include <QVector>
+
+
+//==============================================================================
+// Term Automaton Class - Aho-Corasick, Dense Transition Table Over Bytes
+//==============================================================================
+class TermAutomaton
+{
+public:
+    // Constructor
+    TermAutomaton();
+
+    // Add Pattern - Folded If Case Insensitive, Several Patterns May Share A Term
+    void addPattern(const QByteArray& aPattern, const int& aTerm);
+
+    // Build - Failure Links Resolved Into The Table, ASCII Upper Case Folded Into It
+    void build(const bool& aCaseSensitive);
+
+    // Is Empty
+    bool isEmpty() const;
+
+    // Get Next State
+    inline int next(const int& aState, const uchar& aByte) const
+    {
+        return transitions[(aState << 8) | aByte];
+    }
+
+    // Get Outputs - Patterns Ending In The State, Empty For Most States
+    inline const QVector<int>& outputs(const int& aState) const
+    {
+        return stateOutputs[aState];
+    }
+
+    // Get Pattern Term
+    int patternTerm(const int& aPattern) const;
+    // Get Pattern Length
+    int patternLength(const int& aPattern) const;
+    // Get Max Pattern Length
+    int maxPatternLength() const;
+
+private:
+    // Transitions - 256 Per State, -1 Before Build
+    QVector<int>            transitions;
+    // State Outputs
+    QVector<QVector<int> >  stateOutputs;
+    // Pattern Terms
+    QVector<int>            patternTerms;
+    // Pattern Lengths
+    QVector<int>            patternLengths;
+    // Max Pattern Length
+    int                     maxLength;
+};
+
+#endif // TERMAUTOMATON_H
@@ -0,0 +1,458 @@
+#include <QFile>
+#include <QDebug>
+
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <dirent.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "mcwtreewalker.h"
+#include "mcwconstants.h"
+
+
+//==============================================================================
+// Dir Tree Walker Frame Class - One Per Dir On The Stack
+//==============================================================================
+class DirTreeWalkerFrame
+{
+public:
+    // Constructor
+    DirTreeWalkerFrame()
+        : dir(NULL)
+        , depth(0)
+        , device(0)
+        , inode(0)
+        , index(0)
+    {
+    }
+
+    // Dir - NULL If Closed By The fd Bound
+    DIR*                dir;
+    // Path
+    QByteArray          path;
+    // Path Prefix - Path With Trailing Separator
+    QByteArray          prefix;
+    // Name
+    QByteArray          name;
+    // Depth
+    int                 depth;
+    // Device
+    quint64             device;
+    // Inode
+    quint64             inode;
+    // Entry Names - Read Up Front So Closing The Dir Never Loses The Position
+    QList<QByteArray>   names;
+    // Entry Types - d_type
+    QVector<quint8>     types;
+    // Next Entry Index
+    int                 index;
+};
+
+//==============================================================================
+// Constructor
+//==============================================================================
+DirTreeWalkerEntry::DirTreeWalkerEntry()
+    : type(EDTWTFile)
+    , dirFd(-1)
+    , depth(0)
+    , mode(0)
+    , size(0)
+    , lastModified(0)
+    , isSymLink(false)
+{
+}
+
+//==============================================================================
+// Get File Path
+//==============================================================================
+QString DirTreeWalkerEntry::filePath() const
+{
+    return QFile::decodeName(path);
+}
+
+//==============================================================================
+// Get Parent Dir Path
+//==============================================================================
+QString DirTreeWalkerEntry::parentPath() const
+{
+    return QFile::decodeName(dirPath);
+}
+
+//==============================================================================
+// Get File Name
+//==============================================================================
+QString DirTreeWalkerEntry::fileName() const
+{
+    return QFile::decodeName(name);
+}
+
+//==============================================================================
+// Constructor
+//==============================================================================
+DirTreeWalker::DirTreeWalker(const QString& aRootPath, const int& aFlags, const bool& aAbort)
+    : rootPath(QFile::encodeName(aRootPath))
+    , flags(aFlags)
+    , abortFlag(aAbort)
+    , maxDepth(0)
+    , openFds(0)
+    , started(false)
+    , pendingDir(false)
+    , pendingDepth(0)
+{
+}
+
+//==============================================================================
+// Set Max Depth - Dirs At Max Depth Are Not Entered, 0 Means Unlimited
+//==============================================================================
+void DirTreeWalker::setMaxDepth(const int& aMaxDepth)
+{
+    // Set Max Depth
+    maxDepth = aMaxDepth;
+}
+
+//==============================================================================
+// Get Next Entry - Pre Order
+//==============================================================================
+bool DirTreeWalker::next(DirTreeWalkerEntry& aEntry)
+{
+    // Check Abort
+    if (abortFlag) {
+        return false;
+    }
+
+    // Init Push Result
+    int pushResult = EDTWTDir;
+
+    // Check Started
+    if (!started) {
+        // Set Started
+        started = true;
+        // Push Root Frame
+        pushResult = pushFrame(rootPath, 0, AT_FDCWD, rootPath);
+        // Set Pending Path For The Error Entry
+        pendingPath = pendingName = rootPath;
+        pendingDepth = 0;
+
+    // Check Pending Dir - Entered Only Now So The Caller Could Skip It
+    } else if (pendingDir) {
+        // Reset Pending Dir
+        pendingDir = false;
+        // Push Frame Relative To Its Parent
+        pushResult = pushFrame(pendingPath, pendingDepth, frameFd(stack.last()), pendingName);
+    }
+
+    // Check Push Result
+    if (pushResult != EDTWTDir) {
+        // Reset Entry
+        aEntry = DirTreeWalkerEntry();
+
+        // Setup Entry
+        aEntry.type     = (DirTreeWalkerEntryType)pushResult;
+        aEntry.path     = pendingPath;
+        aEntry.name     = pendingName;
+        aEntry.depth    = pendingDepth;
+        aEntry.dirFd    = stack.isEmpty() ? -1 : frameFd(stack.last());
+        aEntry.dirPath  = stack.isEmpty() ? QByteArray() : stack.last()->path;
+
+        return true;
+    }
+
+    // Go Thru Stack
+    while (!stack.isEmpty() && !abortFlag) {
+        // Get Top Frame
+        DirTreeWalkerFrame* frame = stack.last();
+
+        // Check Index - Dir Done
+        if (frame->index >= frame->names.count()) {
+            // Check Post Order - Root Is Not Reported
+            bool postOrder = (flags & EDTWFPostOrder) && frame->depth > 0;
+
+            // Check Post Order
+            if (postOrder) {
+                // Reset Entry
+                aEntry = DirTreeWalkerEntry();
+
+                // Setup Entry
+                aEntry.type     = EDTWTDirPost;
+                aEntry.path     = frame->path;
+                aEntry.name     = frame->name;
+                aEntry.depth    = frame->depth;
+            }
+
+            // Pop Frame
+            popFrame();
+
+            // Check Post Order
+            if (postOrder) {
+                // Set Parent Dir
+                aEntry.dirFd    = frameFd(stack.last());
+                aEntry.dirPath  = stack.last()->path;
+
+                return true;
+            }
+
+            continue;
+        }
+
+        // Get Index
+        int index = frame->index++;
+        // Get Dir Entry Type
+        quint8 dirType = frame->types[index];
+
+        // Reset Entry
+        aEntry = DirTreeWalkerEntry();
+
+        // Setup Entry
+        aEntry.name         = frame->names[index];
+        aEntry.path         = frame->prefix + aEntry.name;
+        aEntry.dirPath      = frame->path;
+        aEntry.dirFd        = frameFd(frame);
+        aEntry.depth        = frame->depth + 1;
+        aEntry.isSymLink    = dirType == DT_LNK;
+
+        // Init Is Dir - d_type Is Enough Most Of The Time
+        bool entryIsDir = dirType == DT_DIR;
+
+        // Check If Stat Needed - Asked For, Unknown Type Or Link To Follow
+        if ((flags & EDTWFStat) || dirType == DT_UNKNOWN || (aEntry.isSymLink && (flags & EDTWFFollowLinks))) {
+            // Init Stat
+            struct stat entryStat;
+
+            // Stat Entry Relative To Its Dir - Don't Follow Links
+            if (aEntry.dirFd >= 0 && fstatat(aEntry.dirFd, aEntry.name.constData(), &entryStat, AT_SYMLINK_NOFOLLOW) == 0) {
+                // Set Mode
+                aEntry.mode         = entryStat.st_mode;
+                // Set Size
+                aEntry.size         = entryStat.st_size;
+#if defined(Q_OS_MAC)
+                // Set Last Modified
+                aEntry.lastModified = (qint64)entryStat.st_mtimespec.tv_sec * 1000 + entryStat.st_mtimespec.tv_nsec / 1000000;
+#else // Q_OS_MAC
+                // Set Last Modified
+                aEntry.lastModified = (qint64)entryStat.st_mtim.tv_sec * 1000 + entryStat.st_mtim.tv_nsec / 1000000;
+#endif // Q_OS_MAC
+                // Set Is Link
+                aEntry.isSymLink    = S_ISLNK(entryStat.st_mode);
+                // Set Is Dir
+                entryIsDir          = S_ISDIR(entryStat.st_mode);
+
+                // Check Link To Follow
+                if (aEntry.isSymLink && (flags & EDTWFFollowLinks)) {
+                    // Init Target Stat
+                    struct stat targetStat;
+
+                    // Stat Link Target
+                    if (fstatat(aEntry.dirFd, aEntry.name.constData(), &targetStat, 0) == 0) {
+                        // Set Is Dir
+                        entryIsDir = S_ISDIR(targetStat.st_mode);
+                    }
+                }
+            }
+        }
+
+        // Check If Is Dir
+        if (entryIsDir) {
+            // Set Type
+            aEntry.type = EDTWTDir;
+
+            // Check Max Depth
+            if (maxDepth <= 0 || aEntry.depth < maxDepth) {
+                // Set Pending Dir
+                pendingDir      = true;
+                pendingPath     = aEntry.path;
+                pendingName     = aEntry.name;
+                pendingDepth    = aEntry.depth;
+            }
+        }
+
+        return true;
+    }
+
+    return false;
+}
+
+//==============================================================================
+// Skip Subtree Of The Last Returned Dir
+//==============================================================================
+void DirTreeWalker::skipSubtree()
+{
+    // Reset Pending Dir
+    pendingDir = false;
+}
+
+//==============================================================================
+// Push Dir Frame - Returns EDTWTDir On Success, EDTWTError Or EDTWTLoop
+//==============================================================================
+int DirTreeWalker::pushFrame(const QByteArray& aPath, const int& aDepth, const int& aParentFd, const QByteArray& aName)
+{
+    // Init Open Flags - Links Below The Root Are Only Entered When Following
+    int openFlags = O_RDONLY | O_DIRECTORY | O_CLOEXEC;
+
+    // Check Follow Links & Root - A Symlinked Root Is Always Entered, Like QDir Did
+    if (!(flags & EDTWFFollowLinks) && aParentFd != AT_FDCWD) {
+        // Adjust Open Flags
+        openFlags |= O_NOFOLLOW;
+    }
+
+    // Open Dir Relative To Its Parent - Root Is Relative To The Working Dir
+    int fd = openat(aParentFd, aParentFd == AT_FDCWD ? aPath.constData() : aName.constData(), openFlags);
+
+    // Check fd
+    if (fd < 0) {
+        return EDTWTError;
+    }
+
+    // Init Stat
+    struct stat dirStat;
+
+    // Stat Opened Dir
+    if (fstat(fd, &dirStat) != 0) {
+        // Close fd
+        close(fd);
+
+        return EDTWTError;
+    }
+
+    // Go Thru Stack - Same Device And Inode As An Ancestor Is A Loop
+    for (int i=0; i<stack.count(); ++i) {
+        // Check Device & Inode
+        if (stack[i]->device == (quint64)dirStat.st_dev && stack[i]->inode == (quint64)dirStat.st_ino) {
+            qDebug() << "DirTreeWalker::pushFrame - LOOP - aPath: " << aPath;
+
+            // Close fd
+            close(fd);
+
+            return EDTWTLoop;
+        }
+    }
+
+    // Open Dir Stream - Takes Over The fd
+    DIR* dir = fdopendir(fd);
+
+    // Check Dir
+    if (!dir) {
+        // Close fd
+        close(fd);
+
+        return EDTWTError;
+    }
+
+    // Create New Frame
+    DirTreeWalkerFrame* frame = new DirTreeWalkerFrame();
+
+    // Setup Frame
+    frame->dir      = dir;
+    frame->path     = aPath;
+    frame->prefix   = aPath.endsWith('/') ? aPath : aPath + '/';
+    frame->name     = aName;
+    frame->depth    = aDepth;
+    frame->device   = dirStat.st_dev;
+    frame->inode    = dirStat.st_ino;
+
+    // Init Dir Entry
+    struct dirent* dirEntry = NULL;
+
+    // Go Thru Dir Entries
+    while ((dirEntry = readdir(dir)) != NULL) {
+        // Get Name
+        const char* name = dirEntry->d_name;
+
+        // Check Dot, Dot Dot & Hidden
+        if (name[0] == '.' && (name[1] == '\0' || (name[1] == '.' && name[2] == '\0') || !(flags & EDTWFShowHidden))) {
+            continue;
+        }
+
+        // Add Name
+        frame->names << QByteArray(name);
+        // Add Type
+        frame->types << dirEntry->d_type;
+    }
+
+    // Push Frame
+    stack << frame;
+
+    // Inc Open fds
+    openFds++;
+
+    // Release fds Over The Bound
+    releaseFds();
+
+    return EDTWTDir;
+}
+
+//==============================================================================
+// Pop Dir Frame
+//==============================================================================
+void DirTreeWalker::popFrame()
+{
+    // Take Top Frame
+    DirTreeWalkerFrame* frame = stack.takeLast();
+
+    // Check Dir
+    if (frame->dir) {
+        // Close Dir
+        closedir(frame->dir);
+        // Dec Open fds
+        openFds--;
+    }
+
+    // Delete Frame
+    delete frame;
+}
+
+//==============================================================================
+// Get Frame Fd - Reopens Frames Closed By The fd Bound
+//==============================================================================
+int DirTreeWalker::frameFd(DirTreeWalkerFrame* aFrame)
+{
+    // Check Dir
+    if (!aFrame->dir) {
+        // Reopen By Path - Only Happens When Coming Back Up Past The Bound
+        aFrame->dir = opendir(aFrame->path.constData());
+
+        // Check Dir
+        if (!aFrame->dir) {
+            return -1;
+        }
+
+        // Inc Open fds
+        openFds++;
+
+        // Release fds Over The Bound
+        releaseFds();
+    }
+
+    return dirfd(aFrame->dir);
+}
+
+//==============================================================================
+// Release fds Over The Bound - Oldest Frames First
+//==============================================================================
+void DirTreeWalker::releaseFds()
+{
+    // Go Thru Stack - Top Frame Is Always Kept Open
+    for (int i=0; i<stack.count() - 1 && openFds > DEFAULT_TREE_WALKER_MAX_OPEN_FDS; ++i) {
+        // Check Dir
+        if (stack[i]->dir) {
+            // Close Dir - Names Are Already Read
+            closedir(stack[i]->dir);
+            // Reset Dir
+            stack[i]->dir = NULL;
+            // Dec Open fds
+            openFds--;
+        }
+    }
+}
+
+//==============================================================================
+// Destructor
+//==============================================================================
+DirTreeWalker::~DirTreeWalker()
+{
+    // Go Thru Stack
+    while (!stack.isEmpty()) {
+        // Pop Frame
+        popFrame();
+    }
+}
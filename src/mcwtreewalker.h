@@ -0,0 +1,129 @@
+#ifndef TREEWALKER_H
+#define TREEWALKER_H
+
+#include <QString>
+#include <QByteArray>
+#include <QList>
+#include <QVector>
+
+class DirTreeWalkerFrame;
+
+
+//==============================================================================
+// Dir Tree Walker Flags
+//==============================================================================
+enum DirTreeWalkerFlags
+{
+    EDTWFShowHidden     = 0x01,
+    EDTWFFollowLinks    = 0x02,
+    EDTWFStat           = 0x04,
+    EDTWFPostOrder      = 0x08
+};
+
+//==============================================================================
+// Dir Tree Walker Entry Type
+//==============================================================================
+enum DirTreeWalkerEntryType
+{
+    EDTWTFile           = 0,
+    EDTWTDir,
+    EDTWTDirPost,
+    EDTWTError,
+    EDTWTLoop
+};
+
+//==============================================================================
+// Dir Tree Walker Entry
+//==============================================================================
+class DirTreeWalkerEntry
+{
+public:
+    // Constructor
+    DirTreeWalkerEntry();
+
+    // Get File Path
+    QString filePath() const;
+    // Get Parent Dir Path
+    QString parentPath() const;
+    // Get File Name
+    QString fileName() const;
+
+    // Type
+    DirTreeWalkerEntryType  type;
+    // Name - Local 8 Bit
+    QByteArray              name;
+    // Path - Local 8 Bit
+    QByteArray              path;
+    // Parent Dir Path - Local 8 Bit
+    QByteArray              dirPath;
+    // Parent Dir Fd - Valid Until The Next Call To next()
+    int                     dirFd;
+    // Depth - Root Children Are At 1
+    int                     depth;
+    // Mode - Only Valid With EDTWFStat
+    quint32                 mode;
+    // Size - Only Valid With EDTWFStat
+    qint64                  size;
+    // Last Modified - Msecs Since Epoch, Only Valid With EDTWFStat
+    qint64                  lastModified;
+    // Is Link
+    bool                    isSymLink;
+};
+
+//==============================================================================
+// Dir Tree Walker Class - Iterative, fd Relative, Bounded Open fds
+//==============================================================================
+class DirTreeWalker
+{
+public:
+    // Constructor
+    DirTreeWalker(const QString& aRootPath, const int& aFlags, const bool& aAbort);
+
+    // Set Max Depth - Dirs At Max Depth Are Not Entered, 0 Means Unlimited
+    void setMaxDepth(const int& aMaxDepth);
+
+    // Get Next Entry - Pre Order
+    bool next(DirTreeWalkerEntry& aEntry);
+
+    // Skip Subtree Of The Last Returned Dir
+    void skipSubtree();
+
+    // Destructor
+    ~DirTreeWalker();
+
+private:
+    // Push Dir Frame - Returns EDTWTDir On Success, EDTWTError Or EDTWTLoop
+    int pushFrame(const QByteArray& aPath, const int& aDepth, const int& aParentFd, const QByteArray& aName);
+    // Pop Dir Frame
+    void popFrame();
+    // Get Frame Fd - Reopens Frames Closed By The fd Bound
+    int frameFd(DirTreeWalkerFrame* aFrame);
+    // Release fds Over The Bound - Oldest Frames First
+    void releaseFds();
+
+private:
+    // Root Path
+    QByteArray                      rootPath;
+    // Flags
+    int                             flags;
+    // Abort Flag
+    const bool&                     abortFlag;
+    // Max Depth
+    int                             maxDepth;
+    // Frame Stack
+    QList<DirTreeWalkerFrame*>      stack;
+    // Open fd Count
+    int                             openFds;
+    // Started
+    bool                            started;
+    // Pending Dir - Entered On The Next Call Unless Skipped
+    bool                            pendingDir;
+    // Pending Dir Path
+    QByteArray                      pendingPath;
+    // Pending Dir Name
+    QByteArray                      pendingName;
+    // Pending Dir Depth
+    int                             pendingDepth;
+};
+
+#endif // TREEWALKER_H
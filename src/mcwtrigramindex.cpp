@@ -0,0 +1,1206 @@
+#include <QDir>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QDateTime>
+#include <QCryptographicHash>
+#include <QStringList>
+#include <QVector>
+#include <QSet>
+#include <QMutexLocker>
+#include <QtAlgorithms>
+#include <QDebug>
+
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <string.h>
+#include <errno.h>
+
+#include "mcwtrigramindex.h"
+#include "mcwtreewalker.h"
+#include "mcwutility.h"
+#include "mcwarchivesearch.h"
+#include "mcwcontentclassifier.h"
+#include "mcwconstants.h"
+
+
+//==============================================================================
+// Index File Header
+//==============================================================================
+struct TrigramIndexFileHeader
+{
+    // Magic
+    quint32     magic;
+    // Version
+    quint32     version;
+    // File Count
+    quint32     fileCount;
+    // Trigram Count
+    quint32     trigramCount;
+    // Posting Count
+    quint64     postingCount;
+    // Name Pool Size
+    quint64     poolSize;
+    // Build Time - Msecs Since Epoch
+    qint64      buildTime;
+    // Root Path Length - Root Path Is At The Start Of The Name Pool
+    quint32     rootLength;
+    // Reserved
+    quint32     reserved;
+};
+
+//==============================================================================
+// Index File Record - Sorted By Relative Path
+//==============================================================================
+struct TrigramIndexFileRecord
+{
+    // Name Offset
+    quint32     nameOffset;
+    // Name Length
+    quint32     nameLength;
+    // Last Modified - Msecs Since Epoch
+    qint64      lastModified;
+    // Size
+    qint64      size;
+    // Flags
+    quint32     flags;
+    // Reserved
+    quint32     reserved;
+};
+
+//==============================================================================
+// Index File Trigram - Sorted By Trigram
+//==============================================================================
+struct TrigramIndexFileTrigram
+{
+    // Trigram
+    quint32     trigram;
+    // Posting Count
+    quint32     count;
+    // First Posting Index
+    quint64     firstPosting;
+};
+
+//==============================================================================
+// Index File Record Flags
+//==============================================================================
+enum TrigramIndexRecordFlags
+{
+    ETIRFUnindexed      = 0x01
+};
+
+//==============================================================================
+// Build File - Collected While Walking
+//==============================================================================
+struct TrigramIndexBuildFile
+{
+    // Relative Path
+    QByteArray  path;
+    // Last Modified
+    qint64      lastModified;
+    // Size
+    qint64      size;
+    // Flags
+    quint32     flags;
+    // Build ID - Walk Order
+    quint32     buildID;
+};
+
+//==============================================================================
+// Get Mapped Header
+//==============================================================================
+static inline const TrigramIndexFileHeader* tiHeader(const uchar* aData)
+{
+    return reinterpret_cast<const TrigramIndexFileHeader*>(aData);
+}
+
+//==============================================================================
+// Get Mapped Records
+//==============================================================================
+static inline const TrigramIndexFileRecord* tiRecords(const uchar* aData)
+{
+    return reinterpret_cast<const TrigramIndexFileRecord*>(aData + sizeof(TrigramIndexFileHeader));
+}
+
+//==============================================================================
+// Get Mapped Trigrams
+//==============================================================================
+static inline const TrigramIndexFileTrigram* tiTrigrams(const uchar* aData)
+{
+    return reinterpret_cast<const TrigramIndexFileTrigram*>(tiRecords(aData) + tiHeader(aData)->fileCount);
+}
+
+//==============================================================================
+// Get Mapped Postings
+//==============================================================================
+static inline const quint32* tiPostings(const uchar* aData)
+{
+    return reinterpret_cast<const quint32*>(tiTrigrams(aData) + tiHeader(aData)->trigramCount);
+}
+
+//==============================================================================
+// Get Mapped Name Pool
+//==============================================================================
+static inline const char* tiPool(const uchar* aData)
+{
+    return reinterpret_cast<const char*>(tiPostings(aData) + tiHeader(aData)->postingCount);
+}
+
+//==============================================================================
+// Fold ASCII Byte - Same Folding As The Content Matcher
+//==============================================================================
+static inline uchar tiFold(const uchar& aByte)
+{
+    return (aByte >= 'A' && aByte <= 'Z') ? aByte | 0x20 : aByte;
+}
+
+//==============================================================================
+// Get Dir Prefix
+//==============================================================================
+static inline QString tiDirPrefix(const QString& aDirPath)
+{
+    return aDirPath.endsWith("/") ? aDirPath : aDirPath + "/";
+}
+
+//==============================================================================
+// Get Last Modified - Msecs Since Epoch
+//==============================================================================
+static inline qint64 tiLastModified(const struct stat& aStat)
+{
+#if defined(Q_OS_MAC)
+    return (qint64)aStat.st_mtimespec.tv_sec * 1000 + aStat.st_mtimespec.tv_nsec / 1000000;
+#else // Q_OS_MAC
+    return (qint64)aStat.st_mtim.tv_sec * 1000 + aStat.st_mtim.tv_nsec / 1000000;
+#endif // Q_OS_MAC
+}
+
+//==============================================================================
+// Compare Relative Path With Mapped Name
+//==============================================================================
+static inline int tiComparePath(const char* aName, const quint32& aNameLength, const QByteArray& aPath)
+{
+    // Compare Common Part
+    int cmp = memcmp(aName, aPath.constData(), qMin(aNameLength, (quint32)aPath.size()));
+
+    // Check Result
+    if (cmp != 0)
+        return cmp;
+
+    return aNameLength < (quint32)aPath.size() ? -1 : aNameLength > (quint32)aPath.size() ? 1 : 0;
+}
+
+//==============================================================================
+// Build File Less Than
+//==============================================================================
+static bool buildFileLessThan(const TrigramIndexBuildFile& a, const TrigramIndexBuildFile& b)
+{
+    return a.path < b.path;
+}
+
+//==============================================================================
+// Trigram Posting Count Less Than
+//==============================================================================
+static bool trigramCountLessThan(const TrigramIndexFileTrigram* a, const TrigramIndexFileTrigram* b)
+{
+    return a->count < b->count;
+}
+
+//==============================================================================
+// Read File Trigrams - Fails If Unreadable, Compressed Or Too Many Distinct Trigrams
+//==============================================================================
+static bool readFileTrigrams(const int& aDirFd, const QByteArray& aName, QByteArray& aSeen, QVector<quint32>& aTrigrams, QByteArray& aBuffer)
+{
+    // Clear Trigrams
+    aTrigrams.clear();
+
+    // Open File Relative To Its Dir
+    int fd = openat(aDirFd, aName.constData(), O_RDONLY | O_CLOEXEC | O_NOFOLLOW);
+
+    // Check fd
+    if (fd < 0) {
+        return false;
+    }
+
+    // Check Compressed - Searched Decompressed, Raw Trigrams Would Prune It
+    if (!ArchiveSearch::decompressorFor(fd).isEmpty()) {
+        // Close fd
+        close(fd);
+
+        return false;
+    }
+
+    // Get Seen Bits
+    uchar* seen = reinterpret_cast<uchar*>(aSeen.data());
+    // Get Buffer Data
+    char* data = aBuffer.data();
+
+    // Init Head Size
+    ssize_t headSize = -1;
+
+    // Read File Head - File Offset Is Left Alone
+    do {
+        headSize = pread(fd, data, qMin(aBuffer.size(), DEFAULT_CONTENT_SNIFF_SIZE), 0);
+    } while (headSize < 0 && errno == EINTR);
+
+    // Init Encoding
+    ContentEncoding encoding = ECEUTF8;
+
+    // Check UTF-16 - Searched Transcoded To UTF-8, Raw Trigrams Would Prune It
+    if (headSize > 0 && ContentClassifier::sniff(data, headSize, headSize < DEFAULT_CONTENT_SNIFF_SIZE, &encoding) == ECSRText && encoding != ECEUTF8) {
+        // Close fd
+        close(fd);
+
+        return false;
+    }
+
+    // Init Trigram
+    quint32 trigram = 0;
+    // Init Byte Count
+    qint64 byteCount = 0;
+    // Init Result
+    bool result = true;
+
+    // Read Chunks
+    forever {
+        // Read
+        ssize_t bytesRead = read(fd, data, aBuffer.size());
+
+        // Check Bytes Read
+        if (bytesRead < 0) {
+            // Check Interrupted
+            if (errno == EINTR) {
+                continue;
+            }
+
+            // Set Result
+            result = false;
+
+            break;
+        }
+
+        // Check End Of File
+        if (bytesRead == 0) {
+            break;
+        }
+
+        // Go Thru Bytes
+        for (ssize_t i=0; i<bytesRead; ++i) {
+            // Shift In Folded Byte
+            trigram = ((trigram << 8) | tiFold((uchar)data[i])) & 0xFFFFFF;
+
+            // Check First Two Bytes
+            if (++byteCount < 3) {
+                continue;
+            }
+
+            // Check Seen
+            if (!(seen[trigram >> 3] & (1 << (trigram & 7)))) {
+                // Set Seen
+                seen[trigram >> 3] |= (1 << (trigram & 7));
+                // Add Trigram
+                aTrigrams << trigram;
+            }
+        }
+
+        // Check Trigram Count - Binary & Noisy Files Give No Pruning
+        if (aTrigrams.count() > DEFAULT_TRIGRAM_INDEX_MAX_FILE_TRIGRAMS) {
+            // Set Result
+            result = false;
+
+            break;
+        }
+    }
+
+    // Close fd
+    close(fd);
+
+    // Go Thru Trigrams
+    for (int i=0; i<aTrigrams.count(); ++i) {
+        // Clear Seen
+        seen[aTrigrams[i] >> 3] &= ~(1 << (aTrigrams[i] & 7));
+    }
+
+    return result;
+}
+
+//==============================================================================
+// Build Index File - Returns false On Abort Or Write Error
+//==============================================================================
+bool TrigramIndex::build(const QString& aRootPath, const QString& aFilePath, const bool& aAbort, QList<QByteArray>& aDirs)
+{
+    // Get Build Time
+    qint64 buildTime = QDateTime::currentMSecsSinceEpoch();
+    // Get Root Path
+    QByteArray rootPath = QFile::encodeName(aRootPath);
+    // Get Root Prefix
+    QByteArray rootPrefix = rootPath.endsWith('/') ? rootPath : rootPath + '/';
+    // Get Cache Dir - Skipped, Index Saves Would Trigger Rebuilds
+    QByteArray cacheDir = QFile::encodeName(getCacheDir());
+
+    // Init Files
+    QList<TrigramIndexBuildFile> files;
+    // Init Postings - Trigram In The High, Build ID In The Low Half
+    QVector<quint64> pairs;
+    // Init File Trigrams
+    QVector<quint32> fileTrigrams;
+    // Init Seen Bits - One Per Possible Trigram
+    QByteArray seen((1 << 24) / 8, '\0');
+    // Init Read Buffer
+    QByteArray buffer(DEFAULT_TRIGRAM_INDEX_READ_SIZE, '\0');
+
+    // Add Root Dir
+    aDirs << rootPath;
+
+    // Init Walker
+    DirTreeWalker walker(aRootPath, EDTWFShowHidden | EDTWFStat, aAbort);
+    // Init Entry
+    DirTreeWalkerEntry entry;
+
+    // Go Thru Entries
+    while (walker.next(entry)) {
+        // Check Root Error
+        if (entry.type == EDTWTError && entry.depth == 0) {
+            qWarning() << "TrigramIndex::build - aRootPath: " << aRootPath << " - CAN NOT OPEN ROOT!";
+            return false;
+        }
+
+        // Check Dir
+        if (entry.type == EDTWTDir) {
+            // Check Cache Dir
+            if (entry.path == cacheDir) {
+                // Skip Subtree
+                walker.skipSubtree();
+            } else {
+                // Add Dir
+                aDirs << entry.path;
+            }
+
+            continue;
+        }
+
+        // Check Regular File - Links Are Searched Thru Their Targets, Not Indexed
+        if (entry.type != EDTWTFile || !S_ISREG(entry.mode)) {
+            continue;
+        }
+
+        // Init Build File
+        TrigramIndexBuildFile file;
+
+        // Setup Build File
+        file.path           = entry.path.mid(rootPrefix.length());
+        file.lastModified   = entry.lastModified;
+        file.size           = entry.size;
+        file.flags          = 0;
+        file.buildID        = files.count();
+
+        // Check Size, Modified Too Recently & Postings Budget
+        if (entry.size > DEFAULT_TRIGRAM_INDEX_MAX_FILE_SIZE ||
+            buildTime - entry.lastModified < DEFAULT_TRIGRAM_INDEX_RACY_MS ||
+            pairs.count() >= DEFAULT_TRIGRAM_INDEX_MAX_POSTINGS ||
+            !readFileTrigrams(entry.dirFd, entry.name, seen, fileTrigrams, buffer)) {
+            // Set Unindexed - Always A Candidate
+            file.flags = ETIRFUnindexed;
+        } else {
+            // Go Thru File Trigrams
+            for (int i=0; i<fileTrigrams.count(); ++i) {
+                // Add Posting
+                pairs << (((quint64)fileTrigrams[i] << 32) | file.buildID);
+            }
+        }
+
+        // Add Build File
+        files << file;
+    }
+
+    // Check Abort
+    if (aAbort) {
+        return false;
+    }
+
+    // Sort Files By Path
+    qSort(files.begin(), files.end(), buildFileLessThan);
+
+    // Init File IDs - Build ID To Sorted Index
+    QVector<quint32> fileIDs(files.count());
+
+    // Init Buffers
+    QByteArray records;
+    QByteArray pool;
+
+    // Add Root Path To Pool
+    pool.append(rootPath);
+
+    // Go Thru Files
+    for (int i=0; i<files.count(); ++i) {
+        // Set File ID
+        fileIDs[files[i].buildID] = i;
+
+        // Init Record
+        TrigramIndexFileRecord record;
+        // Setup Record
+        record.nameOffset   = pool.size();
+        record.nameLength   = files[i].path.size();
+        record.lastModified = files[i].lastModified;
+        record.size         = files[i].size;
+        record.flags        = files[i].flags;
+        record.reserved     = 0;
+
+        // Add Name
+        pool.append(files[i].path);
+        // Add Record
+        records.append(reinterpret_cast<const char*>(&record), sizeof(record));
+    }
+
+    // Go Thru Postings
+    for (int i=0; i<pairs.count(); ++i) {
+        // Remap Build ID To File ID
+        pairs[i] = (pairs[i] & Q_UINT64_C(0xFFFFFFFF00000000)) | fileIDs[(quint32)pairs[i]];
+    }
+
+    // Sort Postings - By Trigram, Then By File ID
+    qSort(pairs.begin(), pairs.end());
+
+    // Init Trigram Table
+    QByteArray trigrams;
+    // Init Posting List
+    QVector<quint32> postings(pairs.count());
+
+    // Go Thru Postings
+    for (int i=0; i<pairs.count(); ++i) {
+        // Get Trigram
+        quint32 trigram = pairs[i] >> 32;
+
+        // Check New Trigram
+        if (i == 0 || (pairs[i - 1] >> 32) != trigram) {
+            // Init Trigram Entry
+            TrigramIndexFileTrigram trigramEntry;
+            // Setup Trigram Entry
+            trigramEntry.trigram        = trigram;
+            trigramEntry.count          = 0;
+            trigramEntry.firstPosting   = i;
+            // Add Trigram Entry
+            trigrams.append(reinterpret_cast<const char*>(&trigramEntry), sizeof(trigramEntry));
+        }
+
+        // Inc Posting Count Of The Last Trigram Entry
+        reinterpret_cast<TrigramIndexFileTrigram*>(trigrams.data() + trigrams.size() - sizeof(TrigramIndexFileTrigram))->count++;
+
+        // Set Posting
+        postings[i] = (quint32)pairs[i];
+    }
+
+    // Clear Pairs
+    pairs.clear();
+
+    // Init Header
+    TrigramIndexFileHeader header;
+    // Setup Header
+    header.magic        = DEFAULT_TRIGRAM_INDEX_MAGIC;
+    header.version      = DEFAULT_TRIGRAM_INDEX_VERSION;
+    header.fileCount    = files.count();
+    header.trigramCount = trigrams.size() / sizeof(TrigramIndexFileTrigram);
+    header.postingCount = postings.count();
+    header.poolSize     = pool.size();
+    header.buildTime    = buildTime;
+    header.rootLength   = rootPath.size();
+    header.reserved     = 0;
+
+    // Init Save File
+    QSaveFile saveFile(aFilePath);
+
+    // Open Save File
+    if (!saveFile.open(QIODevice::WriteOnly)) {
+        qWarning() << "TrigramIndex::build - aFilePath: " << aFilePath << " - CAN NOT OPEN FILE!";
+        return false;
+    }
+
+    // Write Data
+    saveFile.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    saveFile.write(records);
+    saveFile.write(trigrams);
+    saveFile.write(reinterpret_cast<const char*>(postings.constData()), postings.count() * sizeof(quint32));
+    saveFile.write(pool);
+
+    // Commit
+    if (!saveFile.commit()) {
+        qWarning() << "TrigramIndex::build - aFilePath: " << aFilePath << " - COMMIT FAILED!";
+        return false;
+    }
+
+    qDebug() << "TrigramIndex::build - aRootPath: " << aRootPath << " - fileCount: " << header.fileCount << " - trigramCount: " << header.trigramCount << " - postingCount: " << header.postingCount;
+
+    return true;
+}
+
+//==============================================================================
+// Constructor - Maps An Index File
+//==============================================================================
+TrigramIndex::TrigramIndex(const QString& aFilePath)
+    : indexFile(aFilePath)
+    , mappedData(NULL)
+    , mappedSize(0)
+{
+    // Open Index File
+    if (!indexFile.open(QIODevice::ReadOnly)) {
+        return;
+    }
+
+    // Get Size
+    qint64 fileSize = indexFile.size();
+
+    // Check Size
+    if (fileSize < (qint64)sizeof(TrigramIndexFileHeader)) {
+        // Close Index File
+        indexFile.close();
+        return;
+    }
+
+    // Map File
+    mappedData = indexFile.map(0, fileSize);
+
+    // Check Mapped Data
+    if (!mappedData) {
+        // Close Index File
+        indexFile.close();
+        return;
+    }
+
+    // Set Mapped Size
+    mappedSize = fileSize;
+
+    // Get Header
+    const TrigramIndexFileHeader* header = tiHeader(mappedData);
+
+    // Get Expected Size
+    qint64 expectedSize = sizeof(TrigramIndexFileHeader)
+                        + (qint64)header->fileCount * sizeof(TrigramIndexFileRecord)
+                        + (qint64)header->trigramCount * sizeof(TrigramIndexFileTrigram)
+                        + (qint64)header->postingCount * sizeof(quint32)
+                        + (qint64)header->poolSize;
+
+    // Check Header
+    bool valid = header->magic == DEFAULT_TRIGRAM_INDEX_MAGIC && header->version == DEFAULT_TRIGRAM_INDEX_VERSION && expectedSize == mappedSize && header->rootLength <= header->poolSize;
+
+    // Go Thru Records
+    for (quint32 i=0; i<header->fileCount && valid; ++i) {
+        // Check Name Bounds
+        valid = (quint64)tiRecords(mappedData)[i].nameOffset + tiRecords(mappedData)[i].nameLength <= header->poolSize;
+    }
+
+    // Go Thru Trigrams
+    for (quint32 i=0; i<header->trigramCount && valid; ++i) {
+        // Check Posting Bounds
+        valid = tiTrigrams(mappedData)[i].firstPosting + tiTrigrams(mappedData)[i].count <= header->postingCount;
+    }
+
+    // Check Valid
+    if (!valid) {
+        qWarning() << "TrigramIndex::TrigramIndex - aFilePath: " << aFilePath << " - INVALID INDEX FILE!";
+        // Unmap Index File
+        unmapIndexFile();
+        return;
+    }
+
+    // Set Root Path
+    root = QFile::decodeName(QByteArray(tiPool(mappedData), header->rootLength));
+}
+
+//==============================================================================
+// Is Valid
+//==============================================================================
+bool TrigramIndex::isValid() const
+{
+    return mappedData != NULL;
+}
+
+//==============================================================================
+// Get Root Path
+//==============================================================================
+QString TrigramIndex::rootPath() const
+{
+    return root;
+}
+
+//==============================================================================
+// Get Build Time - Msecs Since Epoch
+//==============================================================================
+qint64 TrigramIndex::buildTime() const
+{
+    return mappedData ? tiHeader(mappedData)->buildTime : 0;
+}
+
+//==============================================================================
+// Get File Count
+//==============================================================================
+int TrigramIndex::fileCount() const
+{
+    return mappedData ? tiHeader(mappedData)->fileCount : 0;
+}
+
+//==============================================================================
+// Find File - Binary Search By Relative Path
+//==============================================================================
+int TrigramIndex::findFile(const QByteArray& aRelativePath) const
+{
+    // Get Records
+    const TrigramIndexFileRecord* records = mappedData ? tiRecords(mappedData) : NULL;
+    // Get Name Pool
+    const char* pool = mappedData ? tiPool(mappedData) : NULL;
+
+    // Init Bounds
+    int left  = 0;
+    int right = fileCount() - 1;
+
+    // Search
+    while (left <= right) {
+        // Get Middle
+        int middle = (left + right) / 2;
+        // Compare Paths
+        int cmp = tiComparePath(pool + records[middle].nameOffset, records[middle].nameLength, aRelativePath);
+
+        // Check Result
+        if (cmp == 0)
+            return middle;
+
+        // Adjust Bounds
+        if (cmp < 0)
+            left = middle + 1;
+        else
+            right = middle - 1;
+    }
+
+    return -1;
+}
+
+//==============================================================================
+// Check File - Gets The State And Index Of A File By Path Relative To The Root
+//==============================================================================
+TrigramIndexFileState TrigramIndex::checkFile(const QByteArray& aRelativePath, const qint64& aLastModified, const qint64& aSize, int& aIndex) const
+{
+    // Find File
+    aIndex = findFile(aRelativePath);
+
+    // Check Index - Added Since The Build
+    if (aIndex < 0) {
+        return ETIFSUnknown;
+    }
+
+    // Get Record
+    const TrigramIndexFileRecord& record = tiRecords(mappedData)[aIndex];
+
+    // Check Last Modified & Size
+    if (record.lastModified != aLastModified || record.size != aSize) {
+        return ETIFSStale;
+    }
+
+    // Check Unindexed
+    if (record.flags & ETIRFUnindexed) {
+        return ETIFSUnknown;
+    }
+
+    return ETIFSIndexed;
+}
+
+//==============================================================================
+// Get Candidates - Files Having All Trigrams Of The Pattern, false If The Pattern Is Too Short
+//==============================================================================
+bool TrigramIndex::candidates(const QByteArray& aPattern, QBitArray& aCandidates) const
+{
+    // Get Pattern Length
+    int pLength = aPattern.length();
+
+    // Check Index & Pattern Length
+    if (!mappedData || pLength < 3) {
+        return false;
+    }
+
+    // Init Pattern Trigrams
+    QVector<quint32> patternTrigrams;
+
+    // Go Thru Pattern
+    for (int i=0; i<=pLength - 3; ++i) {
+        // Add Folded Trigram
+        patternTrigrams << (((quint32)tiFold((uchar)aPattern[i]) << 16) | ((quint32)tiFold((uchar)aPattern[i + 1]) << 8) | tiFold((uchar)aPattern[i + 2]));
+    }
+
+    // Sort Pattern Trigrams
+    qSort(patternTrigrams.begin(), patternTrigrams.end());
+
+    // Get Trigram Table
+    const TrigramIndexFileTrigram* table = tiTrigrams(mappedData);
+    // Get Trigram Count
+    int tCount = tiHeader(mappedData)->trigramCount;
+
+    // Init Posting Lists
+    QList<const TrigramIndexFileTrigram*> lists;
+
+    // Init Candidates - None
+    aCandidates = QBitArray(fileCount());
+
+    // Go Thru Pattern Trigrams
+    for (int i=0; i<patternTrigrams.count(); ++i) {
+        // Check Duplicate
+        if (i > 0 && patternTrigrams[i] == patternTrigrams[i - 1]) {
+            continue;
+        }
+
+        // Init Bounds
+        int left  = 0;
+        int right = tCount - 1;
+        // Init Found
+        const TrigramIndexFileTrigram* found = NULL;
+
+        // Search
+        while (left <= right && !found) {
+            // Get Middle
+            int middle = (left + right) / 2;
+
+            // Check Trigram
+            if (table[middle].trigram == patternTrigrams[i])
+                found = &table[middle];
+            else if (table[middle].trigram < patternTrigrams[i])
+                left = middle + 1;
+            else
+                right = middle - 1;
+        }
+
+        // Check Found - No Indexed File Has This Trigram
+        if (!found) {
+            return true;
+        }
+
+        // Add Posting List
+        lists << found;
+    }
+
+    // Sort Posting Lists - Shortest First
+    qSort(lists.begin(), lists.end(), trigramCountLessThan);
+
+    // Get Postings
+    const quint32* postings = tiPostings(mappedData);
+
+    // Init Result From The Shortest List
+    QVector<quint32> result;
+    // Reserve
+    result.reserve(lists[0]->count);
+
+    // Go Thru Shortest List
+    for (quint32 i=0; i<lists[0]->count; ++i) {
+        // Add File ID
+        result << postings[lists[0]->firstPosting + i];
+    }
+
+    // Go Thru Other Lists
+    for (int l=1; l<lists.count() && !result.isEmpty(); ++l) {
+        // Get List
+        const quint32* list = postings + lists[l]->firstPosting;
+        // Get List Count
+        quint32 lCount = lists[l]->count;
+
+        // Init Indexes
+        int r = 0;
+        quint32 p = 0;
+        // Init Output Index
+        int o = 0;
+
+        // Intersect - Both Sorted
+        while (r < result.count() && p < lCount) {
+            // Compare File IDs
+            if (result[r] < list[p]) {
+                r++;
+            } else if (result[r] > list[p]) {
+                p++;
+            } else {
+                // Keep File ID
+                result[o++] = result[r];
+                r++;
+                p++;
+            }
+        }
+
+        // Truncate Result
+        result.resize(o);
+    }
+
+    // Go Thru Result
+    for (int i=0; i<result.count(); ++i) {
+        // Set Candidate
+        aCandidates.setBit(result[i]);
+    }
+
+    return true;
+}
+
+//==============================================================================
+// Unmap Index File
+//==============================================================================
+void TrigramIndex::unmapIndexFile()
+{
+    // Check Mapped Data
+    if (mappedData) {
+        // Unmap
+        indexFile.unmap(mappedData);
+        // Reset Mapped Data
+        mappedData = NULL;
+    }
+
+    // Close Index File
+    indexFile.close();
+
+    // Reset Mapped Size
+    mappedSize = 0;
+}
+
+//==============================================================================
+// Destructor
+//==============================================================================
+TrigramIndex::~TrigramIndex()
+{
+    // Unmap Index File
+    unmapIndexFile();
+}
+
+
+
+
+//==============================================================================
+// Constructor - Inactive If The Dir Is Not Indexed Or The Pattern Is Too Short
+//==============================================================================
+TrigramIndexFilter::TrigramIndexFilter(const QString& aDirPath, const QByteArray& aPattern)
+    : staleCount(0)
+{
+    // Check Pattern Length
+    if (aPattern.length() < 3) {
+        return;
+    }
+
+    // Get Index
+    index = TrigramIndexer::instance()->indexFor(aDirPath);
+
+    // Check Index & Get Candidates
+    if (index.isNull() || !index->candidates(aPattern, candidateFiles)) {
+        // Clear Index
+        index.clear();
+        return;
+    }
+
+    // Set Walker Prefix - Walker Paths Start With The Dir Path As Given
+    walkerPrefix = QFile::encodeName(tiDirPrefix(aDirPath));
+
+    // Get Clean Dir Path
+    QString dirPath = QDir::cleanPath(aDirPath);
+
+    // Set Relative Prefix
+    relativePrefix = dirPath == index->rootPath() ? QByteArray() : QFile::encodeName(tiDirPrefix(dirPath.mid(tiDirPrefix(index->rootPath()).length())));
+
+    qDebug() << "TrigramIndexFilter::TrigramIndexFilter - aDirPath: " << aDirPath << " - root: " << index->rootPath();
+}
+
+//==============================================================================
+// Is Active - Walker Entries Need Stat When Active
+//==============================================================================
+bool TrigramIndexFilter::isActive() const
+{
+    return !index.isNull();
+}
+
+//==============================================================================
+// May Contain - false Only If The Index Rules The File Out
+//==============================================================================
+bool TrigramIndexFilter::mayContain(const DirTreeWalkerEntry& aEntry)
+{
+    // Check Index & Path
+    if (index.isNull() || !aEntry.path.startsWith(walkerPrefix)) {
+        return true;
+    }
+
+    // Init File Index
+    int fileIndex = -1;
+
+    // Check File
+    switch (index->checkFile(relativePrefix + aEntry.path.mid(walkerPrefix.length()), aEntry.lastModified, aEntry.size, fileIndex)) {
+        case ETIFSIndexed:  return candidateFiles.testBit(fileIndex);
+        case ETIFSStale:    staleCount++;   return true;
+
+        default:
+        break;
+    }
+
+    return true;
+}
+
+//==============================================================================
+// Destructor - Reports Stale Files To The Indexer
+//==============================================================================
+TrigramIndexFilter::~TrigramIndexFilter()
+{
+    // Check Stale Count
+    if (!index.isNull() && staleCount > 0) {
+        qDebug() << "TrigramIndexFilter::~TrigramIndexFilter - root: " << index->rootPath() << " - staleCount: " << staleCount;
+
+        // Mark Dirty
+        TrigramIndexer::instance()->markDirty(index->rootPath());
+    }
+}
+
+
+
+
+//==============================================================================
+// Constructor
+//==============================================================================
+TrigramIndexer::TrigramIndexer()
+{
+    // Make Index Dir
+    QDir().mkpath(getCacheDir() + "/" + DEFAULT_TRIGRAM_INDEX_DIR_NAME);
+
+    // Add Client - Indexes Are Loaded & Rebuilt On The Watcher Thread
+    IndexWatcher::instance()->addClient(this);
+}
+
+//==============================================================================
+// Get Instance
+//==============================================================================
+TrigramIndexer* TrigramIndexer::instance()
+{
+    // Init Instance
+    static TrigramIndexer indexerInstance;
+
+    return &indexerInstance;
+}
+
+//==============================================================================
+// Get Index File Path
+//==============================================================================
+QString TrigramIndexer::indexFilePath(const QString& aRootPath)
+{
+    // Get Root Hash
+    QString rootHash = QString::fromLatin1(QCryptographicHash::hash(QFile::encodeName(aRootPath), QCryptographicHash::Sha1).toHex().constData());
+
+    return getCacheDir() + "/" + DEFAULT_TRIGRAM_INDEX_DIR_NAME + "/" + rootHash + DEFAULT_TRIGRAM_INDEX_FILE_SUFFIX;
+}
+
+//==============================================================================
+// Add Root - Nested Roots Are Merged Into The Outermost One
+//==============================================================================
+void TrigramIndexer::addRoot(const QString& aRootPath)
+{
+    // Add Root
+    IndexWatcher::instance()->addRoot(this, aRootPath);
+}
+
+//==============================================================================
+// Remove Root
+//==============================================================================
+void TrigramIndexer::removeRoot(const QString& aRootPath)
+{
+    // Remove Root
+    IndexWatcher::instance()->removeRoot(this, aRootPath);
+}
+
+//==============================================================================
+// Get Index For Dir - NULL If The Dir Is Not Under An Indexed Root
+//==============================================================================
+QSharedPointer<TrigramIndex> TrigramIndexer::indexFor(const QString& aDirPath)
+{
+    // Init Stale - Stale Files Are Caught By Their mtime & Size
+    bool stale = false;
+    // Find Root
+    QString rootPath = IndexWatcher::instance()->findRoot(this, aDirPath, stale);
+
+    // Check Root Path
+    if (rootPath.isEmpty()) {
+        return QSharedPointer<TrigramIndex>();
+    }
+
+    // Init Locker
+    QMutexLocker locker(&mutex);
+
+    return indexes.value(rootPath);
+}
+
+//==============================================================================
+// Mark Dirty - Schedules A Rebuild
+//==============================================================================
+void TrigramIndexer::markDirty(const QString& aRootPath)
+{
+    // Mark Changed
+    IndexWatcher::instance()->markChanged(this, aRootPath);
+}
+
+//==============================================================================
+// Watches File Writes - Contents Change Without Entries Changing
+//==============================================================================
+bool TrigramIndexer::watchesFileWrites() const
+{
+    return true;
+}
+
+//==============================================================================
+// Get Refresh Delay
+//==============================================================================
+qint64 TrigramIndexer::refreshDelay() const
+{
+    return DEFAULT_TRIGRAM_INDEX_REBUILD_DELAY_MS;
+}
+
+//==============================================================================
+// Get Time To Live
+//==============================================================================
+qint64 TrigramIndexer::timeToLive() const
+{
+    return (qint64)DEFAULT_TRIGRAM_INDEX_TTL_SECS * 1000;
+}
+
+//==============================================================================
+// Load Indexes - Existing Index Files
+//==============================================================================
+void TrigramIndexer::loadIndexes(const bool& aAbort)
+{
+    // Get Index Dir Path
+    QString indexDirPath = getCacheDir() + "/" + DEFAULT_TRIGRAM_INDEX_DIR_NAME;
+    // Get Index Files
+    QStringList indexFiles = QDir(indexDirPath).entryList(QStringList() << QString("*") + DEFAULT_TRIGRAM_INDEX_FILE_SUFFIX, QDir::Files);
+
+    // Go Thru Index Files
+    for (int i=0; i<indexFiles.count() && !aAbort; ++i) {
+        // Get Index File Path
+        QString filePath = indexDirPath + "/" + indexFiles[i];
+        // Init Index
+        QSharedPointer<TrigramIndex> index(new TrigramIndex(filePath));
+
+        // Check Index - Invalid Indexes & Indexes Of Gone Roots Are Dropped
+        if (!index->isValid() || indexFilePath(index->rootPath()) != filePath || !QFileInfo(index->rootPath()).isDir()) {
+            qDebug() << "TrigramIndexer::loadIndexes - filePath: " << filePath << " - DROPPED";
+            // Clear Index
+            index.clear();
+            // Remove Index File
+            QFile::remove(filePath);
+            continue;
+        }
+
+        // Get Root Path
+        QString rootPath = index->rootPath();
+        // Init Dirs
+        QList<QByteArray> dirs;
+
+        // Collect Dirs - Changes While Not Running Show Up In Dir mtimes
+        bool changed = collectDirs(rootPath, index->buildTime() - DEFAULT_TRIGRAM_INDEX_RACY_MS, aAbort, dirs);
+
+        qDebug() << "TrigramIndexer::loadIndexes - rootPath: " << rootPath << " - changed: " << changed;
+
+        // Load Root - Expired Indexes Are Rebuilt By The Watcher
+        if (IndexWatcher::instance()->loadRoot(this, rootPath, index->buildTime(), changed, dirs)) {
+            // Init Locker
+            QMutexLocker locker(&mutex);
+            // Set Index
+            indexes[rootPath] = index;
+        }
+    }
+}
+
+//==============================================================================
+// Collect Dirs - Returns true If Any Dir Changed Since aSince
+//==============================================================================
+bool TrigramIndexer::collectDirs(const QString& aRootPath, const qint64& aSince, const bool& aAbort, QList<QByteArray>& aDirs)
+{
+    // Get Cache Dir
+    QByteArray cacheDir = QFile::encodeName(getCacheDir());
+    // Init Stat
+    struct stat dirStat;
+    // Init Changed
+    bool changed = stat(QFile::encodeName(aRootPath).constData(), &dirStat) != 0 || tiLastModified(dirStat) > aSince;
+
+    // Add Root Dir
+    aDirs << QFile::encodeName(aRootPath);
+
+    // Init Walker
+    DirTreeWalker walker(aRootPath, EDTWFShowHidden, aAbort);
+    // Init Entry
+    DirTreeWalkerEntry entry;
+
+    // Go Thru Entries
+    while (walker.next(entry)) {
+        // Check Dir
+        if (entry.type != EDTWTDir) {
+            continue;
+        }
+
+        // Check Cache Dir
+        if (entry.path == cacheDir) {
+            // Skip Subtree
+            walker.skipSubtree();
+            continue;
+        }
+
+        // Add Dir
+        aDirs << entry.path;
+
+        // Check Changed
+        if (!changed && fstatat(entry.dirFd, entry.name.constData(), &dirStat, 0) == 0 && tiLastModified(dirStat) > aSince) {
+            // Set Changed
+            changed = true;
+        }
+    }
+
+    return changed;
+}
+
+//==============================================================================
+// Refresh Root - Rebuilt From Scratch, Changed Dirs Are Not Used
+//==============================================================================
+bool TrigramIndexer::refreshRoot(const QString& aRootPath, const QSet<QByteArray>* aChangedDirs, const bool& aAbort, QList<QByteArray>& aDirs)
+{
+    Q_UNUSED(aChangedDirs);
+
+    qDebug() << "TrigramIndexer::refreshRoot - aRootPath: " << aRootPath;
+
+    // Get Index File Path
+    QString filePath = indexFilePath(aRootPath);
+
+    // Build Index File
+    if (!TrigramIndex::build(aRootPath, filePath, aAbort, aDirs)) {
+        return false;
+    }
+
+    // Init Index
+    QSharedPointer<TrigramIndex> index(new TrigramIndex(filePath));
+
+    // Check Index
+    if (!index->isValid()) {
+        return false;
+    }
+
+    // Init Locker
+    QMutexLocker locker(&mutex);
+    // Set Index
+    indexes[aRootPath] = index;
+
+    return true;
+}
+
+//==============================================================================
+// Drop Root
+//==============================================================================
+void TrigramIndexer::dropRoot(const QString& aRootPath)
+{
+    // Lock Mutex
+    mutex.lock();
+    // Remove Index
+    indexes.remove(aRootPath);
+    // Unlock Mutex
+    mutex.unlock();
+
+    // Remove Index File - Searches Still Using It Keep Their Mapping
+    QFile::remove(indexFilePath(aRootPath));
+}
+
+//==============================================================================
+// Destructor
+//==============================================================================
+TrigramIndexer::~TrigramIndexer()
+{
+    // Remove Client - Waits For A Running Build To Abort
+    IndexWatcher::instance()->removeClient(this);
+}
@@ -0,0 +1,162 @@
+#ifndef TRIGRAMINDEX_H
+#define TRIGRAMINDEX_H
+
+#include <QString>
+#include <QByteArray>
+#include <QBitArray>
+#include <QList>
+#include <QMap>
+#include <QFile>
+#include <QMutex>
+#include <QSharedPointer>
+
+#include "mcwindexwatcher.h"
+
+class DirTreeWalkerEntry;
+
+
+//==============================================================================
+// Trigram Index File State
+//==============================================================================
+enum TrigramIndexFileState
+{
+    ETIFSUnknown        = 0,
+    ETIFSStale,
+    ETIFSIndexed
+};
+
+//==============================================================================
+// Trigram Index Class - Persistent, Memory Mapped, One Per Indexed Root
+//==============================================================================
+class TrigramIndex
+{
+public:
+    // Build Index File - Returns false On Abort Or Write Error
+    static bool build(const QString& aRootPath, const QString& aFilePath, const bool& aAbort, QList<QByteArray>& aDirs);
+
+    // Constructor - Maps An Index File
+    explicit TrigramIndex(const QString& aFilePath);
+
+    // Is Valid
+    bool isValid() const;
+    // Get Root Path
+    QString rootPath() const;
+    // Get Build Time - Msecs Since Epoch
+    qint64 buildTime() const;
+    // Get File Count
+    int fileCount() const;
+
+    // Check File - Gets The State And Index Of A File By Path Relative To The Root
+    TrigramIndexFileState checkFile(const QByteArray& aRelativePath, const qint64& aLastModified, const qint64& aSize, int& aIndex) const;
+
+    // Get Candidates - Files Having All Trigrams Of The Pattern, false If The Pattern Is Too Short
+    bool candidates(const QByteArray& aPattern, QBitArray& aCandidates) const;
+
+    // Destructor
+    ~TrigramIndex();
+
+private:
+    // Find File - Binary Search By Relative Path
+    int findFile(const QByteArray& aRelativePath) const;
+    // Unmap Index File
+    void unmapIndexFile();
+
+private:
+    // Index File
+    QFile           indexFile;
+    // Mapped Data
+    uchar*          mappedData;
+    // Mapped Size
+    qint64          mappedSize;
+    // Root Path
+    QString         root;
+};
+
+//==============================================================================
+// Trigram Index Filter Class - Narrows Content Search Candidates
+//==============================================================================
+class TrigramIndexFilter
+{
+public:
+    // Constructor - Inactive If The Dir Is Not Indexed Or The Pattern Is Too Short
+    TrigramIndexFilter(const QString& aDirPath, const QByteArray& aPattern);
+
+    // Is Active - Walker Entries Need Stat When Active
+    bool isActive() const;
+
+    // May Contain - false Only If The Index Rules The File Out
+    bool mayContain(const DirTreeWalkerEntry& aEntry);
+
+    // Destructor - Reports Stale Files To The Indexer
+    ~TrigramIndexFilter();
+
+private:
+    // Index
+    QSharedPointer<TrigramIndex>    index;
+    // Walker Path Prefix
+    QByteArray                      walkerPrefix;
+    // Search Dir Path Relative To The Index Root
+    QByteArray                      relativePrefix;
+    // Candidate Files
+    QBitArray                       candidateFiles;
+    // Stale File Count
+    int                             staleCount;
+};
+
+//==============================================================================
+// Trigram Indexer Class - Builds & Refreshes Indexes Of The Roots Registered With The Index Watcher
+//==============================================================================
+class TrigramIndexer : public IndexWatcherClient
+{
+public:
+    // Get Instance
+    static TrigramIndexer* instance();
+
+    // Add Root - Nested Roots Are Merged Into The Outermost One
+    void addRoot(const QString& aRootPath);
+    // Remove Root
+    void removeRoot(const QString& aRootPath);
+
+    // Get Index For Dir - NULL If The Dir Is Not Under An Indexed Root
+    QSharedPointer<TrigramIndex> indexFor(const QString& aDirPath);
+
+    // Mark Dirty - Schedules A Rebuild
+    void markDirty(const QString& aRootPath);
+
+    // Destructor
+    virtual ~TrigramIndexer();
+
+protected: // From IndexWatcherClient
+
+    // Watches File Writes - Contents Change Without Entries Changing
+    virtual bool watchesFileWrites() const;
+    // Get Refresh Delay
+    virtual qint64 refreshDelay() const;
+    // Get Time To Live
+    virtual qint64 timeToLive() const;
+
+    // Load Indexes - Existing Index Files
+    virtual void loadIndexes(const bool& aAbort);
+    // Refresh Root - Rebuilt From Scratch, Changed Dirs Are Not Used
+    virtual bool refreshRoot(const QString& aRootPath, const QSet<QByteArray>* aChangedDirs, const bool& aAbort, QList<QByteArray>& aDirs);
+    // Drop Root
+    virtual void dropRoot(const QString& aRootPath);
+
+private:
+    // Constructor
+    TrigramIndexer();
+
+    // Get Index File Path
+    static QString indexFilePath(const QString& aRootPath);
+
+    // Collect Dirs - Returns true If Any Dir Changed Since aSince
+    bool collectDirs(const QString& aRootPath, const qint64& aSince, const bool& aAbort, QList<QByteArray>& aDirs);
+
+private:
+    // Mutex
+    QMutex                                          mutex;
+    // Indexes By Root
+    QMap<QString, QSharedPointer<TrigramIndex> >    indexes;
+};
+
+#endif // TRIGRAMINDEX_H
@@ -3,13 +3,32 @@
 #include <QThread>
 #include <QStringList>
 #include <QFile>
-#include <QTextStream>
 #include <QStorageInfo>
-#include <QMimeDatabase>
-#include <QMimeType>
+#include <QQueue>
+#include <QPair>
+#include <QScopedPointer>
+#include <QStandardPaths>
+
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <dirent.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif // __SSE2__
 
 #include "mcwconstants.h"
 #include "mcwutility.h"
+#include "mcwdirscanner.h"
+#include "mcwtreewalker.h"
+#include "mcwcontentmatcher.h"
+#include "mcwcontentsearch.h"
+#include "mcwtrigramindex.h"
+#include "mcwglobmatcher.h"
+#include "mcwarchivesearch.h"
+#include "mcwignorerules.h"
 
 // Global Mutex
 QMutex  globalMutex;
@@ -380,6 +399,29 @@ bool isDirEmpty(const QString& aDirPath)
     return elCount == 0;
 }
 
+//==============================================================================
+// Get Cache Dir - Created If Missing
+//==============================================================================
+QString getCacheDir()
+{
+    // Get Cache Location
+    QString cacheLocation = QStandardPaths::writableLocation(QStandardPaths::GenericCacheLocation);
+
+    // Check Cache Location
+    if (cacheLocation.isEmpty()) {
+        // Set Cache Location
+        cacheLocation = QDir::homePath() + "/.cache";
+    }
+
+    // Set Cache Dir
+    cacheLocation += QString("/") + DEFAULT_CACHE_DIR_NAME;
+
+    // Make Cache Dir
+    QDir().mkpath(cacheLocation);
+
+    return cacheLocation;
+}
+
 //==============================================================================
 // Get Dir File List
 //==============================================================================
@@ -400,446 +442,377 @@ QFileInfoList getDirFileInfoList(const QString& aDirPath, const bool& aShowHidde
 }
 
 //==============================================================================
-// Compare QStrings Case Insensitive
+// Code Unit To Code Point Order - Surrogates Sort After The BMP
 //==============================================================================
-int fnstricmp(const QString& a, const QString& b)
+static inline uint fnCodePointOrder(const ushort& aUnit)
 {
-    return qstricmp(a.toLocal8Bit().data(), b.toLocal8Bit().data());
+    // Check Surrogate
+    if (aUnit >= 0xD800 && aUnit < 0xE000)
+        return aUnit + 0x2000;
+
+    // Check Above Surrogates
+    if (aUnit >= 0xE000)
+        return aUnit - 0x800;
+
+    return aUnit;
 }
 
 //==============================================================================
-// Compare QStrings Case Sensitive
+// Fold ASCII Code Unit
 //==============================================================================
-int fnstrcmp(const QString& a, const QString& b)
+static inline uint fnFoldAscii(const ushort& aUnit)
 {
-    return qstrcmp(a.toLocal8Bit().data(), b.toLocal8Bit().data());
+    return (uint)(aUnit - 'A') < 26u ? aUnit + 0x20 : aUnit;
 }
 
-// Check Abort Macro
-#define __QS_CHECK_ABORT        if (aAbort) { qDebug() << "#### QSABORT!"; return; }
-
 //==============================================================================
-// File Info List Quick Sort
+// Read Code Point - Advances Index, Handles Surrogate Pairs
 //==============================================================================
-void quickSort(QFileInfoList& aList, int aLeft, int aRight, CompareFuncType aSort, const bool& aReverse, const bool& aDirFirst, const bool& aCase, const bool& aAbort)
+static inline uint fnReadCodePoint(const ushort* aData, const int& aLength, int& aIndex)
 {
-    __QS_CHECK_ABORT;
+    // Get Code Unit
+    uint ucs4 = aData[aIndex++];
 
-    // Check Indexes
-    if (aLeft < 0 || aRight < 0 || aList.count() <= 0)
-        return;
-
-    // Init First And Last Indexes
-    int i = aLeft, j = aRight;
-
-    // Init Pivot
-    QFileInfo pivot = aList[(aLeft + aRight) / 2];
-
-    // Partition
-    while (i <= j) {
-        while ((aSort(aList[i], pivot, aReverse, aDirFirst, aCase) < 0))
-            i++;
-
-        __QS_CHECK_ABORT;
-
-        while ((aSort(aList[j], pivot, aReverse, aDirFirst, aCase) > 0))
-            j--;
+    // Check High Surrogate
+    if (QChar::isHighSurrogate(ucs4) && aIndex < aLength && QChar::isLowSurrogate(aData[aIndex])) {
+        // Combine Surrogates
+        ucs4 = QChar::surrogateToUcs4((ushort)ucs4, aData[aIndex++]);
+    }
 
-        __QS_CHECK_ABORT;
+    return ucs4;
+}
 
-        if (i <= j) {
-            aList.swap(i, j);
-            i++;
-            j--;
+//==============================================================================
+// Compare UTF-16 Case Sensitive - Code Point Order
+//==============================================================================
+static int fnUtf16Compare(const ushort* a, const int& aLength, const ushort* b, const int& bLength)
+{
+    // Get Common Length
+    int length = qMin(aLength, bLength);
+    // Init Index
+    int i = 0;
+
+#if defined(__SSE2__)
+    // Compare 8 Code Units At Once
+    for (; i + 8 <= length; i += 8) {
+        // Load Blocks
+        __m128i va = _mm_loadu_si128((const __m128i*)(a + i));
+        __m128i vb = _mm_loadu_si128((const __m128i*)(b + i));
+
+        // Get Equal Mask
+        uint mask = _mm_movemask_epi8(_mm_cmpeq_epi16(va, vb));
+
+        // Check Mismatch
+        if (mask != 0xFFFF) {
+            // Get First Mismatch
+            int k = i + (__builtin_ctz(~mask) >> 1);
+
+            return (int)fnCodePointOrder(a[k]) - (int)fnCodePointOrder(b[k]);
         }
     }
+#endif // __SSE2__
 
-    // Recursion
-    if (aLeft < j) {
-        quickSort(aList, aLeft, j, aSort, aReverse, aDirFirst, aCase, aAbort);
-
-        __QS_CHECK_ABORT;
+    // Compare The Rest
+    for (; i < length; ++i) {
+        // Check Mismatch
+        if (a[i] != b[i])
+            return (int)fnCodePointOrder(a[i]) - (int)fnCodePointOrder(b[i]);
     }
 
-    // Recursion
-    if (i < aRight) {
-        quickSort(aList, i, aRight, aSort, aReverse, aDirFirst, aCase, aAbort);
-
-        __QS_CHECK_ABORT;
-    }
+    return aLength - bLength;
 }
 
 //==============================================================================
-// Dir First Compare
+// Compare UTF-16 Case Insensitive - ASCII Folded In Blocks, Unicode Folding For The Rest
 //==============================================================================
-int dirFirstCompare(const QFileInfo& a, const QFileInfo& b)
+static int fnUtf16CompareFolded(const ushort* a, const int& aLength, const ushort* b, const int& bLength)
 {
-    // Check If Any File Is Dir
-    if ((a.isDir() || a.isSymLink()) && !b.isDir() && !b.isSymLink())
-        return -1;
+    // Get Common Length
+    int length = qMin(aLength, bLength);
+    // Init Indexes
+    int ia = 0;
+    int ib = 0;
+
+#if defined(__SSE2__)
+    // Init Constants
+    const __m128i nonAsciiMask  = _mm_set1_epi16((short)0xFF80);
+    const __m128i upperA        = _mm_set1_epi16('A');
+    const __m128i upperRange    = _mm_set1_epi16(26);
+    const __m128i minusOne      = _mm_set1_epi16(-1);
+    const __m128i caseBit       = _mm_set1_epi16(0x20);
+    const __m128i zero          = _mm_setzero_si128();
+
+    // Fold 8 ASCII Code Units At Once
+    for (; ia + 8 <= length; ia += 8) {
+        // Load Blocks
+        __m128i va = _mm_loadu_si128((const __m128i*)(a + ia));
+        __m128i vb = _mm_loadu_si128((const __m128i*)(b + ia));
+
+        // Check Non ASCII - Leave The Block To The Scalar Path
+        if (_mm_movemask_epi8(_mm_cmpeq_epi16(_mm_and_si128(_mm_or_si128(va, vb), nonAsciiMask), zero)) != 0xFFFF)
+            break;
+
+        // Get Upper Case Offsets
+        __m128i ta = _mm_sub_epi16(va, upperA);
+        __m128i tb = _mm_sub_epi16(vb, upperA);
+
+        // Fold Upper Case Letters
+        va = _mm_add_epi16(va, _mm_and_si128(_mm_and_si128(_mm_cmpgt_epi16(ta, minusOne), _mm_cmplt_epi16(ta, upperRange)), caseBit));
+        vb = _mm_add_epi16(vb, _mm_and_si128(_mm_and_si128(_mm_cmpgt_epi16(tb, minusOne), _mm_cmplt_epi16(tb, upperRange)), caseBit));
+
+        // Get Equal Mask
+        uint mask = _mm_movemask_epi8(_mm_cmpeq_epi16(va, vb));
+
+        // Check Mismatch
+        if (mask != 0xFFFF) {
+            // Get First Mismatch
+            int k = ia + (__builtin_ctz(~mask) >> 1);
+
+            return (int)fnFoldAscii(a[k]) - (int)fnFoldAscii(b[k]);
+        }
+    }
 
-    // Check If Any File Is Dir
-    if (!a.isDir() && !a.isSymLink() && (b.isDir() || b.isSymLink()))
-        return 1;
+    // Sync Index
+    ib = ia;
+#endif // __SSE2__
 
-//    // Check File Name
-//    if (a.fileName() == QString(".") && b.fileName() != QString("."))
-//        return -1;
+    // Compare The Rest
+    while (ia < aLength && ib < bLength) {
+        // Get Code Units
+        ushort ua = a[ia];
+        ushort ub = b[ib];
 
-//    // Check File Name
-//    if (a.fileName() != QString(".") && b.fileName() == QString("."))
-//        return 1;
+        // Check ASCII
+        if (ua < 0x80 && ub < 0x80) {
+            // Fold
+            uint fa = fnFoldAscii(ua);
+            uint fb = fnFoldAscii(ub);
 
-    return 0;
-}
+            // Check Mismatch
+            if (fa != fb)
+                return (int)fa - (int)fb;
 
-//==============================================================================
-// Name Sort Compare
-//==============================================================================
-int nameSortCompare(const QFileInfo& a, const QFileInfo& b, const bool& r, const bool& df, const bool& cs)
-{
-    // Check Dir First
-    if (df) {
-        // Apply Dir First Filter
-        int dfr = dirFirstCompare(a, b);
-
-        // Check Dir First Result
-        if (dfr)
-            return dfr;
-    }
+            ia++;
+            ib++;
 
-    // Check File Name
-    if (a.fileName() == QString("..") && b.fileName() != QString(".."))
-        return -1;
+            continue;
+        }
 
-    // Check File Name
-    if (a.fileName() != QString("..") && b.fileName() == QString(".."))
-        return 1;
+        // Read & Fold Code Points
+        uint fa = QChar::toCaseFolded(fnReadCodePoint(a, aLength, ia));
+        uint fb = QChar::toCaseFolded(fnReadCodePoint(b, bLength, ib));
 
-    // Compare Items
-    int result = cs ? fnstrcmp(a.fileName(), b.fileName()) : fnstricmp(a.fileName(), b.fileName());
+        // Check Mismatch
+        if (fa != fb)
+            return fa < fb ? -1 : 1;
+    }
 
-    return r ? -result : result;
+    return (aLength - ia) - (bLength - ib);
 }
 
 //==============================================================================
-// Extension Sort Compare
+// Compare UTF-16 Case Insensitive - In Place, No Allocation
 //==============================================================================
-int extSortCompare(const QFileInfo& a, const QFileInfo& b, const bool& r, const bool& df, const bool& cs)
+int fnstricmp(const QChar* a, const int& aLength, const QChar* b, const int& bLength)
 {
-    // Check Dir First
-    if (df) {
-        // Apply Dir First Filter
-        int dfr = dirFirstCompare(a, b);
-
-        // Check Dir First Result
-        if (dfr)
-            return dfr;
-    }
-
-    // Init Result
-    int result = 0;
-
-    // Get a Split
-    QStringList aSplit = getSplited(a.fileName());
-    // Get b Split
-    QStringList bSplit = getSplited(b.fileName());
-
-    // Check If Both File Is a Dir Or Link
-    if ((a.isDir() && b.isDir()) || (a.isSymLink() && b.isSymLink()) || (a.isDir() && b.isSymLink()) || (a.isSymLink() && b.isDir()))
-        // Return Name Sort
-        return nameSortCompare(a, b, r, df, cs);
-
-    // Check Base Name
-    if (aSplit[0].isEmpty() && !bSplit[0].isEmpty()) {
-        // Adjust Result
-        result = 1;
-    } else if (!aSplit[0].isEmpty() && bSplit[0].isEmpty()) {
-        // Adjust Result
-        result = -1;
-    } else {
-        // Compare Items
-        result = cs ? fnstrcmp(aSplit[1], bSplit[1]) : fnstricmp(aSplit[1], bSplit[1]);
-    }
-
-    // Check Result
-    if (result)
-        return r ? -result : result;
-
-    // Return Name Sort Result
-    return nameSortCompare(a, b, r, df, cs);
+    return fnUtf16CompareFolded(reinterpret_cast<const ushort*>(a), aLength, reinterpret_cast<const ushort*>(b), bLength);
 }
 
 //==============================================================================
-// Type Sort Compare
+// Compare UTF-16 Case Sensitive - In Place, No Allocation
 //==============================================================================
-int typeSortCompare(const QFileInfo& a, const QFileInfo& b, const bool& r, const bool& df, const bool& cs)
+int fnstrcmp(const QChar* a, const int& aLength, const QChar* b, const int& bLength)
 {
-    Q_UNUSED(cs);
-
-    // Check Dir First
-    if (df) {
-        // Apply Dir First Filter
-        int dfr = dirFirstCompare(a, b);
-
-        // Check Dir First Result
-        if (dfr)
-            return dfr;
-    }
-
-    // Compare Items
-    int result = fnstrcmp(a.fileName(), b.fileName());
-
-    return r ? -result : result;
+    return fnUtf16Compare(reinterpret_cast<const ushort*>(a), aLength, reinterpret_cast<const ushort*>(b), bLength);
 }
 
 //==============================================================================
-// Size Sort Compare
+// Compare QStrings Case Insensitive
 //==============================================================================
-int sizeSortCompare(const QFileInfo& a, const QFileInfo& b, const bool& r, const bool& df, const bool& cs)
+int fnstricmp(const QString& a, const QString& b)
 {
-    // Check Dir First
-    if (df) {
-        // Apply Dir First Filter
-        int dfr = dirFirstCompare(a, b);
-
-        // Check Dir First Result
-        if (dfr)
-            return dfr;
-    }
-
-    // Check If Both File Is a Dir Or Link
-    if ((a.isDir() && b.isDir()) || (a.isSymLink() && b.isSymLink()))
-        // Return Name Sort
-        return nameSortCompare(a, b, r, df, cs);
-
-    // Check File Size
-    if (a.size() > b.size())
-        return r ? -1 : 1;
-
-    // Check File Size
-    if (a.size() < b.size())
-        return r ? 1 : -1;
-
-    // Return Name Sort Result
-    return nameSortCompare(a, b, r, df, cs);
+    return fnstricmp(a.constData(), a.length(), b.constData(), b.length());
 }
 
 //==============================================================================
-// Date Sort Compare
+// Compare QStrings Case Sensitive
 //==============================================================================
-int dateSortCompare(const QFileInfo& a, const QFileInfo& b, const bool& r, const bool& df, const bool& cs)
+int fnstrcmp(const QString& a, const QString& b)
 {
-    // Check Dir First
-    if (df) {
-        // Apply Dir First Filter
-        int dfr = dirFirstCompare(a, b);
-
-        // Check Dir First Result
-        if (dfr)
-            return dfr;
-    }
-
-    // Check File Name
-    if (a.fileName() == QString("..") && b.fileName() != QString(".."))
-        return -1;
-
-    // Check File Name
-    if (a.fileName() != QString("..") && b.fileName() == QString(".."))
-        return 1;
-
-    // Check File Date
-    if (a.lastModified() < b.lastModified())
-        return r ? -1 : 1;
-
-    // Check File Date
-    if (a.lastModified() > b.lastModified())
-        return r ? 1 : -1;
-
-    // Return Name Sort Result
-    return nameSortCompare(a, b, r, df, cs);
+    return fnstrcmp(a.constData(), a.length(), b.constData(), b.length());
 }
 
 //==============================================================================
-// Owners Sort Compare
+// Scan Dir Size
 //==============================================================================
-int ownSortCompare(const QFileInfo& a, const QFileInfo& b, const bool& r, const bool& df, const bool& cs)
+quint64 scanDirectorySize(const QString& aDirPath, quint64& aNumDirs, quint64& aNumFiles, const bool& aAbort, dirSizeScanProgressCallback aCallback, void* aContext)
 {
-    // Check Dir First
-    if (df) {
-        // Apply Dir First Filter
-        int dfr = dirFirstCompare(a, b);
-
-        // Check Dir First Result
-        if (dfr)
-            return dfr;
+    // Check Abort
+    if (aAbort) {
+        return 0;
     }
 
-    // Init Result
-    int result = cs ? fnstrcmp(a.owner(), b.owner()) : fnstricmp(a.owner(), b.owner());
+    // Init Scanner
+    DirSizeScanner scanner(aAbort, aCallback, aContext);
 
-    // Check REsult
-    if (result)
-        // Return Result
-        return r ? -result : result;
-
-    // Return Name Sort Result
-    return nameSortCompare(a, b, r, df, cs);
+    return scanner.scan(aDirPath, aNumDirs, aNumFiles);
 }
 
 //==============================================================================
-// Permission Sort Compare
+// Read Sub Dir Names - Uses d_type, Stats Only Unknown Types, Stops At First If No List
 //==============================================================================
-int permSortCompare(const QFileInfo& a, const QFileInfo& b, const bool& r, const bool& df, const bool& cs)
+static bool readSubDirNames(const QString& aDirPath, const bool& aShowHidden, QList<QByteArray>* aNames)
 {
-    // Check Dir First
-    if (df) {
-        // Apply Dir First Filter
-        int dfr = dirFirstCompare(a, b);
-
-        // Check Dir First Result
-        if (dfr)
-            return dfr;
+    // Open Dir
+    DIR* dir = opendir(QFile::encodeName(aDirPath).constData());
+
+    // Check Dir
+    if (!dir) {
+        return false;
     }
 
-    // Check File Permissions
-    if (a.permissions() < b.permissions())
-        return r ? -1 : 1;
+    // Init Found
+    bool found = false;
+    // Init Dir Entry
+    struct dirent* dirEntry = NULL;
 
-    // Check File Permissions
-    if (a.permissions() > b.permissions())
-        return r ? 1 : -1;
+    // Go Thru Dir Entries
+    while ((dirEntry = readdir(dir)) != NULL) {
+        // Get Name
+        const char* name = dirEntry->d_name;
 
-    // Return Name Sort Result
-    return nameSortCompare(a, b, r, df, cs);
-}
+        // Check Dot, Dot Dot & Hidden
+        if (name[0] == '.' && (name[1] == '\0' || (name[1] == '.' && name[2] == '\0') || !aShowHidden)) {
+            continue;
+        }
 
-//==============================================================================
-// Attributes Sort Compare
-//==============================================================================
-int attrSortCompare(const QFileInfo& a, const QFileInfo& b, const bool& r, const bool& df, const bool& cs)
-{
-    // Check Dir First
-    if (df) {
-        // Apply Dir First Filter
-        int dfr = dirFirstCompare(a, b);
-
-        // Check Dir First Result
-        if (dfr)
-            return dfr;
-    }
+        // Init Is Dir - Links Are Not Followed
+        bool entryIsDir = dirEntry->d_type == DT_DIR;
 
-    // Check File Attributes
-    if (getAttributes(a.absoluteFilePath()) < getAttributes(b.absoluteFilePath()))
-        return r ? -1 : 1;
+        // Check Unknown Type - Some File Systems Don't Fill d_type
+        if (dirEntry->d_type == DT_UNKNOWN) {
+            // Init Stat
+            struct stat entryStat;
+            // Stat Entry
+            entryIsDir = fstatat(dirfd(dir), name, &entryStat, AT_SYMLINK_NOFOLLOW) == 0 && S_ISDIR(entryStat.st_mode);
+        }
+
+        // Check Is Dir
+        if (!entryIsDir) {
+            continue;
+        }
 
-    // Check File Attributes
-    if (getAttributes(a.absoluteFilePath()) > getAttributes(b.absoluteFilePath()))
-        return r ? 1 : -1;
+        // Set Found
+        found = true;
+
+        // Check Names
+        if (!aNames) {
+            break;
+        }
+
+        // Add Name
+        *aNames << QByteArray(name);
+    }
 
-    // Return Name Sort Result
-    return nameSortCompare(a, b, r, df, cs);
+    // Close Dir
+    closedir(dir);
+
+    return found;
 }
 
 //==============================================================================
-// Sort File List
+// Sub Dir Name Less Than
 //==============================================================================
-void sortFileList(QFileInfoList& aFileInfoList, const FileSortType& aSortType, const bool& aReverse, const bool& aDirFirst, const bool& aCase, const bool& aAbort)
+static bool subDirNameLessThan(const QString& a, const QString& b)
 {
-    // Get File List Count
-    int flCount = aFileInfoList.count();
-
-    //qDebug() << "sortFileList - aSortType: " << aSortType;
-
-    // Switch Sorting Method
-    switch (aSortType) {
-        default:
-        case EFSTName:          quickSort(aFileInfoList, 0, flCount-1, nameSortCompare, aReverse, aDirFirst, aCase, aAbort); break;
-        case EFSTExtension:     quickSort(aFileInfoList, 0, flCount-1, extSortCompare,  aReverse, aDirFirst, aCase, aAbort); break;
-        case EFSTType:          quickSort(aFileInfoList, 0, flCount-1, typeSortCompare, aReverse, aDirFirst, aCase, aAbort); break;
-        case EFSTSize:          quickSort(aFileInfoList, 0, flCount-1, sizeSortCompare, aReverse, aDirFirst, aCase, aAbort); break;
-        case EFSTDate:          quickSort(aFileInfoList, 0, flCount-1, dateSortCompare, aReverse, aDirFirst, aCase, aAbort); break;
-        case EFSTOwnership:     quickSort(aFileInfoList, 0, flCount-1, ownSortCompare,  aReverse, aDirFirst, aCase, aAbort); break;
-        case EFSTPermission:    quickSort(aFileInfoList, 0, flCount-1, permSortCompare, aReverse, aDirFirst, aCase, aAbort); break;
-        case EFSTAttributes:    quickSort(aFileInfoList, 0, flCount-1, attrSortCompare, aReverse, aDirFirst, aCase, aAbort); break;
-    }
+    return fnstricmp(a, b) < 0;
 }
 
-#define __SDS_CHECK_ABORT   if (aAbort) return result
-
 //==============================================================================
-// Scan Dir Size
+// Dir Tree Scan Item - Queued Dir With Its Sub Dir Names Already Read
 //==============================================================================
-quint64 scanDirectorySize(const QString& aDirPath, quint64& aNumDirs, quint64& aNumFiles, const bool& aAbort, dirSizeScanProgressCallback aCallback, void* aContext)
+class DirTreeScanItem
 {
-    // Init Dir Info
-    QFileInfo dirInfo(aDirPath);
-
-    // Init Result
-    quint64 result = 0;
-
-    // Check Abort
-    __SDS_CHECK_ABORT;
+public:
+    // Path
+    QString             path;
+    // Depth
+    int                 depth;
+    // Sub Dir Names
+    QList<QByteArray>   names;
+};
 
-    // Check If Is Dir
-    if (dirInfo.isDir() || dirInfo.isBundle()) {
-        //qDebug() << "scanDirectorySize - aDirPath: " << aDirPath;
-
-        __SDS_CHECK_ABORT;
+//==============================================================================
+// Scan Dir Tree - Breadth First, Dirs Only, Each Dir Is Read Once
+//==============================================================================
+void scanDirectoryTree(const QString& aDirPath, const int& aMaxDepth, const bool& aShowHidden, const bool& aAbort, dirTreeItemFoundCallback aCallback, void* aContext)
+{
+    // Init Queue
+    QQueue<DirTreeScanItem> queue;
+    // Init Root Item
+    DirTreeScanItem rootItem;
 
-        // Init dir
-        QDir dir(aDirPath);
+    // Setup Root Item
+    rootItem.path   = aDirPath;
+    rootItem.depth  = 0;
 
-        __SDS_CHECK_ABORT;
+    // Read Root Sub Dir Names
+    if (!readSubDirNames(aDirPath, aShowHidden, &rootItem.names)) {
+        return;
+    }
 
-        // Get File Info List
-        QFileInfoList fiList = dir.entryInfoList(QDir::AllEntries | QDir::NoDotAndDotDot | QDir::Hidden | QDir::System);
+    // Enqueue Root
+    queue.enqueue(rootItem);
 
-        __SDS_CHECK_ABORT;
+    // Go Thru Queue
+    while (!queue.isEmpty() && !aAbort) {
+        // Get Next Dir
+        DirTreeScanItem current = queue.dequeue();
 
-        // Get File Info List Count
-        int filCount = fiList.count();
+        // Init Sub Dirs
+        QStringList subDirs;
 
-        __SDS_CHECK_ABORT;
+        // Go Thru Names
+        for (int i=0; i<current.names.count(); ++i) {
+            // Add Sub Dir
+            subDirs << QFile::decodeName(current.names[i]);
+        }
 
-        // Go Thru File Info List
-        for (int i=0; i<filCount; ++i) {
-            __SDS_CHECK_ABORT;
+        // Sort Sub Dirs
+        qSort(subDirs.begin(), subDirs.end(), subDirNameLessThan);
 
-            // Get File Info
-            QFileInfo fileInfo = fiList[i];
+        // Init Dir Prefix
+        QString dirPrefix = current.path.endsWith("/") ? current.path : current.path + "/";
+        // Get Child Depth
+        int childDepth = current.depth + 1;
+        // Check Depth Limit - Negative Means Unlimited
+        bool enqueueChildren = aMaxDepth < 0 || childDepth < aMaxDepth;
 
-            __SDS_CHECK_ABORT;
+        // Go Thru Sub Dirs
+        for (int i=0; i<subDirs.count() && !aAbort; ++i) {
+            // Init Child Item
+            DirTreeScanItem childItem;
 
-            // Check If Is Dir
-            if ((fileInfo.isDir() || fileInfo.isBundle()) && !fileInfo.isSymLink()) {
-                //qDebug() << "scanDirectorySize - dirName: " << fileInfo.fileName();
-                // Inc Num Dirs
-                aNumDirs++;
-                // Add Dir Size To REsult
-                result += scanDirectorySize(fileInfo.absoluteFilePath(), aNumDirs, aNumFiles, aAbort, aCallback, aContext);
-
-            } else {
-                //qDebug() << "scanDirectorySize - fileName: " << fileInfo.fileName() << " - size: " << fileInfo.size();
-                // Inc Num Files
-                aNumFiles++;
-                // Add File Size To REsult
-                result += fileInfo.size();
-            }
+            // Setup Child Item
+            childItem.path  = dirPrefix + subDirs[i];
+            childItem.depth = childDepth;
 
-            __SDS_CHECK_ABORT;
+            // Check Has Sub Dirs - Full List If The Child Is Queued, Otherwise Stops At The First One
+            bool hasSub = readSubDirNames(childItem.path, aShowHidden, enqueueChildren ? &childItem.names : NULL);
 
             // Check Callback
             if (aCallback) {
                 // Callback
-                aCallback(aDirPath, aNumDirs, aNumFiles, result, aContext);
+                aCallback(childItem.path, childDepth, hasSub, aContext);
             }
 
-            __SDS_CHECK_ABORT;
+            // Check Has Sub Dirs & Depth Limit
+            if (hasSub && enqueueChildren) {
+                // Enqueue Child
+                queue.enqueue(childItem);
+            }
         }
     }
-
-    return result;
 }
 
 #define __SD_CHECK_ABORT   if (aAbort) return
@@ -883,43 +856,56 @@ bool isMimeSupportedByContentSearch(const QString& aMimeType)
 }
 
 //==============================================================================
-// Is White Space
+// Get Search File Name Patterns - Patterns Without A Star Match Anywhere In The Name
 //==============================================================================
-bool isWhiteSpace(const QChar& aChar)
+QStringList getSearchFileNamePatterns(const QString& aFilePattern)
 {
-    if (aChar.isNull())
-        return true;
+    // Get File Name Patterns
+    QStringList fileNamePatterns = GlobMatcher::splitPatterns(aFilePattern);
+
+    // Go Thru File Name Patterns
+    for (int i=0; i<fileNamePatterns.count(); ++i) {
+        // Get Exclude Mark Length
+        int markLength = fileNamePatterns[i].startsWith(QChar('!')) ? 1 : 0;
+
+        // Check Star
+        if (fileNamePatterns[i].indexOf("*") == -1) {
+            // Wrap Pattern
+            fileNamePatterns[i] = fileNamePatterns[i].left(markLength) + QString("*") + fileNamePatterns[i].mid(markLength) + QString("*");
+        }
+    }
 
-    return aChar.isSpace();
+    return fileNamePatterns;
 }
 
 //==============================================================================
-// Check Whole Word
+// Create Search Content Matcher - Single Term Substring Or Regular Expression, Several Terms Matched Together
 //==============================================================================
-bool checkPatternSurroundings(const QString& aContent, const QString& aPattern, const int& aIndex)
+ContentMatcher* createSearchContentMatcher(const QStringList& aContentTerms, const int& aOptions)
 {
-    // Check Index
-    if (aIndex < 0) {
-        return false;
+    // Get Case Sensitive
+    bool caseSensitive = aOptions & DEFAULT_SEARCH_OPTION_CASE_SENSITIVE;
+    // Get Whole Word
+    bool wholeWord = aOptions & DEFAULT_SEARCH_OPTION_WHOLE_WORD;
+
+    // Check Term Count - Single Terms Keep The Substring & Regular Expression Matchers
+    if (aContentTerms.count() <= 1) {
+        return new ContentMatcher(aContentTerms.value(0).toUtf8(), caseSensitive, wholeWord, aOptions & DEFAULT_SEARCH_OPTION_REGEXP);
     }
 
-    // Get Pattern Length
-    int pLength = aPattern.length();
-    // Get content Length
-    int cLength = aContent.length();
-
-    // Get Prepending Char
-    QChar preChar = (aIndex > 0) ? aContent[aIndex - 1] : QChar('\0');
+    // Init Terms
+    QList<QByteArray> terms;
 
-    // Get Trailing Char
-    QChar trailChar = (aIndex + pLength < cLength) ? aContent[aIndex + pLength] : QChar('\0');
-
-    // Check Index
-    if (((aIndex == 0) || isWhiteSpace(preChar)) && (isWhiteSpace(trailChar) || (aIndex + pLength >= cLength))) {
-        return true;
+    // Check Regular Expression - Terms Are Literal, Left Empty To Be Rejected As Invalid
+    if (!(aOptions & DEFAULT_SEARCH_OPTION_REGEXP)) {
+        // Go Thru Content Terms
+        for (int i=0; i<aContentTerms.count(); ++i) {
+            // Add Term - Encoded As UTF-8
+            terms << aContentTerms[i].toUtf8();
+        }
     }
 
-    return false;
+    return new ContentMatcher(terms, caseSensitive, wholeWord, aOptions & DEFAULT_SEARCH_OPTION_ALL_TERMS);
 }
 
 //==============================================================================
@@ -927,124 +913,125 @@ bool checkPatternSurroundings(const QString& aContent, const QString& aPattern,
 //==============================================================================
 void searchDirectory(const QString& aDirPath,
                      const QString& aFilePattern,
-                     const QString& aContentPattern,
+                     const QStringList& aContentTerms,
+                     const QString& aExcludePatterns,
                      const int& aOptions,
                      const bool& aAbort,
                      fileSearchItemFoundCallback aCallback,
                      void* aContext)
 {
-    // Init Mime Database
-    QMimeDatabase mimeDatabase;
+    // Init File Name Matcher - Compiled Once, Case Insensitive Like QDir::match
+    GlobMatcher fileNameMatcher(getSearchFileNamePatterns(aFilePattern), false);
 
-    // Init Local File Name Pattern
-    QString localFileNamePattern = aFilePattern.indexOf("*") == -1 ? QString("*") + aFilePattern + QString("*") : aFilePattern;
+    // Init Content Matcher - Raw Bytes, Term Set Or Regular Expression, Patterns Encoded As UTF-8
+    QScopedPointer<ContentMatcher> contentMatcher(createSearchContentMatcher(aContentTerms, aOptions));
+    // Init Content Search Pool - Matching Runs On Its Threads While Walking Goes On
+    QScopedPointer<ContentSearchPool> contentSearchPool(aContentTerms.isEmpty() ? NULL : new ContentSearchPool(aDirPath, *contentMatcher, aOptions & DEFAULT_SEARCH_OPTION_ORDERED, aAbort, aCallback, aContext));
 
-    // Init Dir Info
-    QFileInfo dirInfo(aDirPath);
+    // Init Archive Search - Supported Archives Are Searched In Place, Hits Reported As They Are Found
+    QScopedPointer<ArchiveSearch> archiveSearch((aOptions & DEFAULT_SEARCH_OPTION_ARCHIVES) ? new ArchiveSearch(fileNameMatcher, aContentTerms.isEmpty() ? NULL : contentMatcher.data(), aAbort, aCallback, aContext) : NULL);
 
-    __SD_CHECK_ABORT;
+    // Init Trigram Index Filter - Indexed Dirs Skip Files That Can't Contain The Pattern, Not Used For Regular Expressions & Any Term Searches, ASCII Part Only For Other Case Variants
+    TrigramIndexFilter indexFilter(aDirPath, contentMatcher->indexPattern());
 
-    // Check If Is Dir
-    if (dirInfo.isDir() || dirInfo.isBundle()) {
+    // Init Ignore Rules - Per Dir By Depth, Root Dir First, NULL If Nothing Is Excluded
+    QList<QSharedPointer<const IgnoreRules> > ignoreRules;
+    // Add Root Dir Rules - Request Patterns & Ignore Files Of The Root
+    ignoreRules << IgnoreRules::forDir(IgnoreRules::create(aDirPath, aExcludePatterns, aOptions & DEFAULT_SEARCH_OPTION_IGNORE_FILES), aDirPath);
 
-        // Init dir
-        QDir dir(aDirPath);
+    // Init Walker - Iterative, Entries Are Opened Relative To Their Dir, Stat Needed For Index Checks
+    DirTreeWalker walker(aDirPath, indexFilter.isActive() ? EDTWFShowHidden | EDTWFStat : EDTWFShowHidden, aAbort);
+    // Init Entry
+    DirTreeWalkerEntry entry;
+
+    // Go Thru Entries
+    while (walker.next(entry)) {
 
         __SD_CHECK_ABORT;
 
-        // Get File Info List
-        QFileInfoList fiList = dir.entryInfoList(QDir::AllEntries | QDir::NoDotAndDotDot | QDir::Hidden | QDir::System);
+        // Check Type - Unreadable Dirs & Loops Are Skipped
+        if (entry.type == EDTWTError || entry.type == EDTWTLoop) {
+            continue;
+        }
 
-        // Get File Info List Count
-        int filCount = fiList.count();
+        // Get File Name
+        QString fileName = entry.fileName();
 
-        __SD_CHECK_ABORT;
+        // Check Ignore Rules
+        if (!ignoreRules.first().isNull()) {
+            // Get Parent Dir Rules - Pre Order, The Parent Is The Last Dir Entered At depth - 1
+            QSharedPointer<const IgnoreRules> dirRules = ignoreRules.value(entry.depth - 1);
 
-        // Go Thru File Info List
-        for (int i=0; i<filCount; ++i) {
+            // Check Excluded - Excluded Dirs Are Skipped Without Being Opened
+            if (dirRules->isExcluded(entry.filePath(), fileName, entry.type == EDTWTDir)) {
+                // Check If Is Dir
+                if (entry.type == EDTWTDir) {
+                    // Skip Subtree
+                    walker.skipSubtree();
+                }
 
-            __SD_CHECK_ABORT;
+                continue;
+            }
 
-            // Get File Info
-            QFileInfo fileInfo = fiList[i];
+            // Check If Is Dir
+            if (entry.type == EDTWTDir) {
+                // Cut Rules Of Finished Dirs
+                while (ignoreRules.count() > entry.depth) {
+                    ignoreRules.removeLast();
+                }
 
-            __SD_CHECK_ABORT;
+                // Add Dir Rules - Ignore Files Of The Dir Apply Below It
+                ignoreRules << IgnoreRules::forDir(dirRules, entry.filePath());
+            }
+        }
 
-            // Check If Is Dir
-            if ((fileInfo.isDir() || fileInfo.isBundle()) && !fileInfo.isSymLink()) {
+        // Check If Is Dir
+        if (entry.type == EDTWTDir) {
 
-                // Check If Pattern Matches - Simple File Search
-                if (dir.match(localFileNamePattern, fileInfo.fileName()) && aContentPattern.isEmpty()) {
-                    // Check Callback
-                    if (aCallback) {
-                        // Callback
-                        aCallback(aDirPath, fileInfo.absoluteFilePath(), aContext);
-                    }
+            // Check If Pattern Matches - Simple File Search
+            if (aContentTerms.isEmpty() && fileNameMatcher.match(fileName)) {
+                // Check Callback
+                if (aCallback) {
+                    // Callback
+                    aCallback(entry.parentPath(), entry.filePath(), NULL, aContext);
                 }
+            }
+
+        } else {
+            // Check Archive Search
+            if (!archiveSearch.isNull() && ArchiveSearch::isSupported(fileName)) {
+                // Search Archive
+                archiveSearch->search(entry.filePath());
 
                 __SD_CHECK_ABORT;
+            }
 
-                // Search Directory
-                searchDirectory(fileInfo.absoluteFilePath(), localFileNamePattern, aContentPattern, aOptions, aAbort, aCallback, aContext);
-
-            } else {
-                // Check If Pattern Matches
-                if (dir.match(localFileNamePattern, fileInfo.fileName())) {
-                    // Check Content Pattern
-                    if (!aContentPattern.isEmpty()) {
-                        // Get Mime
-                        QString mime = mimeDatabase.mimeTypeForFile(fileInfo.absoluteFilePath()).name();
-                        // Chek Mime
-                        if (isMimeSupportedByContentSearch(mime)) {
-                            // Init File
-                            QFile currFile(fileInfo.absoluteFilePath());
-                            // Open File
-                            if (currFile.open(QIODevice::ReadOnly)) {
-                                // Init Text Stream
-                                QTextStream textStream(&currFile);
-                                // Read All
-                                QString content = textStream.readAll();
-                                // Get Patttern Index
-                                int pIndex = content.indexOf(aContentPattern, 0, (aOptions & DEFAULT_SEARCH_OPTION_CASE_SENSITIVE) ? Qt::CaseSensitive : Qt::CaseInsensitive);
-                                // Search Content
-                                if (pIndex >= 0) {
-                                    // Check Options For Whole Word
-                                    if (aOptions & DEFAULT_SEARCH_OPTION_WHOLE_WORD) {
-                                        // Check Surroundings Of Pattern For White Space
-                                        if (checkPatternSurroundings(content, aContentPattern, pIndex)) {
-                                            // Check Callback
-                                            if (aCallback) {
-                                                // Callback
-                                                aCallback(aDirPath, fileInfo.absoluteFilePath(), aContext);
-                                            }
-                                        }
-                                    } else {
-                                        // Check Callback
-                                        if (aCallback) {
-                                            // Callback
-                                            aCallback(aDirPath, fileInfo.absoluteFilePath(), aContext);
-                                        }
-                                    }
-                                }
-
-                                // Close File
-                                currFile.close();
-                            }
-                        }
-                    } else {
-                        // Check Callback
-                        if (aCallback) {
-                            // Callback
-                            aCallback(aDirPath, fileInfo.absoluteFilePath(), aContext);
-                        }
+            // Check If Pattern Matches
+            if (fileNameMatcher.match(fileName)) {
+                // Check Content Pattern
+                if (!contentSearchPool.isNull()) {
+                    // Check Index Filter
+                    if (indexFilter.mayContain(entry)) {
+                        // Add File To Content Search Pool
+                        contentSearchPool->add(entry.parentPath(), entry.filePath());
+                    }
+                } else {
+                    // Check Callback
+                    if (aCallback) {
+                        // Callback
+                        aCallback(entry.parentPath(), entry.filePath(), NULL, aContext);
                     }
                 }
             }
-
-            __SD_CHECK_ABORT;
         }
     }
 
+    // Check Content Search Pool
+    if (!contentSearchPool.isNull()) {
+        // Finish Content Search - Reports Remaining Hits
+        contentSearchPool->finish();
+    }
+
     __SD_CHECK_ABORT;
 }
 
@@ -2,6 +2,7 @@
 #define UTILITY
 
 #include <QString>
+#include <QStringList>
 #include <QList>
 #include <QDir>
 #include <QDateTime>
@@ -9,21 +10,9 @@
 
 #include "mcwinterface.h"
 
+class ContentHit;
+class ContentMatcher;
 
-//==============================================================================
-// FileSortType File Sort Type Enum
-//==============================================================================
-enum FileSortType
-{
-    EFSTName        = DEFAULT_SORT_NAME,
-    EFSTExtension   = DEFAULT_SORT_EXT,
-    EFSTType        = DEFAULT_SORT_TYPE,
-    EFSTSize        = DEFAULT_SORT_SIZE,
-    EFSTDate        = DEFAULT_SORT_DATE,
-    EFSTOwnership   = DEFAULT_SORT_OWNER,
-    EFSTPermission  = DEFAULT_SORT_PERMS,
-    EFSTAttributes  = DEFAULT_SORT_ATTRS
-};
 
 //==============================================================================
 // DriveType Drive Type Enum
@@ -39,47 +28,6 @@ enum DriveType
     DTRamDisk
 };
 
-//==============================================================================
-// File List Item Type Class
-//==============================================================================
-class FileListItem
-{
-public:
-    // Constructor
-    explicit FileListItem(const QString& aPath, const QString& aFileName, const bool& aIsDir);
-    // File Path
-    QString     filePath;
-    // File Name
-    QString     fileName;
-    // Base Name
-    QString     baseName;
-    // Suffix
-    QString     suffix;
-    // Type
-    QString     type;
-    // Size
-    qint64      size;
-    // Last Modified
-    QDateTime   lastModified;
-    // Owner
-    QString     owner;
-    // Permissions
-    int         permissions;
-    // Attributes
-    int         attributes;
-    // Is Dir
-    bool        isDir;
-    // Is Link
-    bool        isSymLink;
-};
-
-
-//==============================================================================
-// File List Type
-//==============================================================================
-typedef QList<FileListItem> FileList;
-
-
 
 // Is On Same Drive
 bool isOnSameDrive(const QString& aPathOne, const QString& aPathTwo);
@@ -126,6 +74,9 @@ bool isDir(const QString& aDirPath);
 // Check If Dir Is Empty
 bool isDirEmpty(const QString& aDirPath);
 
+// Get Cache Dir - Created If Missing
+QString getCacheDir();
+
 
 // =========
 
@@ -134,31 +85,10 @@ bool isDirEmpty(const QString& aDirPath);
 int fnstricmp(const QString& a, const QString& b);
 // Case Sensitive Compare
 int fnstrcmp(const QString& a, const QString& b);
-
-// Compare Method Type
-typedef int (*CompareFuncType)(const QFileInfo&, const QFileInfo&, const bool&, const bool&, const bool&);
-
-// File Info List Quick Sort
-void quickSort(QFileInfoList& aList, int aLeft, int aRight, CompareFuncType aSort, const bool& aReverse, const bool& aDirFirst, const bool& aCase, const bool& aAbort);
-
-// Dir First Compare
-int dirFirstCompare(const QFileInfo& a, const QFileInfo& b);
-// Name Sort Compare
-int nameSortCompare(const QFileInfo& a, const QFileInfo& b, const bool& r, const bool& df, const bool& cs);
-// Extension Sort Compare
-int extSortCompare(const QFileInfo& a, const QFileInfo& b, const bool& r, const bool& df, const bool& cs);
-// Type Sort Compare
-int typeSortCompare(const QFileInfo& a, const QFileInfo& b, const bool& r, const bool& df, const bool& cs);
-// Size Sort Compare
-int sizeSortCompare(const QFileInfo& a, const QFileInfo& b, const bool& r, const bool& df, const bool& cs);
-// Date Sort Compare
-int dateSortCompare(const QFileInfo& a, const QFileInfo& b, const bool& r, const bool& df, const bool& cs);
-// Owners Sort Compare
-int ownSortCompare(const QFileInfo& a, const QFileInfo& b, const bool& r, const bool& df, const bool& cs);
-// Permission Sort Compare
-int permSortCompare(const QFileInfo& a, const QFileInfo& b, const bool& r, const bool& df, const bool& cs);
-// Attributes Sort Compare
-int attrSortCompare(const QFileInfo& a, const QFileInfo& b, const bool& r, const bool& df, const bool& cs);
+// Case In Sensitive Compare - UTF-16 In Place
+int fnstricmp(const QChar* a, const int& aLength, const QChar* b, const int& bLength);
+// Case Sensitive Compare - UTF-16 In Place
+int fnstrcmp(const QChar* a, const int& aLength, const QChar* b, const int& bLength);
 
 
 
@@ -168,8 +98,6 @@ int attrSortCompare(const QFileInfo& a, const QFileInfo& b, const bool& r, const
 
 // Get Dir List
 QFileInfoList getDirFileInfoList(const QString& aDirPath, const bool& aShowHidden = true);
-// Sort File List
-void sortFileList(QFileInfoList& aFileInfoList, const FileSortType& aSortType, const bool& aReverse, const bool& aDirFirst, const bool& aCase, const bool& aAbort);
 
 // Dir Size Scan Propgress Callback Type
 typedef void (*dirSizeScanProgressCallback)(const QString&, const quint64&, const quint64&, const quint64&, void*);
@@ -182,13 +110,34 @@ quint64 scanDirectorySize(const QString& aDirPath,
                           dirSizeScanProgressCallback aCallback = NULL,
                           void* aContext = NULL);
 
-// Dir File Search Item Found Callback Type
-typedef void (*fileSearchItemFoundCallback)(const QString&, const QString&, void*);
+// Dir Tree Item Found Callback Type
+typedef void (*dirTreeItemFoundCallback)(const QString&, const int&, const bool&, void*);
+
+// Scan Dir Tree - Breadth First, Dirs Only
+void scanDirectoryTree(const QString& aDirPath,
+                       const int& aMaxDepth,
+                       const bool& aShowHidden,
+                       const bool& aAbort,
+                       dirTreeItemFoundCallback aCallback = NULL,
+                       void* aContext = NULL);
+
+// Is Mime Type Supported By File Content Search
+bool isMimeSupportedByContentSearch(const QString& aMimeType);
+
+// Get Search File Name Patterns - Patterns Without A Star Match Anywhere In The Name
+QStringList getSearchFileNamePatterns(const QString& aFilePattern);
+
+// Create Search Content Matcher - Single Term Substring Or Regular Expression, Several Terms Matched Together
+ContentMatcher* createSearchContentMatcher(const QStringList& aContentTerms, const int& aOptions);
+
+// Dir File Search Item Found Callback Type - Content Hit Is NULL For Name Only Searches
+typedef void (*fileSearchItemFoundCallback)(const QString&, const QString&, const ContentHit*, void*);
 
 // Search Directory
 void searchDirectory(const QString& aDirPath,
                      const QString& aFilePattern,
-                     const QString& aContentPattern,
+                     const QStringList& aContentTerms,
+                     const QString& aExcludePatterns,
                      const int& aOptions,
                      const bool& aAbort,
                      fileSearchItemFoundCallback aCallback = NULL,